@@ -0,0 +1,101 @@
+#!/usr/bin/python
+
+# This example floods XBMC with button and axis events from several
+# simulated clients at once. It can be used to check how the event
+# server copes with high-rate input, e.g. from IR gateways or gamepads.
+
+# Each simulated client uses its own unique token, so XBMC tracks them
+# as separate clients (see services.esmaxclients).
+
+# The protocol is one-way, so the latency under load is measured by XBMC
+# itself: with debug logging on, the event server logs the p50, p99 and
+# max time from each packet's arrival until its event is queued, once a
+# second. This script reports the send rate and the spread of its own
+# send times, so a late sender can be told apart from a slow server.
+
+# NOTE: Read the comments in 'example_button1.py' for a more detailed
+# explanation of the packets used here.
+
+import sys
+sys.path.append("../../lib/python")
+
+from xbmcclient import *
+from socket import *
+
+def usage():
+    print "example_loadtest.py [host] [clients] [packets per second] [seconds]"
+
+def main():
+    import time
+
+    host = "localhost"
+    clients = 4
+    rate = 1000
+    duration = 10
+
+    try:
+        if len(sys.argv) > 1:
+            host = sys.argv[1]
+        if len(sys.argv) > 2:
+            clients = int(sys.argv[2])
+        if len(sys.argv) > 3:
+            rate = int(sys.argv[3])
+        if len(sys.argv) > 4:
+            duration = int(sys.argv[4])
+    except ValueError:
+        usage()
+        return
+
+    port = 9777
+    addr = (host, port)
+    sock = socket(AF_INET,SOCK_DGRAM)
+
+    # every client says HELO first, using its own token
+    for client in range(clients):
+        packet = PacketHELO(devicename="Load Test %d" % client)
+        packet.send(sock, addr, client + 1)
+
+    # alternate between axis movements and (non queued) button presses,
+    # which is the typical mix for gamepads and remotes
+    axis = PacketBUTTON(map_name="XG", button_name="leftthumbstickup",
+                        amount=32768, axis=1, repeat=0)
+    button = PacketBUTTON(map_name="R1", button_name="up", repeat=0)
+
+    interval = 1.0 / rate
+    sent = 0
+    late = 0
+    lateness = []
+    start = time.time()
+    next_send = start
+    while time.time() - start < duration:
+        uid = (sent % clients) + 1
+        lateness.append(time.time() - next_send)
+        if sent % 2:
+            axis.send(sock, addr, uid)
+        else:
+            button.send(sock, addr, uid)
+        sent += 1
+
+        next_send += interval
+        delay = next_send - time.time()
+        if delay > 0:
+            time.sleep(delay)
+        else:
+            late += 1
+
+    elapsed = time.time() - start
+    print "Sent %d packets from %d clients in %.2f s (%.0f packets/s, %d sent late)" % \
+          (sent, clients, elapsed, sent / elapsed, late)
+    if lateness:
+        lateness.sort()
+        print "Send time behind schedule: p50 %.2f ms, p99 %.2f ms" % \
+              (max(lateness[len(lateness) / 2], 0) * 1000,
+               max(lateness[min(len(lateness) - 1, len(lateness) * 99 / 100)], 0) * 1000)
+    print "See the XBMC debug log for the event server's p50/p99 packet latency"
+
+    for client in range(clients):
+        packet = PacketBYE()
+        packet.send(sock, addr, client + 1)
+
+if __name__=="__main__":
+    main()
@@ -0,0 +1,85 @@
+# -*- coding: utf-8 -*-
+
+#       Copyright (C) 2015 Team XBMC
+#       http://xbmc.org
+#
+#   This Program is free software; you can redistribute it and/or modify
+#   it under the terms of the GNU General Public License as published by
+#   the Free Software Foundation; either version 2, or (at your option)
+#   any later version.
+#
+#   This Program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+#   GNU General Public License for more details.
+#
+#   You should have received a copy of the GNU General Public License
+#   along with XBMC; see the file COPYING.  If not, see
+#   <http://www.gnu.org/licenses/>.
+#
+
+import sys
+import time
+import urlparse
+
+import xbmc
+import xbmcgui
+import xbmcplugin
+
+ADDON_ID = 'plugin.program.listingbenchmark'
+METHODS = ('item', 'items', 'columns')
+SIZES = (100, 1000, 10000)
+
+
+def columns(count):
+    urls = ['plugin://%s/?play=%d' % (ADDON_ID, i) for i in xrange(count)]
+    labels = ['Synthetic item %d' % i for i in xrange(count)]
+    art = [{'thumb': 'special://home/thumbs/%d.jpg' % i,
+            'fanart': 'special://home/fanart/%d.jpg' % i} for i in xrange(count)]
+    info = [{'title': labels[i], 'year': str(1950 + i % 60),
+             'genre': 'Benchmark', 'plot': 'Synthetic plot of item %d' % i} for i in xrange(count)]
+    properties = [{'Synthetic': 'true', 'TotalTime': str(60 + i % 7200)} for i in xrange(count)]
+    return urls, labels, art, info, properties
+
+
+def list_items(handle, method, count):
+    start = time.time()
+    urls, labels, art, info, properties = columns(count)
+    if method == 'columns':
+        xbmcplugin.addDirectoryItemColumns(handle, urls, labels, art=art, infoType='video',
+                                           infoLabels=info, properties=properties, totalItems=count)
+    else:
+        items = []
+        for i in xrange(count):
+            listitem = xbmcgui.ListItem(labels[i])
+            listitem.setArt(art[i])
+            listitem.setInfo('video', info[i])
+            for key, value in properties[i].iteritems():
+                listitem.setProperty(key, value)
+            if method == 'item':
+                xbmcplugin.addDirectoryItem(handle, urls[i], listitem, False, count)
+            else:
+                items.append((urls[i], listitem, False))
+        if items:
+            xbmcplugin.addDirectoryItems(handle, items, count)
+    elapsed = (time.time() - start) * 1000
+    xbmcplugin.endOfDirectory(handle)
+    xbmc.log('%s: %s, %d items: %d ms' % (ADDON_ID, method, count, elapsed), xbmc.LOGNOTICE)
+
+
+def list_root(handle):
+    for method in METHODS:
+        for count in SIZES:
+            url = 'plugin://%s/?method=%s&count=%d' % (ADDON_ID, method, count)
+            listitem = xbmcgui.ListItem('%s: %d items' % (method, count))
+            xbmcplugin.addDirectoryItem(handle, url, listitem, True)
+    xbmcplugin.endOfDirectory(handle)
+
+
+if __name__ == '__main__':
+    handle = int(sys.argv[1])
+    params = dict(urlparse.parse_qsl(sys.argv[2].lstrip('?')))
+    if params.get('method') in METHODS:
+        list_items(handle, params['method'], int(params.get('count', 1000)))
+    else:
+        list_root(handle)
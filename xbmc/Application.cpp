@@ -204,6 +204,7 @@
 #else
 #define MEASURE_FUNCTION
 #endif
+#include "utils/Trace.h"
 
 #ifdef TARGET_WINDOWS
 #include <shlobj.h>
@@ -1718,11 +1719,11 @@ bool CApplication::LoadSkin(const SkinPtr& skin)
 
   g_localizeStrings.LoadSkinStrings(langPath, CSettings::Get().GetString("locale.language"));
 
-  g_SkinInfo->LoadIncludes();
-
   int64_t start;
   start = CurrentHostCounter();
 
+  g_SkinInfo->LoadIncludes();
+
   CLog::Log(LOGINFO, "  load new skin...");
 
   // Load the user windows
@@ -1905,6 +1906,7 @@ bool CApplication::LoadUserWindows()
 bool CApplication::RenderNoPresent()
 {
   MEASURE_FUNCTION;
+  TRACE_FUNCTION;
 
 // DXMERGE: This may have been important?
 //  g_graphicsContext.AcquireCurrentContext();
@@ -1949,6 +1951,7 @@ void CApplication::Render()
     return;
 
   MEASURE_FUNCTION;
+  TRACE_FUNCTION;
 
   int vsync_mode = CSettings::Get().GetInt("videoscreen.vsync");
 
@@ -2639,6 +2642,7 @@ bool CApplication::OnAction(const CAction &action)
 void CApplication::FrameMove(bool processEvents, bool processGUI)
 {
   MEASURE_FUNCTION;
+  TRACE_FUNCTION;
 
   if (processEvents)
   {
@@ -4388,6 +4392,7 @@ void CApplication::ShowAppMigrationMessage()
 void CApplication::Process()
 {
   MEASURE_FUNCTION;
+  TRACE_FUNCTION;
 
   // dispatch the messages generated by python or other threads to the current window
   g_windowManager.DispatchThreadMessages();
@@ -65,6 +65,7 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <iterator>
 
 using namespace std;
 using namespace XFILE;
@@ -1814,6 +1815,30 @@ void CFileItemList::Append(const CFileItemList& itemlist)
     Add(itemlist[i]);
 }
 
+void CFileItemList::Append(CFileItemList&& itemlist)
+{
+  CSingleLock lock(m_lock);
+  CSingleLock lock2(itemlist.m_lock);
+
+  size_t start = m_items.size();
+  if (m_items.empty())
+    m_items.swap(itemlist.m_items);
+  else
+  {
+    m_items.reserve(m_items.size() + itemlist.m_items.size());
+    m_items.insert(m_items.end(), std::make_move_iterator(itemlist.m_items.begin()),
+                                  std::make_move_iterator(itemlist.m_items.end()));
+  }
+  itemlist.m_items.clear();
+  itemlist.m_map.clear();
+
+  if (m_fastLookup)
+  {
+    for (VECFILEITEMS::const_iterator it = m_items.begin() + start; it != m_items.end(); ++it)
+      m_map.insert(MAPFILEITEMSPAIR((*it)->GetPath(), *it));
+  }
+}
+
 void CFileItemList::Assign(const CFileItemList& itemlist, bool append)
 {
   CSingleLock lock(m_lock);
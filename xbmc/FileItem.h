@@ -573,6 +573,9 @@ public:
   int Size() const;
   bool IsEmpty() const;
   void Append(const CFileItemList& itemlist);
+  /*! \brief Move the items of another list to the end of this one, leaving it empty.
+   */
+  void Append(CFileItemList&& itemlist);
   void Assign(const CFileItemList& itemlist, bool append = false);
   bool Copy  (const CFileItemList& item, bool copyItems = true);
   void Reserve(int iCount);
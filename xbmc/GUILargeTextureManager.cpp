@@ -20,6 +20,7 @@
 
 #include "threads/SystemClock.h"
 #include "GUILargeTextureManager.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "guilib/Texture.h"
 #include "threads/SingleLock.h"
@@ -27,18 +28,27 @@
 #include "utils/JobManager.h"
 #include "guilib/GraphicContext.h"
 #include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
 #include "TextureCache.h"
+#include "TextureDatabase.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
 
 
-CImageLoader::CImageLoader(const std::string &path, const bool useCache):
+// the smallest resolution loaded, below this the savings aren't worth another copy on disk
+#define MIN_STREAM_SIZE 128
+
+CImageLoader::CImageLoader(const std::string &path, const bool useCache, unsigned int streamSize):
   m_path(path)
 {
   m_texture = NULL;
   m_use_cache = useCache;
+  m_streamSize = streamSize;
+  m_requested = XbmcThreads::SystemClockMillis();
 }
 
 CImageLoader::~CImageLoader()
@@ -53,10 +63,27 @@ bool CImageLoader::DoWork()
 
   std::string texturePath = g_TextureManager.GetTexturePath(m_path);
   if (m_use_cache)
-    loadPath = CTextureCache::Get().CheckCachedImage(texturePath, true, needsChecking);
+    loadPath = CTextureCache::Get().CheckCachedImage(texturePath, m_streamSize == 0, needsChecking);
   else
     loadPath = texturePath;
 
+  if (m_use_cache && m_streamSize && loadPath != texturePath)
+  {
+    // lower resolutions are scaled down from the cached image if there is one, and cached under
+    // its path so they're recached along with it. Otherwise they're decoded from the image at the
+    // lower resolution and cached at that, without caching the full size image first.
+    std::string scalePath = texturePath;
+    if (!loadPath.empty())
+    {
+      if (needsChecking)
+        CTextureCache::Get().BackgroundCacheImage(texturePath);
+      scalePath = loadPath;
+    }
+
+    texturePath = CTextureUtils::GetWrappedImageURL(scalePath, "", StringUtils::Format("width=%u&height=%u", m_streamSize * 16 / 9, m_streamSize));
+    loadPath = CTextureCache::Get().CheckCachedImage(texturePath, true, needsChecking);
+  }
+
   if (m_use_cache && loadPath.empty())
   {
     // not in our texture cache, so try and load directly and then cache the result
@@ -68,7 +95,20 @@ bool CImageLoader::DoWork()
   {
     // direct route - load the image
     unsigned int start = XbmcThreads::SystemClockMillis();
-    m_texture = CBaseTexture::LoadFromFile(loadPath, g_graphicsContext.GetWidth(), g_graphicsContext.GetHeight(), CSettings::Get().GetBool("pictures.useexifrotation"));
+    unsigned int width = g_graphicsContext.GetWidth(), height = g_graphicsContext.GetHeight();
+    if (m_streamSize)
+    {
+      width = m_streamSize * 16 / 9;
+      height = m_streamSize;
+    }
+    m_texture = CBaseTexture::LoadFromFile(loadPath, width, height, CSettings::Get().GetBool("pictures.useexifrotation"));
+    if (!m_texture && m_use_cache && URIUtils::HasExtension(loadPath, ".dds"))
+    { // the .dds copy is missing or broken, so forget about it and load the cached image
+      CTextureCache::Get().ClearCachedImageCompressed(texturePath);
+      loadPath = CTextureCache::Get().CheckCachedImage(texturePath, false, needsChecking);
+      if (!loadPath.empty())
+        m_texture = CBaseTexture::LoadFromFile(loadPath, width, height, CSettings::Get().GetBool("pictures.useexifrotation"));
+    }
     if (!m_texture)
       return false;
     if (XbmcThreads::SystemClockMillis() - start > 100)
@@ -80,10 +120,12 @@ bool CImageLoader::DoWork()
   return true;
 }
 
-CGUILargeTextureManager::CLargeTexture::CLargeTexture(const std::string &path):
+CGUILargeTextureManager::CLargeTexture::CLargeTexture(const std::string &path, unsigned int streamSize):
   m_path(path)
 {
   m_refCount = 1;
+  m_streamSize = streamSize;
+  m_bytes = 0;
   m_timeToDelete = 0;
 }
 
@@ -127,11 +169,16 @@ void CGUILargeTextureManager::CLargeTexture::SetTexture(CBaseTexture* texture)
 {
   assert(!m_texture.size());
   if (texture)
+  {
     m_texture.Set(texture, texture->GetWidth(), texture->GetHeight());
+    m_bytes = texture->GetPitch() * texture->GetRows();
+  }
 }
 
 CGUILargeTextureManager::CGUILargeTextureManager()
 {
+  m_allocatedBytes = 0;
+  m_loadTime = 0;
 }
 
 CGUILargeTextureManager::~CGUILargeTextureManager()
@@ -146,46 +193,138 @@ void CGUILargeTextureManager::CleanupUnusedImages(bool immediately)
   while (it != m_allocated.end())
   {
     CLargeTexture *image = *it;
+    unsigned int bytes = image->GetBytes();
     if (image->DeleteIfRequired(immediately))
+    {
+      m_allocatedBytes -= bytes;
       it = m_allocated.erase(it);
+    }
     else
       ++it;
   }
+
+  // over budget, so unused images go before their time is up, least recently used first
+  uint64_t budget = (uint64_t)g_advancedSettings.m_guiLargeTextureBudget * 1024 * 1024;
+  while (budget && m_allocatedBytes > budget)
+  {
+    listIterator oldest = m_allocated.end();
+    for (it = m_allocated.begin(); it != m_allocated.end(); ++it)
+    {
+      if ((*it)->IsUnused() && (oldest == m_allocated.end() || (*it)->GetTimeToDelete() < (*oldest)->GetTimeToDelete()))
+        oldest = it;
+    }
+    if (oldest == m_allocated.end())
+      break; // the rest are all in use
+
+    m_allocatedBytes -= (*oldest)->GetBytes();
+    (*oldest)->DeleteIfRequired(true);
+    m_allocated.erase(oldest);
+  }
+}
+
+bool CGUILargeTextureManager::CanUpgrade() const
+{
+  CSingleLock lock(m_listSection);
+  return !g_advancedSettings.m_guiLargeTextureBudget ||
+         m_allocatedBytes < (uint64_t)g_advancedSettings.m_guiLargeTextureBudget * 1024 * 1024;
+}
+
+unsigned int CGUILargeTextureManager::GetStreamSize(float width, float height)
+{
+  if (width <= 0 || height <= 0)
+    return 0; // sized by the image, so it has to be the real thing
+
+  // the images are scaled to fit, so the larger side decides
+  float size = std::max(width, height);
+  unsigned int streamSize = MIN_STREAM_SIZE;
+  while (streamSize < size)
+    streamSize *= 2;
+
+  if (streamSize >= g_advancedSettings.m_imageRes)
+    return 0;
+  return streamSize;
+}
+
+CGUILargeTextureManager::Stats CGUILargeTextureManager::GetStats() const
+{
+  CSingleLock lock(m_listSection);
+  Stats stats;
+  stats.textures = m_allocated.size();
+  stats.bytes = m_allocatedBytes;
+  stats.queued = m_queued.size();
+  stats.loadTime = m_loadTime;
+  return stats;
 }
 
 // if available, increment reference count, and return the image.
 // else, add to the queue list if appropriate.
-bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, const bool useCache)
+bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, const bool useCache,
+                                       unsigned int streamSize, unsigned int *loadedSize)
 {
   CSingleLock lock(m_listSection);
+  // a first request makes do with the smallest resolution we have that's large enough, else with
+  // the largest one we have below it while the wanted one is loaded
+  CLargeTexture *match = NULL, *smaller = NULL;
   for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
   {
     CLargeTexture *image = *it;
-    if (image->GetPath() == path)
+    if (image->GetPath() != path)
+      continue;
+    if (image->GetStreamSize() == streamSize)
+    {
+      match = image;
+      break;
+    }
+    if (!firstRequest)
+      continue;
+    if (!IsLarger(streamSize, image->GetStreamSize()))
+    {
+      if (!match || IsLarger(match->GetStreamSize(), image->GetStreamSize()))
+        match = image;
+    }
+    else if (image->GetTexture().size() &&
+             (!smaller || IsLarger(image->GetStreamSize(), smaller->GetStreamSize())))
+      smaller = image;
+  }
+  if (!match)
+    match = smaller;
+
+  if (match)
+  {
+    if (firstRequest)
     {
-      if (firstRequest)
-        image->AddRef();
-      texture = image->GetTexture();
-      return texture.size() > 0;
+      match->AddRef();
+      if (match == smaller)
+        QueueImage(path, useCache, streamSize);
     }
+    if (loadedSize)
+      *loadedSize = match->GetStreamSize();
+    texture = match->GetTexture();
+    return texture.size() > 0;
   }
 
+  if (loadedSize)
+    *loadedSize = streamSize;
   if (firstRequest)
-    QueueImage(path, useCache);
+    QueueImage(path, useCache, streamSize);
 
   return true;
 }
 
-void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immediately)
+void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immediately, unsigned int streamSize)
 {
   CSingleLock lock(m_listSection);
   for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
   {
     CLargeTexture *image = *it;
-    if (image->GetPath() == path)
+    if (image->GetPath() == path && image->GetStreamSize() == streamSize)
     {
+      unsigned int bytes = image->GetBytes();
       if (image->DecrRef(immediately) && immediately)
+      {
+        m_allocatedBytes -= bytes;
         m_allocated.erase(it);
+      }
       return;
     }
   }
@@ -193,7 +332,7 @@ void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immedia
   {
     unsigned int id = it->first;
     CLargeTexture *image = it->second;
-    if (image->GetPath() == path && image->DecrRef(true))
+    if (image->GetPath() == path && image->GetStreamSize() == streamSize && image->DecrRef(true))
     {
       // cancel this job
       CJobManager::GetInstance().CancelJob(id);
@@ -204,13 +343,13 @@ void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immedia
 }
 
 // queue the image, and start the background loader if necessary
-void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
+void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache, unsigned int streamSize)
 {
   CSingleLock lock(m_listSection);
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
     CLargeTexture *image = it->second;
-    if (image->GetPath() == path)
+    if (image->GetPath() == path && image->GetStreamSize() == streamSize)
     {
       image->AddRef();
       return; // already queued
@@ -218,8 +357,8 @@ void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
   }
 
   // queue the item
-  CLargeTexture *image = new CLargeTexture(path);
-  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache), this, CJob::PRIORITY_NORMAL);
+  CLargeTexture *image = new CLargeTexture(path, streamSize);
+  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache, streamSize), this, CJob::PRIORITY_NORMAL);
   m_queued.push_back(make_pair(jobID, image));
 }
 
@@ -237,6 +376,8 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
       m_queued.erase(it);
       m_allocated.push_back(image);
+      m_allocatedBytes += image->GetBytes();
+      m_loadTime = (m_loadTime * 7 + (XbmcThreads::SystemClockMillis() - loader->m_requested)) / 8;
       return;
     }
   }
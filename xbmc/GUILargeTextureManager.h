@@ -35,7 +35,7 @@
 class CImageLoader : public CJob
 {
 public:
-  CImageLoader(const std::string &path, const bool useCache);
+  CImageLoader(const std::string &path, const bool useCache, unsigned int streamSize = 0);
   virtual ~CImageLoader();
 
   /*!
@@ -45,6 +45,8 @@ public:
 
   bool          m_use_cache; ///< Whether or not to use any caching with this image
   std::string    m_path; ///< path of image to load
+  unsigned int  m_streamSize; ///< resolution to load the image at, 0 for full size \sa CGUILargeTextureManager::GetStreamSize
+  unsigned int  m_requested; ///< when the image was queued, for the load time statistics
   CBaseTexture *m_texture; ///< Texture object to load the image into \sa CBaseTexture.
 };
 
@@ -55,6 +57,15 @@ public:
  Used to load textures for the user interface asynchronously, allowing fluid framerates
  while background loading textures.
 
+ Images are loaded at a resolution matched to the size they're drawn at, rather than at the
+ size they're cached at. The lower resolutions are cached on disk by CTextureCache alongside
+ the full size image, and a texture that grows on screen streams in a larger one, keeping
+ the smaller one until it has arrived.
+
+ Unused textures are kept for a short while in case they're wanted again. Once the textures
+ exceed the <gui><largetexturebudget> advanced setting, unused ones are let go of early,
+ least recently used first, and no larger resolutions are streamed in.
+
  \sa IJobCallback, CGUITexture
  */
 class CGUILargeTextureManager : public IJobCallback
@@ -83,10 +94,18 @@ public:
    \param texture texture object to hold the resulting texture
    \param orientation orientation of resulting texture
    \param firstRequest true if this is the first time we are requesting this texture
+   \param streamSize the resolution wanted, as returned by GetStreamSize(). A first request is
+                     given the smallest loaded resolution at least this large. Failing that it is
+                     given the largest loaded one below it, and the wanted one is queued as well,
+                     so the caller holds both and asks for the wanted one again to pick it up.
+                     Later requests must ask for the resolution they were given.
+   \param loadedSize [out] the resolution of the texture the request refers to. If this is below
+                     streamSize the caller also holds streamSize, which is being loaded.
    \return true if the image exists, else false.
    \sa CGUITextureArray and CGUITexture
    */
-  bool GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, bool useCache = true);
+  bool GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, bool useCache = true,
+                unsigned int streamSize = 0, unsigned int *loadedSize = NULL);
 
   /*!
    \brief Request a texture to be unloaded.
@@ -98,8 +117,9 @@ public:
    \param path path of the image to release.
    \param immediately if set true the image is immediately unloaded once its reference count reaches zero
                       rather than being unloaded after a delay.
+   \param streamSize the resolution the image was given at.
    */
-  void ReleaseImage(const std::string &path, bool immediately = false);
+  void ReleaseImage(const std::string &path, bool immediately = false, unsigned int streamSize = 0);
 
   /*!
    \brief Cleanup images that are no longer in use.
@@ -112,11 +132,42 @@ public:
    */
   void CleanupUnusedImages(bool immediately = false);
 
+  /*!
+   \brief Whether there's room in the budget for streaming in larger resolutions.
+   */
+  bool CanUpgrade() const;
+
+  /*!
+   \brief The resolution to load an image drawn at the given size in screen pixels.
+
+   Resolutions are powers of two, and are the height of the 16x9 box the image is scaled to fit,
+   just as <imageres> is for the cached image.
+
+   \return the resolution, or 0 for the image as cached.
+   */
+  static unsigned int GetStreamSize(float width, float height);
+
+  /*!
+   \brief Whether a resolution returned by GetStreamSize() is larger than another.
+   */
+  static bool IsLarger(unsigned int size, unsigned int than) { return than && (!size || size > than); };
+
+  /*! \brief Textures held and being loaded, for the debug overlay.
+   */
+  struct Stats
+  {
+    unsigned int textures;  ///< textures loaded
+    uint64_t     bytes;     ///< memory used by the loaded textures
+    unsigned int queued;    ///< textures being loaded
+    unsigned int loadTime;  ///< average time from request to texture, in ms
+  };
+  Stats GetStats() const;
+
 private:
   class CLargeTexture
   {
   public:
-    CLargeTexture(const std::string &path);
+    CLargeTexture(const std::string &path, unsigned int streamSize);
     virtual ~CLargeTexture();
 
     void AddRef();
@@ -125,25 +176,34 @@ private:
     void SetTexture(CBaseTexture* texture);
 
     const std::string &GetPath() const { return m_path; };
+    unsigned int GetStreamSize() const { return m_streamSize; };
     const CTextureArray &GetTexture() const { return m_texture; };
+    unsigned int GetBytes() const { return m_bytes; };
+    bool IsUnused() const { return m_refCount == 0; };
+    unsigned int GetTimeToDelete() const { return m_timeToDelete; };
 
   private:
     static const unsigned int TIME_TO_DELETE = 2000;
 
     unsigned int m_refCount;
     std::string m_path;
+    unsigned int m_streamSize;
     CTextureArray m_texture;
+    unsigned int m_bytes;
     unsigned int m_timeToDelete;
   };
 
-  void QueueImage(const std::string &path, bool useCache = true);
+  void QueueImage(const std::string &path, bool useCache, unsigned int streamSize);
 
   std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
   std::vector<CLargeTexture *> m_allocated;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
   typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
 
-  CCriticalSection m_listSection;
+  uint64_t m_allocatedBytes;
+  unsigned int m_loadTime;
+
+  mutable CCriticalSection m_listSection;
 };
 
 extern CGUILargeTextureManager g_largeTextureManager;
@@ -30,6 +30,7 @@
 #include "utils/StringUtils.h"
 #include "URL.h"
 #include "utils/StringUtils.h"
+#include "windowing/WindowingFactory.h"
 
 using namespace XFILE;
 
@@ -110,12 +111,19 @@ std::string CTextureCache::CheckCachedImage(const std::string &url, bool returnD
   if (!path.empty())
   {
     if (!needsRecaching && returnDDS && !URIUtils::IsInPath(url, "special://skin/")) // TODO: should skin images be .dds'd (currently they're not necessarily writeable)
-    { // check for dds version
-      std::string ddsPath = URIUtils::ReplaceExtension(path, ".dds");
-      if (CFile::Exists(ddsPath))
-        return ddsPath;
-      if (g_advancedSettings.m_useDDSFanart)
-        AddJob(new CTextureDDSJob(path));
+    {
+      if (details.id < 0)
+      { // not in the database, so check for dds version on disk
+        std::string ddsPath = URIUtils::ReplaceExtension(path, ".dds");
+        if (CFile::Exists(ddsPath))
+          return ddsPath;
+        if (g_advancedSettings.m_useDDSFanart)
+          AddJob(new CTextureDDSJob(path));
+      }
+      else if (details.compressed > 0)
+        return URIUtils::ReplaceExtension(path, ".dds");
+      else if (details.compressed == 0 && ShouldCompress(details))
+        AddJob(new CTextureDDSJob(path, details.id));
     }
     return path;
   }
@@ -212,6 +220,16 @@ bool CTextureCache::GetCachedTexture(const std::string &url, CTextureDetails &de
   return m_database.GetCachedTexture(url, details);
 }
 
+void CTextureCache::ClearCachedImageCompressed(const std::string &image)
+{
+  CTextureDetails details;
+  if (GetCachedTexture(CTextureUtils::UnwrapImageURL(image), details) && details.compressed > 0)
+  {
+    CSingleLock lock(m_databaseSection);
+    m_database.SetCachedTextureCompressed(details.id, 0);
+  }
+}
+
 bool CTextureCache::AddCachedTexture(const std::string &url, const CTextureDetails &details)
 {
   CSingleLock lock(m_databaseSection);
@@ -284,13 +302,41 @@ void CTextureCache::OnCachingComplete(bool success, CTextureCacheJob *job)
 
   // TODO: call back to the UI indicating that it can update it's image...
   if (success && g_advancedSettings.m_useDDSFanart && !job->m_details.file.empty())
-    AddJob(new CTextureDDSJob(GetCachedPath(job->m_details.file)));
+  {
+    CTextureDetails details;
+    if (GetCachedTexture(job->m_url, details))
+      AddJob(new CTextureDDSJob(GetCachedPath(details.file), details.id));
+  }
+}
+
+void CTextureCache::OnCompressionComplete(bool success, CTextureDDSJob *job)
+{
+  if (job->m_id < 0)
+    return;
+
+  // the texture may have been recached while it was compressed, in which case the
+  // .dds is of the old image. Recaching writes the file before it resets the texture's
+  // row, so checking the file under the database lock is enough.
+  CSingleLock lock(m_databaseSection);
+  if (job->IsOutdated())
+    return;
+  m_database.SetCachedTextureCompressed(job->m_id, success && job->m_compressed ? 1 : -1);
+}
+
+bool CTextureCache::ShouldCompress(const CTextureDetails &details)
+{
+  if (g_advancedSettings.m_useDDSFanart)
+    return true;
+  return g_advancedSettings.m_ddsUseCount && details.useCount >= g_advancedSettings.m_ddsUseCount &&
+         g_Windowing.SupportsDXT();
 }
 
 void CTextureCache::OnJobComplete(unsigned int jobID, bool success, CJob *job)
 {
   if (strcmp(job->GetType(), kJobTypeCacheImage) == 0)
     OnCachingComplete(success, (CTextureCacheJob *)job);
+  else if (strcmp(job->GetType(), kJobTypeDDSCompress) == 0)
+    OnCompressionComplete(success, (CTextureDDSJob *)job);
   return CJobQueue::OnJobComplete(jobID, success, job);
 }
 
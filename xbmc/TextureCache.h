@@ -61,7 +61,8 @@ public:
 
    Check and return URL to cached image if it exists; If not, return empty string.
    If the image is cached, return URL (for original image or .dds version if requested)
-   Creates a .dds of image if requested via returnDDS and the image doesn't need recaching.
+   Creates a .dds of image if requested via returnDDS, the image doesn't need recaching
+   and it's been used often enough, see ShouldCompress().
 
    \param image url of the image to check
    \param returnDDS if we're allowed to return a DDS version, defaults to true
@@ -122,6 +123,13 @@ public:
    */
   bool ClearCachedImage(int textureID);
 
+  /*! \brief forget the .dds copy of the given image, e.g. because it failed to load
+   The cached image is used instead, and a new copy is made if it's still used often enough.
+   \param image url of the image
+   \sa CheckCachedImage
+   */
+  void ClearCachedImageCompressed(const std::string &image);
+
   /*! \brief retrieve a cache file (relative to the cache path) to associate with the given image, excluding extension
    Use GetCachedPath(GetCacheFile(url)+extension) for the full path to the file.
    \param url location of the image
@@ -210,6 +218,13 @@ private:
    */
   bool SetCachedTextureValid(const std::string &url, bool updateable);
 
+  /*! \brief Whether a cached texture should get a .dds copy
+   Either all textures are compressed (<useddsfanart>), or those used at least
+   <ddsusecount> times, provided the GPU can take the compressed formats.
+   \param details the texture's details from the database.
+   */
+  static bool ShouldCompress(const CTextureDetails &details);
+
   virtual void OnJobComplete(unsigned int jobID, bool success, CJob *job);
   virtual void OnJobProgress(unsigned int jobID, unsigned int progress, unsigned int total, const CJob *job);
 
@@ -221,6 +236,14 @@ private:
    */
   void OnCachingComplete(bool success, CTextureCacheJob *job);
 
+  /*! \brief Called when a DDS job has completed.
+   Records in the database whether the texture has a block compressed .dds copy,
+   unless the texture was recached in the meantime.
+   \param success whether the job was successful.
+   \param job the DDS job.
+   */
+  void OnCompressionComplete(bool success, CTextureDDSJob *job);
+
   CCriticalSection m_databaseSection;
   CTextureDatabase m_database;
   std::set<std::string> m_processinglist; ///< currently processing list to avoid 2 jobs being processed at once
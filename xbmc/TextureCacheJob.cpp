@@ -22,6 +22,7 @@
 #include "TextureCache.h"
 #include "guilib/Texture.h"
 #include "guilib/DDSImage.h"
+#include "guilib/XBTF.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "utils/log.h"
@@ -240,8 +241,10 @@ std::string CTextureCacheJob::GetImageHash(const std::string &url)
   return "";
 }
 
-CTextureDDSJob::CTextureDDSJob(const std::string &original):
-  m_original(original)
+CTextureDDSJob::CTextureDDSJob(const std::string &original, int id):
+  m_original(original),
+  m_id(id),
+  m_compressed(false)
 {
 }
 
@@ -260,18 +263,31 @@ bool CTextureDDSJob::DoWork()
 {
   if (URIUtils::HasExtension(m_original, ".dds"))
     return false;
+  m_hash = CTextureCacheJob::GetImageHash(m_original);
   CBaseTexture *texture = CBaseTexture::LoadFromFile(m_original);
   if (texture)
   { // convert to DDS
     CDDSImage dds;
     CLog::Log(LOGDEBUG, "Creating DDS version of: %s", m_original.c_str());
-    bool ret = dds.Create(URIUtils::ReplaceExtension(m_original, ".dds"), texture->GetWidth(), texture->GetHeight(), texture->GetPitch(), texture->GetPixels(), 40);
+    std::string ddsPath = URIUtils::ReplaceExtension(m_original, ".dds");
+    bool ret = dds.Create(ddsPath, texture->GetWidth(), texture->GetHeight(), texture->GetPitch(), texture->GetPixels(), 40);
     delete texture;
+    m_compressed = ret && (dds.GetFormat() & XB_FMT_DXT_MASK) != 0;
+    if (ret && !m_compressed && m_id >= 0)
+    { // images that don't compress well enough are stored as ARGB, which saves neither memory nor upload
+      XFILE::CFile::Delete(ddsPath);
+      return false;
+    }
     return ret;
   }
   return false;
 }
 
+bool CTextureDDSJob::IsOutdated() const
+{
+  return m_hash.empty() || m_hash != CTextureCacheJob::GetImageHash(m_original);
+}
+
 CTextureUseCountJob::CTextureUseCountJob(const std::vector<CTextureDetails> &textures) : m_textures(textures)
 {
 }
@@ -38,7 +38,9 @@ public:
   {
     id = -1;
     width = height = 0;
+    useCount = 0;
     updateable = false;
+    compressed = 0;
   };
   bool operator==(const CTextureDetails &right) const
   {
@@ -51,7 +53,9 @@ public:
   std::string  hash;
   unsigned int width;
   unsigned int height;
+  unsigned int useCount;
   bool         updateable;
+  int          compressed; ///< 1 if there's a block compressed .dds copy of the cached file, -1 if it doesn't compress well enough for one
 };
 
 /*!
@@ -84,6 +88,7 @@ public:
   CTextureDetails m_details;
 private:
   friend class CEdenVideoArtUpdater;
+  friend class CTextureDDSJob;
 
   /*! \brief retrieve a hash for the given image
    Combines the size, ctime and mtime of the image file into a "unique" hash
@@ -131,13 +136,23 @@ private:
 class CTextureDDSJob : public CJob
 {
 public:
-  CTextureDDSJob(const std::string &original);
+  /*! \param original the cached file to compress
+   \param id the id of the texture the file is cached for, if it's in the texture database
+   */
+  CTextureDDSJob(const std::string &original, int id = -1);
 
   virtual const char* GetType() const { return kJobTypeDDSCompress; };
   virtual bool operator==(const CJob *job) const;
   virtual bool DoWork();
 
+  /*! \brief Whether the cached file has changed since it was compressed, e.g. by being recached
+   */
+  bool IsOutdated() const;
+
   std::string m_original;
+  int         m_id;
+  std::string m_hash;       ///< hash of the cached file when it was compressed
+  bool        m_compressed; ///< whether the .dds copy is block compressed
 };
 
 /* \brief Job class for storing the use count of textures
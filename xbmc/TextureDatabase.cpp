@@ -170,7 +170,7 @@ void CTextureDatabase::CreateTables()
   m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text)");
 
   CLog::Log(LOGINFO, "create sizes table, index,  and trigger");
-  m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text)");
+  m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text, compressed integer not null default 0)");
 
   CLog::Log(LOGINFO, "create path table");
   m_pDS->exec("CREATE TABLE path (id integer primary key, url text, type text, texture text)\n");
@@ -242,6 +242,10 @@ void CTextureDatabase::UpdateTables(int version)
     m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text)");
     m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text)");
   }
+  if (version < 14)
+  { // track the .dds copies of cached textures rather than looking for them on disk
+    m_pDS->exec("ALTER TABLE sizes ADD compressed integer not null default 0");
+  }
 }
 
 bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details)
@@ -250,6 +254,12 @@ bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details)
   return ExecuteQuery(sql);
 }
 
+bool CTextureDatabase::SetCachedTextureCompressed(int textureID, int compressed)
+{
+  std::string sql = PrepareSQL("UPDATE sizes SET compressed=%i WHERE size=1 AND idtexture=%i", compressed, textureID);
+  return ExecuteQuery(sql);
+}
+
 bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails &details)
 {
   try
@@ -257,7 +267,7 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
     if (NULL == m_pDB.get()) return false;
     if (NULL == m_pDS.get()) return false;
 
-    std::string sql = PrepareSQL("SELECT id, cachedurl, lasthashcheck, imagehash, width, height FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1) WHERE url='%s'", url.c_str());
+    std::string sql = PrepareSQL("SELECT id, cachedurl, lasthashcheck, imagehash, width, height, usecount, compressed FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1) WHERE url='%s'", url.c_str());
     m_pDS->query(sql.c_str());
     if (!m_pDS->eof())
     { // have some information
@@ -269,6 +279,8 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
         details.hash = m_pDS->fv(3).get_asString();
       details.width = m_pDS->fv(4).get_asInt();
       details.height = m_pDS->fv(5).get_asInt();
+      details.useCount = m_pDS->fv(6).get_asInt();
+      details.compressed = m_pDS->fv(7).get_asInt();
       m_pDS->close();
       return true;
     }
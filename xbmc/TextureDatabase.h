@@ -79,6 +79,12 @@ public:
   bool ClearCachedTexture(int textureID, std::string &cacheFile);
   bool IncrementUseCount(const CTextureDetails &details);
 
+  /*! \brief Record whether a cached texture has a .dds copy
+   \param textureID id of the texture
+   \param compressed 1 if it has a block compressed .dds copy, -1 if it doesn't compress well enough, 0 if not known
+   */
+  bool SetCachedTextureCompressed(int textureID, int compressed);
+
   /*! \brief Invalidate a previously cached texture
    Invalidates the texture hash, and sets the texture update time to the current time so that
    next texture load it will be re-cached.
@@ -130,6 +136,6 @@ protected:
   virtual void CreateTables();
   virtual void CreateAnalytics();
   virtual void UpdateTables(int version);
-  virtual int GetSchemaVersion() const { return 13; };
+  virtual int GetSchemaVersion() const { return 14; };
   const char *GetBaseDBName() const { return "Textures"; };
 };
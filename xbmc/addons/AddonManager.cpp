@@ -24,6 +24,7 @@
 #include "utils/StringUtils.h"
 #include "utils/JobManager.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "FileItem.h"
 #include "LangInfo.h"
 #include "settings/AdvancedSettings.h"
@@ -59,6 +60,72 @@ cp_log_severity_t clog_to_cp(int lvl);
 void cp_fatalErrorHandler(const char *msg);
 void cp_logger(cp_log_severity_t level, const char *msg, const char *apid, void *user_data);
 
+/**********************************************************
+ * CAddonSnapshot
+ *
+ */
+
+CAddonSnapshot::CAddonSnapshot(DllLibCPluff *cpluff, cp_context_t *context, unsigned int version)
+  : m_cpluff(cpluff),
+    m_context(context),
+    m_plugins(NULL),
+    m_version(version)
+{
+  cp_status_t status;
+  int num = 0;
+  m_plugins = m_cpluff->get_plugins_info(m_context, &status, &num);
+  if (status != CP_OK || !m_plugins)
+    return;
+
+  for (int i = 0; i < num; ++i)
+  {
+    const cp_plugin_info_t *plugin = m_plugins[i];
+    const std::string id = plugin->identifier;
+    m_pluginsById[id] = plugin;
+
+    const bool disabled = CAddonMgr::Get().IsAddonDisabled(id);
+    if (disabled)
+      m_disabled.insert(id);
+
+    for (unsigned int j = 0; j < plugin->num_extensions; ++j)
+    {
+      const TYPE type = TranslateType(plugin->extensions[j].ext_point_id);
+      if (type == ADDON_UNKNOWN)
+        continue;
+      Extension extension = { &plugin->extensions[j], disabled };
+      m_extensions[type].push_back(extension);
+    }
+  }
+}
+
+CAddonSnapshot::~CAddonSnapshot()
+{
+  if (m_plugins)
+    m_cpluff->release_info(m_context, m_plugins);
+}
+
+const CAddonSnapshot::EXTENSIONS &CAddonSnapshot::GetExtensions(const TYPE &type) const
+{
+  static const EXTENSIONS empty;
+  std::map<TYPE, EXTENSIONS>::const_iterator it = m_extensions.find(type);
+  if (it == m_extensions.end())
+    return empty;
+  return it->second;
+}
+
+const cp_plugin_info_t *CAddonSnapshot::GetPlugin(const std::string &id) const
+{
+  std::map<std::string, const cp_plugin_info_t*>::const_iterator it = m_pluginsById.find(id);
+  if (it == m_pluginsById.end())
+    return NULL;
+  return it->second;
+}
+
+bool CAddonSnapshot::IsDisabled(const std::string &id) const
+{
+  return m_disabled.find(id) != m_disabled.end();
+}
+
 /**********************************************************
  * CAddonMgr
  *
@@ -210,6 +277,8 @@ bool CAddonMgr::CheckUserDirs(const cp_cfg_element_t *settings)
 CAddonMgr::CAddonMgr()
 {
   m_cpluff = NULL;
+  m_cp_context = NULL;
+  m_snapshotVersion = 0;
 }
 
 CAddonMgr::~CAddonMgr()
@@ -318,20 +387,50 @@ bool CAddonMgr::Init()
 
 void CAddonMgr::DeInit()
 {
+  // the snapshot holds c-pluff descriptors, so it has to go before the context
+  InvalidateSnapshot();
   if (m_cpluff)
     m_cpluff->destroy();
   delete m_cpluff;
   m_cpluff = NULL;
+  m_cp_context = NULL;
   m_database.Close();
   m_disabled.clear();
 }
 
+AddonSnapshotPtr CAddonMgr::GetSnapshot()
+{
+  CSingleLock lock(m_critSection);
+  if (!m_snapshot && m_cpluff && m_cp_context)
+  {
+    unsigned int start = XbmcThreads::SystemClockMillis();
+    m_snapshot.reset(new CAddonSnapshot(m_cpluff, m_cp_context, ++m_snapshotVersion));
+    CLog::Log(LOGDEBUG, "ADDONS: built addon snapshot %u in %u ms", m_snapshotVersion, XbmcThreads::SystemClockMillis() - start);
+  }
+  return m_snapshot;
+}
+
+void CAddonMgr::InvalidateSnapshot()
+{
+  CSingleLock lock(m_critSection);
+  m_snapshot.reset();
+}
+
 bool CAddonMgr::HasAddons(const TYPE &type, bool enabled /*= true*/)
 {
-  // TODO: This isn't particularly efficient as we create an addon type for each addon using the Factory, just so
-  //       we can check addon dependencies in the addon constructor.
-  VECADDONS addons;
-  return GetAddons(type, addons, enabled);
+  AddonSnapshotPtr snapshot = GetSnapshot();
+  if (!snapshot)
+    return false;
+
+  // we still need the Factory as it checks platform support and addon dependencies,
+  // but can stop at the first addon it accepts
+  const CAddonSnapshot::EXTENSIONS &exts = snapshot->GetExtensions(type);
+  for (CAddonSnapshot::EXTENSIONS::const_iterator it = exts.begin(); it != exts.end(); ++it)
+  {
+    if (it->disabled != enabled && Factory(it->ext))
+      return true;
+  }
+  return false;
 }
 
 bool CAddonMgr::GetAllAddons(VECADDONS &addons, bool enabled /*= true*/, bool allowRepos /* = false */)
@@ -434,20 +533,16 @@ bool CAddonMgr::HasOutdatedAddons()
 
 bool CAddonMgr::GetAddons(const TYPE &type, VECADDONS &addons, bool enabled /* = true */)
 {
-  CSingleLock lock(m_critSection);
   addons.clear();
-  if (!m_cp_context)
+  AddonSnapshotPtr snapshot = GetSnapshot();
+  if (!snapshot)
     return false;
-  cp_status_t status;
-  int num;
-  std::string ext_point(TranslateType(type));
-  cp_extension_t **exts = m_cpluff->get_extensions_info(m_cp_context, ext_point.c_str(), &status, &num);
-  for(int i=0; i <num; i++)
+  const CAddonSnapshot::EXTENSIONS &exts = snapshot->GetExtensions(type);
+  for (CAddonSnapshot::EXTENSIONS::const_iterator it = exts.begin(); it != exts.end(); ++it)
   {
-    const cp_extension_t *props = exts[i];
-    if (IsAddonDisabled(props->plugin->identifier) != enabled)
+    if (it->disabled != enabled)
     {
-      AddonPtr addon(Factory(props));
+      AddonPtr addon(Factory(it->ext));
       if (addon)
       {
         if (enabled)
@@ -461,24 +556,23 @@ bool CAddonMgr::GetAddons(const TYPE &type, VECADDONS &addons, bool enabled /* =
       }
     }
   }
-  m_cpluff->release_info(m_cp_context, exts);
   return addons.size() > 0;
 }
 
 bool CAddonMgr::GetAddon(const std::string &str, AddonPtr &addon, const TYPE &type/*=ADDON_UNKNOWN*/, bool enabledOnly /*= true*/)
 {
-  CSingleLock lock(m_critSection);
+  AddonSnapshotPtr snapshot = GetSnapshot();
+  if (!snapshot)
+    return false;
 
-  cp_status_t status;
-  cp_plugin_info_t *cpaddon = m_cpluff->get_plugin_info(m_cp_context, str.c_str(), &status);
-  if (status == CP_OK && cpaddon)
+  const cp_plugin_info_t *cpaddon = snapshot->GetPlugin(str);
+  if (cpaddon)
   {
     addon = GetAddonFromDescriptor(cpaddon, type==ADDON_UNKNOWN?"":TranslateType(type));
-    m_cpluff->release_info(m_cp_context, cpaddon);
 
     if (addon)
     {
-      if (enabledOnly && IsAddonDisabled(addon->ID()))
+      if (enabledOnly && snapshot->IsDisabled(addon->ID()))
         return false;
 
       // if the addon has a running instance, grab that
@@ -488,8 +582,6 @@ bool CAddonMgr::GetAddon(const std::string &str, AddonPtr &addon, const TYPE &ty
     }
     return NULL != addon.get();
   }
-  if (cpaddon)
-    m_cpluff->release_info(m_cp_context, cpaddon);
 
   return false;
 }
@@ -578,6 +670,7 @@ void CAddonMgr::FindAddons()
     if (m_cpluff && m_cp_context)
     {
       m_cpluff->scan_plugins(m_cp_context, CP_SP_UPGRADE);
+      InvalidateSnapshot();
       SetChanged();
     }
   }
@@ -589,6 +682,7 @@ void CAddonMgr::RemoveAddon(const std::string& ID)
   if (m_cpluff && m_cp_context)
   {
     m_cpluff->uninstall_plugin(m_cp_context,ID.c_str());
+    InvalidateSnapshot();
     SetChanged();
     NotifyObservers(ObservableMessageAddons);
   }
@@ -600,6 +694,7 @@ bool CAddonMgr::DisableAddon(const std::string& ID, bool disable)
   if (m_database.DisableAddon(ID, disable))
   {
     m_disabled[ID] = disable;
+    InvalidateSnapshot();
     return true;
   }
 
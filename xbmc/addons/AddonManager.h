@@ -24,7 +24,9 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 #include <deque>
+#include <memory>
 #include "AddonDatabase.h"
 
 class DllLibCPluff;
@@ -62,6 +64,45 @@ namespace ADDON
       virtual bool RequestRemoval(AddonPtr addon)=0;
   };
 
+  /**
+  * Class - CAddonSnapshot
+  * Immutable view of the addon descriptors known to c-pluff along with their
+  * enabled state. It is built once and replaced as a whole whenever addons are
+  * (un)installed, rescanned or enabled/disabled, so readers only need to hold
+  * a reference to it instead of querying c-pluff and the database on each call.
+  */
+  class CAddonSnapshot
+  {
+  public:
+    struct Extension
+    {
+      const cp_extension_t *ext;
+      bool disabled;
+    };
+    typedef std::vector<Extension> EXTENSIONS;
+
+    CAddonSnapshot(DllLibCPluff *cpluff, cp_context_t *context, unsigned int version);
+    ~CAddonSnapshot();
+
+    unsigned int GetVersion() const { return m_version; }
+    const EXTENSIONS &GetExtensions(const TYPE &type) const;
+    const cp_plugin_info_t *GetPlugin(const std::string &id) const;
+    bool IsDisabled(const std::string &id) const;
+
+  private:
+    CAddonSnapshot(const CAddonSnapshot&);
+    CAddonSnapshot const& operator=(CAddonSnapshot const&);
+
+    DllLibCPluff *m_cpluff;
+    cp_context_t *m_context;
+    cp_plugin_info_t **m_plugins;
+    unsigned int m_version;
+    std::map<TYPE, EXTENSIONS> m_extensions;
+    std::map<std::string, const cp_plugin_info_t*> m_pluginsById;
+    std::set<std::string> m_disabled;
+  };
+  typedef std::shared_ptr<const CAddonSnapshot> AddonSnapshotPtr;
+
   /**
   * Class - CAddonMgr
   * Holds references to all addons, enabled or
@@ -184,6 +225,15 @@ namespace ADDON
     void StopServices(const bool onlylogin);
 
   private:
+    /*! \brief Get the current addon snapshot, building it if it has been invalidated.
+     The returned snapshot stays valid for as long as the caller holds on to it.
+     */
+    AddonSnapshotPtr GetSnapshot();
+
+    /*! \brief Drop the current addon snapshot so that the next query rebuilds it.
+     */
+    void InvalidateSnapshot();
+
     void LoadAddons(const std::string &path,
                     std::map<std::string, AddonPtr>& unresolved);
 
@@ -218,6 +268,8 @@ namespace ADDON
     virtual ~CAddonMgr();
 
     std::map<std::string, bool> m_disabled;
+    AddonSnapshotPtr m_snapshot;
+    unsigned int m_snapshotVersion;
     static std::map<TYPE, IAddonMgrCallback*> m_managers;
     CCriticalSection m_critSection;
     CAddonDatabase m_database;
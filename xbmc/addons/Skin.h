@@ -96,6 +96,12 @@ public:
 
   void ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
 
+  /*! \brief Load an include file that windows may refer to, if it isn't loaded yet */
+  void LoadIncludeFile(const std::string &file) { m_includes.LoadIncludes(file); }
+
+  /*! \brief The include files loaded so far */
+  const std::vector<std::string>& GetIncludeFiles() const { return m_includes.GetFiles(); }
+
   float GetEffectsSlowdown() const { return m_effectsSlowDown; };
 
   const std::vector<CStartupWindow> &GetStartupWindows() const { return m_startupWindows; };
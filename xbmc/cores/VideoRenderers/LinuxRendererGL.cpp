@@ -119,6 +119,9 @@ CLinuxRendererGL::YUVBUFFER::YUVBUFFER()
   memset(&image , 0, sizeof(image));
   memset(&pbo   , 0, sizeof(pbo));
   flipindex = 0;
+  frameRef = NULL;
+  memset(&frameData  , 0, sizeof(frameData));
+  memset(&frameStride, 0, sizeof(frameStride));
 #ifdef HAVE_LIBVDPAU
   vdpau = NULL;
 #endif
@@ -132,6 +135,7 @@ CLinuxRendererGL::YUVBUFFER::YUVBUFFER()
 
 CLinuxRendererGL::YUVBUFFER::~YUVBUFFER()
 {
+  SAFE_RELEASE(frameRef);
 #ifdef TARGET_DARWIN_OSX
   if (cvBufferRef)
     CVBufferRelease(cvBufferRef);
@@ -346,7 +350,10 @@ int CLinuxRendererGL::GetImage(YV12Image *image, int source, bool readonly)
   if( readonly )
     im.flags |= IMAGE_FLAG_READING;
   else
+  {
     im.flags |= IMAGE_FLAG_WRITING;
+    SAFE_RELEASE(m_buffers[source].frameRef);
+  }
 
   // copy the image - should be operator of YV12Image
   for (int p=0;p<MAX_PLANES;p++)
@@ -549,9 +556,8 @@ void CLinuxRendererGL::Flush()
 
 void CLinuxRendererGL::ReleaseBuffer(int idx)
 {
-#if defined(HAVE_LIBVDPAU) || defined(HAVE_LIBVA) || defined(TARGET_DARWIN)
   YUVBUFFER &buf = m_buffers[idx];
-#endif
+  SAFE_RELEASE(buf.frameRef);
 #ifdef HAVE_LIBVDPAU
   SAFE_RELEASE(buf.vdpau);
 #endif
@@ -1725,6 +1731,15 @@ bool CLinuxRendererGL::UploadYV12Texture(int source)
   glEnable(m_textureTarget);
   VerifyGLState();
 
+  // planes of a picture added by AddVideoPicture() are loaded from the decoder's buffers
+  BYTE *plane[MAX_PLANES];
+  int   stride[MAX_PLANES];
+  for (int p = 0; p < MAX_PLANES; p++)
+  {
+    plane[p]  = buf.frameRef ? buf.frameData[p]   : im->plane[p];
+    stride[p] = buf.frameRef ? buf.frameStride[p] : im->stride[p];
+  }
+
   glPixelStorei(GL_UNPACK_ALIGNMENT,1);
 
   if (deinterlacing)
@@ -1732,47 +1747,47 @@ bool CLinuxRendererGL::UploadYV12Texture(int source)
     // Load Even Y Field
     LoadPlane( fields[FIELD_TOP][0] , GL_LUMINANCE, buf.flipindex
              , im->width, im->height >> 1
-             , im->stride[0]*2, im->bpp, im->plane[0] );
+             , stride[0]*2, im->bpp, plane[0] );
 
     //load Odd Y Field
     LoadPlane( fields[FIELD_BOT][0], GL_LUMINANCE, buf.flipindex
              , im->width, im->height >> 1
-             , im->stride[0]*2, im->bpp, im->plane[0] + im->stride[0]) ;
+             , stride[0]*2, im->bpp, plane[0] + stride[0]) ;
 
     // Load Even U & V Fields
     LoadPlane( fields[FIELD_TOP][1], GL_LUMINANCE, buf.flipindex
              , im->width >> im->cshift_x, im->height >> (im->cshift_y + 1)
-             , im->stride[1]*2, im->bpp, im->plane[1] );
+             , stride[1]*2, im->bpp, plane[1] );
 
     LoadPlane( fields[FIELD_TOP][2], GL_ALPHA, buf.flipindex
              , im->width >> im->cshift_x, im->height >> (im->cshift_y + 1)
-             , im->stride[2]*2, im->bpp, im->plane[2] );
+             , stride[2]*2, im->bpp, plane[2] );
 
     // Load Odd U & V Fields
     LoadPlane( fields[FIELD_BOT][1], GL_LUMINANCE, buf.flipindex
              , im->width >> im->cshift_x, im->height >> (im->cshift_y + 1)
-             , im->stride[1]*2, im->bpp, im->plane[1] + im->stride[1] );
+             , stride[1]*2, im->bpp, plane[1] + stride[1] );
 
     LoadPlane( fields[FIELD_BOT][2], GL_ALPHA, buf.flipindex
              , im->width >> im->cshift_x, im->height >> (im->cshift_y + 1)
-             , im->stride[2]*2, im->bpp, im->plane[2] + im->stride[2] );
+             , stride[2]*2, im->bpp, plane[2] + stride[2] );
   }
   else
   {
     //Load Y plane
     LoadPlane( fields[FIELD_FULL][0], GL_LUMINANCE, buf.flipindex
              , im->width, im->height
-             , im->stride[0], im->bpp, im->plane[0] );
+             , stride[0], im->bpp, plane[0] );
 
     //load U plane
     LoadPlane( fields[FIELD_FULL][1], GL_LUMINANCE, buf.flipindex
              , im->width >> im->cshift_x, im->height >> im->cshift_y
-             , im->stride[1], im->bpp, im->plane[1] );
+             , stride[1], im->bpp, plane[1] );
 
     //load V plane
     LoadPlane( fields[FIELD_FULL][2], GL_ALPHA, buf.flipindex
              , im->width >> im->cshift_x, im->height >> im->cshift_y
-             , im->stride[2], im->bpp, im->plane[2] );
+             , stride[2], im->bpp, plane[2] );
   }
 
   VerifyGLState();
@@ -1785,6 +1800,8 @@ bool CLinuxRendererGL::UploadYV12Texture(int source)
 
 void CLinuxRendererGL::DeleteYV12Texture(int index)
 {
+  SAFE_RELEASE(m_buffers[index].frameRef);
+
   YV12Image &im     = m_buffers[index].image;
   YUVFIELDS &fields = m_buffers[index].fields;
   GLuint    *pbo    = m_buffers[index].pbo;
@@ -3469,6 +3486,48 @@ unsigned int CLinuxRendererGL::GetOptimalBufferSize()
     return 3;
 }
 
+bool CLinuxRendererGL::AddVideoPicture(DVDVideoPicture* picture, int index)
+{
+  // without pixel buffer objects the planes are uploaded from system memory anyway, so
+  // keep a reference to the decoder's buffers and upload from those instead of a copy.
+  // with them, copying into the mapped buffer on the decoder thread is the cheaper upload.
+  if (!picture->frameRef || m_pboUsed || !m_bValidated
+  ||  m_textureUpload != &CLinuxRendererGL::UploadYV12Texture)
+    return false;
+
+  if (picture->format != m_format
+  || (picture->format != RENDER_FMT_YUV420P
+   && picture->format != RENDER_FMT_YUV420P10
+   && picture->format != RENDER_FMT_YUV420P16))
+    return false;
+
+  YUVBUFFER &buf = m_buffers[index];
+  YV12Image &im  = buf.image;
+  if ((im.flags&(~IMAGE_FLAG_READY)) != 0
+  || picture->iWidth != im.width || picture->iHeight != im.height)
+    return false;
+
+  for (int p = 0; p < 3; p++)
+  {
+    if (!picture->data[p] || picture->iLineSize[p] <= 0)
+      return false;
+  }
+
+  CDVDVideoFrameRef *frameRef = picture->frameRef->Acquire();
+  SAFE_RELEASE(buf.frameRef);
+  buf.frameRef = frameRef;
+  for (int p = 0; p < MAX_PLANES; p++)
+  {
+    buf.frameData[p]   = p < 3 ? picture->data[p]      : NULL;
+    buf.frameStride[p] = p < 3 ? picture->iLineSize[p] : 0;
+  }
+
+  im.flags &= ~IMAGE_FLAG_INUSE;
+  im.flags |= IMAGE_FLAG_READY;
+  m_bImageReady = true;
+  return true;
+}
+
 #ifdef HAVE_LIBVDPAU
 void CLinuxRendererGL::AddProcessor(VDPAU::CVdpauRenderPicture *vdpau, int index)
 {
@@ -38,6 +38,8 @@
 class CRenderCapture;
 
 class CBaseTexture;
+class CDVDVideoFrameRef;
+struct DVDVideoPicture;
 namespace Shaders { class BaseYUV2RGBShader; }
 namespace Shaders { class BaseVideoFilterShader; }
 namespace VAAPI   { class CVaapiRenderPicture; }
@@ -136,6 +138,7 @@ public:
   virtual void         SetBufferSize(int numBuffers) { m_NumYV12Buffers = numBuffers; }
   virtual unsigned int GetMaxBufferSize() { return NUM_BUFFERS; }
   virtual unsigned int GetOptimalBufferSize();
+  virtual bool         AddVideoPicture(DVDVideoPicture* picture, int index);
 
 #ifdef HAVE_LIBVDPAU
   virtual void         AddProcessor(VDPAU::CVdpauRenderPicture* vdpau, int index);
@@ -276,6 +279,11 @@ protected:
     unsigned  flipindex; /* used to decide if this has been uploaded */
     GLuint    pbo[MAX_PLANES];
 
+    // decoder buffers to upload instead of image, see AddVideoPicture()
+    CDVDVideoFrameRef *frameRef;
+    BYTE              *frameData[MAX_PLANES];
+    int                frameStride[MAX_PLANES];
+
 #ifdef HAVE_LIBVDPAU
     VDPAU::CVdpauRenderPicture *vdpau;
 #endif
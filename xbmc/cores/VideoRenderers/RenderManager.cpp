@@ -119,6 +119,9 @@ CXBMCRenderManager::CXBMCRenderManager()
   m_errorindex = 0;
   m_QueueSize   = 2;
   m_QueueSkip   = 0;
+  m_picturesDirect = 0;
+  m_picturesCopied = 0;
+  m_bytesCopied = 0;
   m_format      = RENDER_FMT_NONE;
   m_renderedOverlay = false;
 }
@@ -287,6 +290,10 @@ bool CXBMCRenderManager::Configure(unsigned int width, unsigned int height, unsi
     for (int i=1; i < m_QueueSize; i++)
       m_free.push_back(i);
 
+    m_picturesDirect = 0;
+    m_picturesCopied = 0;
+    m_bytesCopied = 0;
+
     m_bIsStarted = true;
     m_bRenderGUI = true;
     m_bReconfigured = true;
@@ -460,6 +467,11 @@ void CXBMCRenderManager::UnInit()
 {
   CRetakeLock<CExclusiveLock> lock(m_sharedSection);
 
+  if (m_picturesDirect + m_picturesCopied > 0)
+    CLog::Log(LOGDEBUG, "CXBMCRenderManager::UnInit - %u pictures taken by the renderer, %u copied (%.1f MB, %u bytes per picture)",
+              m_picturesDirect, m_picturesCopied, m_bytesCopied / (1024.0 * 1024.0),
+              m_picturesCopied ? (unsigned int)(m_bytesCopied / m_picturesCopied) : 0);
+
   m_bIsStarted = false;
 
   m_overlays.Flush();
@@ -953,26 +965,20 @@ int CXBMCRenderManager::AddVideoPicture(DVDVideoPicture& pic)
   }
 
   if(m_pRenderer->AddVideoPicture(&pic, index))
+  {
+    m_picturesDirect++;
     return 1;
+  }
 
   YV12Image image;
   if (m_pRenderer->GetImage(&image, index) < 0)
     return -1;
 
-  if(pic.format == RENDER_FMT_YUV420P
-  || pic.format == RENDER_FMT_YUV420P10
-  || pic.format == RENDER_FMT_YUV420P16)
-  {
-    CDVDCodecUtils::CopyPicture(&image, &pic);
-  }
-  else if(pic.format == RENDER_FMT_NV12)
+  unsigned int copied = CopyPicture(image, pic);
+  if (copied)
   {
-    CDVDCodecUtils::CopyNV12Picture(&image, &pic);
-  }
-  else if(pic.format == RENDER_FMT_YUYV422
-       || pic.format == RENDER_FMT_UYVY422)
-  {
-    CDVDCodecUtils::CopyYUV422PackedPicture(&image, &pic);
+    m_picturesCopied++;
+    m_bytesCopied += copied;
   }
   else if(pic.format == RENDER_FMT_DXVA)
   {
@@ -1022,6 +1028,31 @@ int CXBMCRenderManager::AddVideoPicture(DVDVideoPicture& pic)
   return index;
 }
 
+unsigned int CXBMCRenderManager::CopyPicture(YV12Image& image, DVDVideoPicture& pic)
+{
+  if(pic.format == RENDER_FMT_YUV420P
+  || pic.format == RENDER_FMT_YUV420P10
+  || pic.format == RENDER_FMT_YUV420P16)
+  {
+    CDVDCodecUtils::CopyPicture(&image, &pic);
+    unsigned int luma   = image.width * image.bpp * image.height;
+    unsigned int chroma = (image.width >> image.cshift_x) * image.bpp * (image.height >> image.cshift_y);
+    return luma + 2 * chroma;
+  }
+  else if(pic.format == RENDER_FMT_NV12)
+  {
+    CDVDCodecUtils::CopyNV12Picture(&image, &pic);
+    return pic.iWidth * pic.iHeight + pic.iWidth * (pic.iHeight >> 1);
+  }
+  else if(pic.format == RENDER_FMT_YUYV422
+       || pic.format == RENDER_FMT_UYVY422)
+  {
+    CDVDCodecUtils::CopyYUV422PackedPicture(&image, &pic);
+    return pic.iWidth * pic.iHeight * 2;
+  }
+  return 0;
+}
+
 bool CXBMCRenderManager::Supports(ERENDERFEATURE feature)
 {
   CSharedLock lock(m_sharedSection);
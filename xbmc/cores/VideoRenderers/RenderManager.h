@@ -92,6 +92,13 @@ public:
 
   int AddVideoPicture(DVDVideoPicture& picture);
 
+  /**
+   * Copy a software decoded picture into the image of a render buffer, the
+   * way AddVideoPicture does when the renderer doesn't take the picture itself.
+   * @return the number of bytes written to the image, 0 if the format isn't copied
+   */
+  static unsigned int CopyPicture(YV12Image& image, DVDVideoPicture& picture);
+
   /**
    * Called by video player to flip render buffers
    * If buffering is enabled this method does not block. In case of disabled buffering
@@ -232,6 +239,11 @@ protected:
   int m_QueueSize;
   int m_QueueSkip;
 
+  // pictures since Configure that the renderer took without a copy, and the ones copied
+  unsigned int m_picturesDirect;
+  unsigned int m_picturesCopied;
+  uint64_t     m_bytesCopied;
+
   struct SPresent
   {
     double         pts;
@@ -51,6 +51,7 @@ DVDVideoPicture* CDVDCodecUtils::AllocatePicture(int iWidth, int iHeight)
   {
     pPicture->iWidth = iWidth;
     pPicture->iHeight = iHeight;
+    pPicture->frameRef = NULL;
 
     int w = iWidth / 2;
     int h = iHeight / 2;
@@ -184,6 +185,7 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToNV12Picture(DVDVideoPicture *pSrc)
   if (pPicture)
   {
     *pPicture = *pSrc;
+    pPicture->frameRef = NULL;
 
     int w = pPicture->iWidth / 2;
     int h = pPicture->iHeight / 2;
@@ -241,6 +243,7 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToYUV422PackedPicture(DVDVideoPicture *p
   if (pPicture)
   {
     *pPicture = *pSrc;
+    pPicture->frameRef = NULL;
 
     int totalsize = pPicture->iWidth * pPicture->iHeight * 2;
     uint8_t* data = new uint8_t[totalsize];
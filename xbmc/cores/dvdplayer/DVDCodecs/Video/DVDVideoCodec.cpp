@@ -23,6 +23,28 @@
 #include "settings/Settings.h"
 #include "settings/lib/Setting.h"
 
+CDVDVideoFrameRef* CDVDVideoFrameRef::Create(const AVFrame* frame)
+{
+  if (!frame || !frame->buf[0])
+    return NULL;
+
+  AVFrame* ref = av_frame_alloc();
+  if (!ref)
+    return NULL;
+
+  if (av_frame_ref(ref, frame) < 0)
+  {
+    av_frame_free(&ref);
+    return NULL;
+  }
+  return new CDVDVideoFrameRef(ref);
+}
+
+CDVDVideoFrameRef::~CDVDVideoFrameRef()
+{
+  av_frame_free(&m_frame);
+}
+
 bool CDVDVideoCodec::IsSettingVisible(const std::string &condition, const std::string &value, const CSetting *setting)
 {
   if (setting == NULL || value.empty())
@@ -25,6 +25,7 @@
 #include <vector>
 #include <string>
 #include "cores/VideoRenderers/RenderFormats.h"
+#include "cores/dvdplayer/DVDResource.h"
 
 
 
@@ -59,6 +60,28 @@ class CDVDVideoCodecIMXBuffer;
 class CMMALVideoBuffer;
 typedef void* EGLImageKHR;
 
+/*!
+ \brief A reference to the buffers of a decoded AVFrame.
+ Software decoders hand one out with their pictures so a renderer can upload the
+ planes straight from decoder memory, keeping the buffers alive until it's done.
+ */
+class CDVDVideoFrameRef : public IDVDResourceCounted<CDVDVideoFrameRef>
+{
+public:
+  /*!
+   \brief Reference the buffers of a frame.
+   \return the reference, NULL if the frame isn't reference counted.
+   */
+  static CDVDVideoFrameRef* Create(const AVFrame* frame);
+  virtual ~CDVDVideoFrameRef();
+
+  const AVFrame* GetFrame() const { return m_frame; }
+
+private:
+  CDVDVideoFrameRef(AVFrame* frame) : m_frame(frame) {}
+  AVFrame* m_frame;
+};
+
 
 // should be entirely filled by all codecs
 struct DVDVideoPicture
@@ -133,6 +156,8 @@ struct DVDVideoPicture
   unsigned int iDisplayHeight; // height of the picture without black bars
 
   ERenderFormat format;
+
+  CDVDVideoFrameRef* frameRef; // buffers data[] points into (software decoders only), NULL if the picture must be copied
 };
 
 struct DVDVideoUserData
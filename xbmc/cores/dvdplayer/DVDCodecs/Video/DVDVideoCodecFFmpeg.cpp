@@ -159,6 +159,7 @@ CDVDVideoCodecFFmpeg::CDVDVideoCodecFFmpeg() : CDVDVideoCodec()
 {
   m_pCodecContext = NULL;
   m_pFrame = NULL;
+  m_pFrameRef = NULL;
   m_pFilterGraph  = NULL;
   m_pFilterIn     = NULL;
   m_pFilterOut    = NULL;
@@ -311,6 +312,9 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     || pCodec->id == AV_CODEC_ID_VP9))
     m_pCodecContext->thread_count = num_threads;
 
+  // keep the frames we get, so renderers can reference them instead of copying
+  m_pCodecContext->refcounted_frames = 1;
+
   if (avcodec_open2(m_pCodecContext, pCodec, NULL) < 0)
   {
     CLog::Log(LOGDEBUG,"CDVDVideoCodecFFmpeg::Open() Unable to open codec");
@@ -329,8 +333,8 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
 
 void CDVDVideoCodecFFmpeg::Dispose()
 {
-  if (m_pFrame) av_free(m_pFrame);
-  m_pFrame = NULL;
+  SAFE_RELEASE(m_pFrameRef);
+  av_frame_free(&m_pFrame);
 
   av_frame_free(&m_pFilterFrame);
 
@@ -488,6 +492,7 @@ int CDVDVideoCodecFFmpeg::Decode(uint8_t* pData, int iSize, double dts, double p
   /* We lie, but this flag is only used by pngdec.c.
    * Setting it correctly would allow CorePNG decoding. */
   avpkt.flags = AV_PKT_FLAG_KEY;
+  av_frame_unref(m_pFrame);
   len = avcodec_decode_video2(m_pCodecContext, m_pFrame, &iGotPicture, &avpkt);
 
   if(m_iLastKeyframe < m_pCodecContext->has_b_frames + 2)
@@ -730,6 +735,15 @@ bool CDVDVideoCodecFFmpeg::GetPicture(DVDVideoPicture* pDvdVideoPicture)
   pix_fmt = (PixelFormat)m_pFrame->format;
 
   pDvdVideoPicture->format = CDVDCodecUtils::EFormatFromPixfmt(pix_fmt);
+
+  // only planar yuv frames in system memory can be uploaded from the decoder's buffers
+  SAFE_RELEASE(m_pFrameRef);
+  if (!(pDvdVideoPicture->iFlags & DVP_FLAG_DROPPED)
+  && (pDvdVideoPicture->format == RENDER_FMT_YUV420P
+   || pDvdVideoPicture->format == RENDER_FMT_YUV420P10
+   || pDvdVideoPicture->format == RENDER_FMT_YUV420P16))
+    m_pFrameRef = CDVDVideoFrameRef::Create(m_pFrame);
+  pDvdVideoPicture->frameRef = m_pFrameRef;
   return true;
 }
 
@@ -94,6 +94,7 @@ protected:
   }
 
   AVFrame* m_pFrame;
+  CDVDVideoFrameRef* m_pFrameRef; // m_pFrame's buffers, as handed out by GetPicture()
   AVCodecContext* m_pCodecContext;
 
   std::string       m_filters;
@@ -37,6 +37,7 @@
 #include "DVDInputStreams/DVDInputStreamPVRManager.h"
 #include "DVDInputStreams/DVDInputStreamFFmpeg.h"
 #include "DVDDemuxUtils.h"
+#include "DVDDemuxReadAhead.h"
 #include "DVDClock.h" // for DVD_TIME_BASE
 #include "commons/Exception.h"
 #include "settings/AdvancedSettings.h"
@@ -141,8 +142,7 @@ static int dvd_file_read(void *h, uint8_t* buf, int size)
   if(interrupt_cb(h))
     return AVERROR_EXIT;
 
-  CDVDInputStream* pInputStream = static_cast<CDVDDemuxFFmpeg*>(h)->m_pInput;
-  return pInputStream->Read(buf, size);
+  return static_cast<CDVDDemuxFFmpeg*>(h)->m_readAhead->Read(buf, size);
 }
 /*
 static int dvd_file_write(URLContext *h, uint8_t* buf, int size)
@@ -155,11 +155,11 @@ static int64_t dvd_file_seek(void *h, int64_t pos, int whence)
   if(interrupt_cb(h))
     return AVERROR_EXIT;
 
-  CDVDInputStream* pInputStream = static_cast<CDVDDemuxFFmpeg*>(h)->m_pInput;
+  CDVDDemuxFFmpeg* demuxer = static_cast<CDVDDemuxFFmpeg*>(h);
   if(whence == AVSEEK_SIZE)
-    return pInputStream->GetLength();
-  else
-    return pInputStream->Seek(pos, whence & ~AVSEEK_FORCE);
+    return demuxer->m_pInput->GetLength();
+
+  return demuxer->m_readAhead->Seek(pos, whence & ~AVSEEK_FORCE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -179,6 +179,10 @@ CDVDDemuxFFmpeg::CDVDDemuxFFmpeg() : CDVDDemux()
   memset(&m_pkt.pkt, 0, sizeof(AVPacket));
   m_streaminfo = true; /* set to true if we want to look for streams before playback */
   m_checkvideo = false;
+  m_readAhead = NULL;
+  m_openStart = 0;
+  m_opened = 0;
+  m_firstPacket = 0;
 }
 
 CDVDDemuxFFmpeg::~CDVDDemuxFFmpeg()
@@ -199,6 +203,20 @@ bool CDVDDemuxFFmpeg::Aborted()
   return false;
 }
 
+int64_t CDVDDemuxFFmpeg::GetInputPosition()
+{
+  if (m_readAhead)
+    return m_readAhead->GetPosition();
+  return m_pInput->Seek(0, SEEK_CUR);
+}
+
+bool CDVDDemuxFFmpeg::IsInputEOF()
+{
+  if (m_readAhead)
+    return m_readAhead->IsEOF();
+  return m_pInput->IsEOF();
+}
+
 bool CDVDDemuxFFmpeg::Open(CDVDInputStream* pInput, bool streaminfo, bool fileinfo)
 {
   AVInputFormat* iformat = NULL;
@@ -211,6 +229,10 @@ bool CDVDDemuxFFmpeg::Open(CDVDInputStream* pInput, bool streaminfo, bool filein
 
   if (!pInput) return false;
 
+  m_openStart = CurrentHostCounter();
+  m_opened = 0;
+  m_firstPacket = 0;
+
   m_pInput = pInput;
   strFile = m_pInput->GetFileName();
 
@@ -269,6 +291,14 @@ bool CDVDDemuxFFmpeg::Open(CDVDInputStream* pInput, bool streaminfo, bool filein
   }
   else
   {
+    // plain files have seekable bytes that don't change under us, so they
+    // can be read in larger blocks that are kept for seeking back to them
+    bool readAhead = g_advancedSettings.m_videoDemuxReadAhead
+                  && m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE)
+                  && m_pInput->GetBlockSize() == 0
+                  && m_pInput->Seek(0, SEEK_POSSIBLE) != 0;
+    m_readAhead = new CDVDDemuxReadAhead(m_pInput, readAhead);
+
     unsigned char* buffer = (unsigned char*)av_malloc(FFMPEG_FILE_BUFFER_SIZE);
     m_ioContext = avio_alloc_context(buffer, FFMPEG_FILE_BUFFER_SIZE, 0, this, dvd_file_read, NULL, dvd_file_seek);
     m_ioContext->max_packet_size = m_pInput->GetBlockSize();
@@ -498,6 +528,15 @@ bool CDVDDemuxFFmpeg::Open(CDVDInputStream* pInput, bool streaminfo, bool filein
   if (skipCreateStreams && GetNrOfStreams() == 0)
     m_program = 0;
 
+  m_opened = CurrentHostCounter() - m_openStart;
+  if (m_readAhead)
+  {
+    const CDVDDemuxReadAhead::SStats &stats = m_readAhead->GetStats();
+    CLog::Log(LOGDEBUG, "%s - opened in %.1f ms, %u requests took %" PRId64" bytes in %u reads and %u seeks, blocked for %.1f ms",
+              __FUNCTION__, m_opened * 1000.0 / CurrentHostFrequency(), stats.requests, stats.bytes,
+              stats.reads, stats.seeks, stats.blocked * 1000.0 / CurrentHostFrequency());
+  }
+
   return true;
 }
 
@@ -506,6 +545,14 @@ void CDVDDemuxFFmpeg::Dispose()
   m_pkt.result = -1;
   av_free_packet(&m_pkt.pkt);
 
+  if (m_readAhead)
+  {
+    const CDVDDemuxReadAhead::SStats &stats = m_readAhead->GetStats();
+    CLog::Log(LOGDEBUG, "%s - %u requests took %" PRId64" bytes in %u reads and %u seeks, blocked for %.1f ms",
+              __FUNCTION__, stats.requests, stats.bytes, stats.reads, stats.seeks,
+              stats.blocked * 1000.0 / CurrentHostFrequency());
+  }
+
   if (m_pFormatContext)
   {
     if (m_ioContext && m_pFormatContext->pb && m_pFormatContext->pb != m_ioContext)
@@ -522,6 +569,8 @@ void CDVDDemuxFFmpeg::Dispose()
     av_free(m_ioContext);
   }
 
+  delete m_readAhead;
+  m_readAhead = NULL;
   m_ioContext = NULL;
   m_pFormatContext = NULL;
   m_speed = DVD_PLAYSPEED_NORMAL;
@@ -872,6 +921,12 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
     // set continuous stream id for player
     pPacket->iStreamId = stream->iId;
   }
+
+  if (!m_firstPacket && pPacket->iSize > 0)
+  {
+    m_firstPacket = CurrentHostCounter() - m_openStart;
+    CLog::Log(LOGDEBUG, "%s - first packet %.1f ms after opening", __FUNCTION__, m_firstPacket * 1000.0 / CurrentHostFrequency());
+  }
   return pPacket;
 }
 
@@ -923,7 +978,7 @@ bool CDVDDemuxFFmpeg::SeekTime(int time, bool backwords, double *startpts)
     // demuxer will return failure, if you seek behind eof
     if (ret < 0 && m_pFormatContext->duration && seek_pts >= (m_pFormatContext->duration + m_pFormatContext->start_time))
       ret = 0;
-    else if (ret < 0 && m_pInput->IsEOF())
+    else if (ret < 0 && IsInputEOF())
       ret = 0;
 
     if(ret >= 0)
@@ -32,6 +32,7 @@ extern "C" {
 
 class CDVDDemuxFFmpeg;
 class CURL;
+class CDVDDemuxReadAhead;
 
 class CDemuxStreamVideoFFmpeg
   : public CDemuxStreamVideo
@@ -118,6 +119,14 @@ public:
   AVFormatContext* m_pFormatContext;
   CDVDInputStream* m_pInput;
 
+  CDVDDemuxReadAhead* m_readAhead; // reads for our AVIOContext and counts its I/O
+
+  int64_t GetInputPosition(); ///< position in the input stream packets have been read up to
+  bool IsInputEOF();          ///< whether packets have been read up to the end of the input stream
+
+  int64_t GetOpenTime() const { return m_opened; }             ///< time spent in Open, in host counter ticks
+  int64_t GetFirstPacketTime() const { return m_firstPacket; } ///< time from Open to the first packet, in host counter ticks
+
 protected:
   friend class CDemuxStreamAudioFFmpeg;
   friend class CDemuxStreamVideoFFmpeg;
@@ -148,6 +157,9 @@ protected:
   std::vector<std::map<int, CDemuxStream*>::iterator> m_stream_index;
 
   AVIOContext* m_ioContext;
+  int64_t m_openStart;
+  int64_t m_opened;
+  int64_t m_firstPacket;
 
   double   m_currentPts; // used for stream length estimation
   bool     m_bMatroska;
@@ -0,0 +1,201 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DVDDemuxReadAhead.h"
+#include "DVDInputStreams/DVDInputStream.h"
+#include "utils/TimeUtils.h"
+
+#include <algorithm>
+#include <string.h>
+
+CDVDDemuxReadAhead::CDVDDemuxReadAhead(CDVDInputStream *input, bool readAhead)
+  : m_input(input),
+    m_readAhead(readAhead),
+    m_pos(0),
+    m_inputPos(-1),
+    m_lastEnd(-1),
+    m_blockSize(READAHEAD_MIN_BLOCK),
+    m_used(0)
+{
+  memset(&m_stats, 0, sizeof(m_stats));
+
+  // the input stream may have been read from by the demuxers probed before
+  if (m_readAhead)
+  {
+    m_pos = m_inputPos = SeekInput(0, SEEK_CUR);
+    if (m_pos < 0)
+      m_readAhead = false;
+  }
+}
+
+int CDVDDemuxReadAhead::Read(uint8_t *buf, int size)
+{
+  m_stats.requests++;
+  if (!m_readAhead)
+    return ReadInput(buf, size);
+
+  Block *block = FindBlock(m_pos);
+  if (!block)
+  {
+    int ret = Fill(m_pos, size);
+    if (ret <= 0)
+      return ret;
+    block = FindBlock(m_pos);
+  }
+
+  int len = (int)std::min<int64_t>(size, block->pos + block->data.size() - m_pos);
+  memcpy(buf, &block->data[m_pos - block->pos], len);
+  m_pos += len;
+  return len;
+}
+
+int64_t CDVDDemuxReadAhead::Seek(int64_t pos, int whence)
+{
+  m_stats.requests++;
+  if (!m_readAhead || (whence != SEEK_SET && whence != SEEK_CUR && whence != SEEK_END))
+    return SeekInput(pos, whence);
+
+  if (whence == SEEK_CUR)
+  {
+    pos += m_pos;
+    whence = SEEK_SET;
+  }
+
+  // a seek of the input stream is what clears its eof state
+  if (whence == SEEK_SET && FindBlock(pos) && !m_input->IsEOF())
+  {
+    m_pos = pos;
+    return pos;
+  }
+
+  int64_t ret = SeekInput(pos, whence);
+  if (ret >= 0)
+    m_pos = ret;
+  return ret;
+}
+
+int64_t CDVDDemuxReadAhead::GetPosition()
+{
+  if (!m_readAhead)
+    return m_input->Seek(0, SEEK_CUR);
+  return m_pos;
+}
+
+bool CDVDDemuxReadAhead::IsEOF()
+{
+  if (!m_input->IsEOF())
+    return false;
+  // the input stream is at its end once the last block has been read into memory
+  if (!m_readAhead || m_inputPos < 0)
+    return true;
+  return m_pos >= m_inputPos;
+}
+
+CDVDDemuxReadAhead::Block *CDVDDemuxReadAhead::FindBlock(int64_t pos)
+{
+  for (std::vector<Block>::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+  {
+    if (pos >= it->pos && pos < it->pos + (int64_t)it->data.size())
+    {
+      it->used = ++m_used;
+      return &*it;
+    }
+  }
+  return NULL;
+}
+
+int CDVDDemuxReadAhead::Fill(int64_t pos, int size)
+{
+  int blockSize;
+  if (pos == m_lastEnd)
+  {
+    m_blockSize = std::min(m_blockSize * 2, READAHEAD_MAX_BLOCK);
+    blockSize = m_blockSize;
+  }
+  else
+  {
+    m_blockSize = READAHEAD_MIN_BLOCK;
+    blockSize = m_blockSize;
+
+    // indexes are at the end of the file and get read completely
+    int64_t length = m_input->GetLength();
+    if (length > pos && length - pos <= READAHEAD_MAX_BLOCK)
+      blockSize = (int)(length - pos);
+  }
+  blockSize = std::max(blockSize, size);
+
+  if (m_inputPos != pos && SeekInput(pos, SEEK_SET) != pos)
+    return -1;
+
+  Block *block;
+  if (m_blocks.size() < READAHEAD_BLOCKS)
+  {
+    m_blocks.push_back(Block());
+    block = &m_blocks.back();
+  }
+  else
+  {
+    block = &m_blocks[0];
+    for (std::vector<Block>::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+    {
+      if (it->used < block->used)
+        block = &*it;
+    }
+  }
+
+  block->data.resize(blockSize);
+  int ret = ReadInput(&block->data[0], blockSize);
+  block->pos = pos;
+  block->used = ++m_used;
+  block->data.resize(std::max(ret, 0));
+  if (ret > 0)
+    m_lastEnd = pos + ret;
+  return ret;
+}
+
+int CDVDDemuxReadAhead::ReadInput(uint8_t *buf, int size)
+{
+  int64_t start = CurrentHostCounter();
+  int ret = m_input->Read(buf, size);
+  m_stats.blocked += CurrentHostCounter() - start;
+  m_stats.reads++;
+  if (ret > 0)
+  {
+    m_stats.bytes += ret;
+    if (m_inputPos >= 0)
+      m_inputPos += ret;
+  }
+  else if (ret < 0)
+    m_inputPos = -1;
+  return ret;
+}
+
+int64_t CDVDDemuxReadAhead::SeekInput(int64_t pos, int whence)
+{
+  int64_t start = CurrentHostCounter();
+  int64_t ret = m_input->Seek(pos, whence);
+  m_stats.blocked += CurrentHostCounter() - start;
+  if (whence != SEEK_POSSIBLE)
+  {
+    m_stats.seeks++;
+    m_inputPos = ret;
+  }
+  return ret;
+}
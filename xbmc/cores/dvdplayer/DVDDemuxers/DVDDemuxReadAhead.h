@@ -0,0 +1,93 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+class CDVDInputStream;
+
+#define READAHEAD_MIN_BLOCK  (32 * 1024)   // size of the first read after a seek
+#define READAHEAD_MAX_BLOCK  (1024 * 1024) // the block size doubles up to this while reading sequentially
+#define READAHEAD_BLOCKS     4             // blocks kept for reading them again after a seek
+
+/*! \brief Reads from an input stream for the AVIOContext of CDVDDemuxFFmpeg
+ Probing and avformat_find_stream_info make many small reads, and containers
+ jump between their header and an index at the end of the file (mp4 moov,
+ mkv cues, avi idx1) and back. Every one of those is a blocking call into
+ the input stream, which on a network source is a round trip each.
+
+ Reads are made in blocks of READAHEAD_MIN_BLOCK bytes, doubling while the
+ stream is read sequentially. A seek into the last READAHEAD_MAX_BLOCK bytes
+ of the file reads up to its end in one go, as that's where the indexes are.
+ The last READAHEAD_BLOCKS blocks are kept, so seeking back into them doesn't
+ touch the input stream at all.
+
+ Without read-ahead, reads and seeks go to the input stream as they are and
+ are only counted.
+ */
+class CDVDDemuxReadAhead
+{
+public:
+  CDVDDemuxReadAhead(CDVDInputStream *input, bool readAhead);
+
+  int Read(uint8_t *buf, int size);
+  int64_t Seek(int64_t pos, int whence);
+
+  /*! \brief Position the demuxer has read up to, the input stream may be ahead of it */
+  int64_t GetPosition();
+  /*! \brief Whether the demuxer has read up to the end of the input stream */
+  bool IsEOF();
+
+  /*! \brief I/O done through the demuxer since it was opened */
+  struct SStats
+  {
+    int64_t  bytes;     ///< bytes read from the input stream
+    unsigned reads;     ///< read calls made to the input stream
+    unsigned seeks;     ///< seek calls made to the input stream
+    int64_t  blocked;   ///< time spent in those calls, in host counter ticks
+    unsigned requests;  ///< reads and seeks asked for by ffmpeg
+  };
+  const SStats &GetStats() const { return m_stats; }
+
+private:
+  struct Block
+  {
+    int64_t pos;
+    std::vector<uint8_t> data;
+    unsigned int used;
+  };
+
+  Block *FindBlock(int64_t pos);
+  int Fill(int64_t pos, int size);
+  int ReadInput(uint8_t *buf, int size);
+  int64_t SeekInput(int64_t pos, int whence);
+
+  CDVDInputStream *m_input;
+  bool m_readAhead;
+  int64_t m_pos;          ///< position the demuxer is at
+  int64_t m_inputPos;     ///< position the input stream is at, -1 when unknown
+  int64_t m_lastEnd;      ///< end of the last block read, for detecting sequential reads
+  int m_blockSize;
+  unsigned int m_used;    ///< for finding the least recently used block
+  std::vector<Block> m_blocks;
+  SStats m_stats;
+};
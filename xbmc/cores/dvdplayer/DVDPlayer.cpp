@@ -62,6 +62,7 @@
 #else
 #define MEASURE_FUNCTION
 #endif
+#include "utils/Trace.h"
 #include "settings/AdvancedSettings.h"
 #include "FileItem.h"
 #include "GUIUserMessages.h"
@@ -916,6 +917,7 @@ void CDVDPlayer::OpenDefaultStreams(bool reset)
 
 bool CDVDPlayer::ReadPacket(DemuxPacket*& packet, CDemuxStream*& stream)
 {
+  TRACE_FUNCTION;
 
   // check if we should read from subtitle demuxer
   if( m_pSubtitleDemuxer && m_dvdPlayerSubtitle->AcceptsData() )
@@ -1425,7 +1427,7 @@ void CDVDPlayer::Process()
       }
 #endif
 
-      if (!m_pInputStream->IsEOF())
+      if (!IsInputEOF())
         CLog::Log(LOGINFO, "%s - eof reading from demuxer", __FUNCTION__);
 
       m_CurrentAudio.started    = false;
@@ -1640,6 +1642,23 @@ void CDVDPlayer::ProcessTeletextData(CDemuxStream* pStream, DemuxPacket* pPacket
   m_dvdPlayerTeletext->SendMessage(new CDVDMsgDemuxerPacket(pPacket, drop));
 }
 
+int64_t CDVDPlayer::GetInputPosition()
+{
+  // the demuxer may read ahead of what it has turned into packets
+  CDVDDemuxFFmpeg* demuxer = dynamic_cast<CDVDDemuxFFmpeg*>(m_pDemuxer);
+  if (demuxer)
+    return demuxer->GetInputPosition();
+  return m_pInputStream->Seek(0, SEEK_CUR);
+}
+
+bool CDVDPlayer::IsInputEOF()
+{
+  CDVDDemuxFFmpeg* demuxer = dynamic_cast<CDVDDemuxFFmpeg*>(m_pDemuxer);
+  if (demuxer)
+    return demuxer->IsInputEOF();
+  return m_pInputStream->IsEOF();
+}
+
 bool CDVDPlayer::GetCachingTimes(double& level, double& delay, double& offset)
 {
   if(!m_pInputStream || !m_pDemuxer)
@@ -1655,7 +1674,7 @@ bool CDVDPlayer::GetCachingTimes(double& level, double& delay, double& offset)
   bool full        = status.full;
 
   int64_t length  = m_pInputStream->GetLength();
-  int64_t remain  = length - m_pInputStream->Seek(0, SEEK_CUR);
+  int64_t remain  = length - GetInputPosition();
 
   if(cached < 0 || length <= 0 || remain < 0)
     return false;
@@ -352,6 +352,8 @@ protected:
 
   double GetQueueTime();
   bool GetCachingTimes(double& play_left, double& cache_left, double& file_offset);
+  int64_t GetInputPosition();
+  bool IsInputEOF();
 
 
   void FlushBuffers(bool queued, double pts = DVD_NOPTS_VALUE, bool accurate = true, bool sync = true);
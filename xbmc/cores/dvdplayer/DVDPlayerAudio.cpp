@@ -28,6 +28,7 @@
 #include "video/VideoReferenceClock.h"
 #include "utils/log.h"
 #include "utils/TimeUtils.h"
+#include "utils/Trace.h"
 #include "utils/MathUtils.h"
 #include "cores/AudioEngine/AEFactory.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
@@ -246,6 +247,7 @@ void CDVDPlayerAudio::CloseStream(bool bWaitForBuffers)
 // decode one audio frame and returns its uncompressed size
 int CDVDPlayerAudio::DecodeFrame(DVDAudioFrame &audioframe)
 {
+  TRACE_FUNCTION;
   int result = 0;
 
   // make sure the sent frame is clean
@@ -44,6 +44,7 @@
 #include <iterator>
 #include "guilib/GraphicContext.h"
 #include "utils/log.h"
+#include "utils/Trace.h"
 
 using namespace std;
 using namespace RenderManager;
@@ -491,6 +492,7 @@ void CDVDPlayerVideo::Process()
 
     if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET))
     {
+      TRACE_SCOPE("CDVDPlayerVideo::Process - packet");
       DemuxPacket* pPacket = ((CDVDMsgDemuxerPacket*)pMsg)->GetPacket();
       bool bPacketDrop     = ((CDVDMsgDemuxerPacket*)pMsg)->GetPacketDrop();
 
@@ -873,6 +875,7 @@ void CDVDPlayerVideo::ProcessOverlays(DVDVideoPicture* pSource, double pts)
       CDVDCodecUtils::CopyPicture(m_pTempOverlayPicture, pSource);
       memcpy(pSource->data     , m_pTempOverlayPicture->data     , sizeof(pSource->data));
       memcpy(pSource->iLineSize, m_pTempOverlayPicture->iLineSize, sizeof(pSource->iLineSize));
+      pSource->frameRef = NULL;
     }
   }
 
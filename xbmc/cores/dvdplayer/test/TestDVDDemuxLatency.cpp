@@ -0,0 +1,161 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Time from opening a media file given with --add-benchmark-mediafile(s) to
+ * its first packet, with a latency added to every read and seek of the file
+ * as a network share would have. It's measured once with the demuxer
+ * reading through CDVDDemuxReadAhead and once without.
+ */
+
+#include "cores/FFmpeg.h"
+#include "cores/dvdplayer/DVDDemuxers/DVDDemuxFFmpeg.h"
+#include "cores/dvdplayer/DVDDemuxers/DVDDemuxReadAhead.h"
+#include "cores/dvdplayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/dvdplayer/DVDInputStreams/DVDFactoryInputStream.h"
+#include "cores/dvdplayer/DVDInputStreams/DVDInputStream.h"
+#include "settings/AdvancedSettings.h"
+#include "test/TestUtils.h"
+#include "utils/TimeUtils.h"
+#if defined(TARGET_POSIX)
+#include "linux/XTimeUtils.h"
+#endif
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+  /* Passes reads and seeks on to a file after waiting for the given time,
+   * like a network share with that round trip time.
+   */
+  class CLatencyInputStream : public CDVDInputStream
+  {
+  public:
+    CLatencyInputStream(CDVDInputStream *input, unsigned int latency)
+      : CDVDInputStream(DVDSTREAM_TYPE_FILE), m_input(input), m_latency(latency)
+    {
+      m_strFileName = input->GetFileName();
+      m_url = input->GetURL();
+      m_content = input->GetContent();
+    }
+
+    virtual void Close() { m_input->Close(); }
+    virtual bool Pause(double dTime) { return m_input->Pause(dTime); }
+    virtual int64_t GetLength() { return m_input->GetLength(); }
+    virtual bool IsEOF() { return m_input->IsEOF(); }
+
+    virtual int Read(uint8_t *buf, int buf_size)
+    {
+      Sleep(m_latency);
+      return m_input->Read(buf, buf_size);
+    }
+
+    virtual int64_t Seek(int64_t offset, int whence)
+    {
+      if (whence != SEEK_POSSIBLE)
+        Sleep(m_latency);
+      return m_input->Seek(offset, whence);
+    }
+
+  private:
+    CDVDInputStream *m_input;
+    unsigned int m_latency;
+  };
+
+  double Milliseconds(int64_t ticks)
+  {
+    return ticks * 1000.0 / CurrentHostFrequency();
+  }
+}
+
+class TestDVDDemuxLatency : public testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    avcodec_register_all();
+    av_register_all();
+  }
+
+  /* Open the file with the given latency per read and seek and read up to
+   * its first packet, returns the time that took.
+   */
+  double FirstPacket(const std::string &file, unsigned int latency, bool readAhead, CDVDDemuxReadAhead::SStats &stats)
+  {
+    bool oldReadAhead = g_advancedSettings.m_videoDemuxReadAhead;
+    g_advancedSettings.m_videoDemuxReadAhead = readAhead;
+
+    double time = -1.0;
+    CDVDInputStream *fileInput = CDVDFactoryInputStream::CreateInputStream(NULL, file, "");
+    if (fileInput && fileInput->Open(file.c_str(), ""))
+    {
+      CLatencyInputStream input(fileInput, latency);
+      CDVDDemuxFFmpeg demuxer;
+      if (demuxer.Open(&input, true))
+      {
+        DemuxPacket *packet;
+        while ((packet = demuxer.Read()) != NULL && packet->iSize == 0)
+          CDVDDemuxUtils::FreeDemuxPacket(packet);
+        if (packet)
+        {
+          CDVDDemuxUtils::FreeDemuxPacket(packet);
+          time = Milliseconds(demuxer.GetFirstPacketTime());
+        }
+        stats = demuxer.m_readAhead->GetStats();
+      }
+    }
+    delete fileInput;
+
+    g_advancedSettings.m_videoDemuxReadAhead = oldReadAhead;
+    return time;
+  }
+
+  void RunFirstPacket(const std::string &file, unsigned int latency)
+  {
+    CDVDDemuxReadAhead::SStats direct, readAhead;
+    double directTime = FirstPacket(file, latency, false, direct);
+    double readAheadTime = FirstPacket(file, latency, true, readAhead);
+    ASSERT_GE(directTime, 0.0) << "unable to demux " << file;
+    ASSERT_GE(readAheadTime, 0.0) << "unable to demux " << file;
+
+    // the same requests end up as fewer calls into the input stream
+    EXPECT_LE(readAhead.reads + readAhead.seeks, direct.reads + direct.seeks);
+
+    printf("%s, %u ms latency per read and seek\n", file.c_str(), latency);
+    printf("  direct     first packet %8.1f ms, %4u reads %4u seeks, %9" PRId64" bytes\n",
+           directTime, direct.reads, direct.seeks, direct.bytes);
+    printf("  read-ahead first packet %8.1f ms, %4u reads %4u seeks, %9" PRId64" bytes\n",
+           readAheadTime, readAhead.reads, readAhead.seeks, readAhead.bytes);
+    RecordProperty("first_packet_direct_ms", (int)directTime);
+    RecordProperty("first_packet_readahead_ms", (int)readAheadTime);
+    RecordProperty("input_calls_direct", (int)(direct.reads + direct.seeks));
+    RecordProperty("input_calls_readahead", (int)(readAhead.reads + readAhead.seeks));
+  }
+};
+
+TEST_F(TestDVDDemuxLatency, FirstPacketWithLatency)
+{
+  std::vector<std::string> &files = CXBMCTestUtils::Instance().getBenchmarkMediaFiles();
+  for (std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it)
+    RunFirstPacket(*it, 20);
+}
@@ -0,0 +1,237 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/dvdplayer/DVDDemuxers/DVDDemuxReadAhead.h"
+#include "cores/dvdplayer/DVDInputStreams/DVDInputStream.h"
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+  /* A seekable file in memory that counts the calls made to it. */
+  class CTestInputStream : public CDVDInputStream
+  {
+  public:
+    CTestInputStream(int size)
+      : CDVDInputStream(DVDSTREAM_TYPE_FILE), m_reads(0), m_seeks(0), m_pos(0), m_eof(false)
+    {
+      m_data.resize(size);
+      for (int i = 0; i < size; i++)
+        m_data[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+
+    virtual void Close() {}
+    virtual bool Pause(double dTime) { return false; }
+    virtual int64_t GetLength() { return m_data.size(); }
+    virtual bool IsEOF() { return m_eof; }
+
+    virtual int Read(uint8_t *buf, int buf_size)
+    {
+      m_reads++;
+      int len = std::min<int64_t>(buf_size, m_data.size() - m_pos);
+      if (len <= 0)
+      {
+        m_eof = true;
+        return 0;
+      }
+      memcpy(buf, &m_data[m_pos], len);
+      m_pos += len;
+      return len;
+    }
+
+    virtual int64_t Seek(int64_t offset, int whence)
+    {
+      if (whence == SEEK_POSSIBLE)
+        return 1;
+      m_seeks++;
+      if (whence == SEEK_CUR)
+        offset += m_pos;
+      else if (whence == SEEK_END)
+        offset += m_data.size();
+      if (offset < 0 || offset > (int64_t)m_data.size())
+        return -1;
+      m_pos = offset;
+      m_eof = false;
+      return m_pos;
+    }
+
+    std::vector<uint8_t> m_data;
+    unsigned int m_reads;
+    unsigned int m_seeks;
+
+  private:
+    int64_t m_pos;
+    bool m_eof;
+  };
+
+  /* Read size bytes at the current position and check they're the file's. */
+  void ExpectRead(CDVDDemuxReadAhead &reader, CTestInputStream &input, int64_t &pos, int size)
+  {
+    std::vector<uint8_t> buf(size);
+    int ret = reader.Read(&buf[0], size);
+    int64_t left = input.m_data.size() - pos;
+    if (left == 0)
+    {
+      EXPECT_EQ(0, ret);
+      return;
+    }
+    ASSERT_GT(ret, 0);
+    ASSERT_LE(ret, size);
+    ASSERT_LE(ret, left);
+    EXPECT_EQ(0, memcmp(&buf[0], &input.m_data[pos], ret)) << "at " << pos;
+    pos += ret;
+  }
+}
+
+TEST(TestDVDDemuxReadAhead, SameDataAsInput)
+{
+  for (int readAhead = 0; readAhead < 2; readAhead++)
+  {
+    CTestInputStream input(3 * 1024 * 1024 + 123);
+    CDVDDemuxReadAhead reader(&input, readAhead != 0);
+    int64_t length = input.m_data.size();
+    int64_t pos = 0;
+
+    unsigned int random = 12345;
+    for (int i = 0; i < 2000; i++)
+    {
+      random = random * 1103515245 + 12345;
+      unsigned int value = random >> 8;
+      switch (value % 5)
+      {
+      case 0:
+        {
+          int64_t target = value % (length + 2);
+          int64_t expected = target > length ? -1 : target;
+          EXPECT_EQ(expected, reader.Seek(target, SEEK_SET));
+          if (expected >= 0)
+            pos = expected;
+          break;
+        }
+      case 1:
+        {
+          int64_t offset = (int64_t)(value % 200000) - 100000;
+          int64_t expected = (pos + offset < 0 || pos + offset > length) ? -1 : pos + offset;
+          EXPECT_EQ(expected, reader.Seek(offset, SEEK_CUR));
+          if (expected >= 0)
+            pos = expected;
+          break;
+        }
+      case 2:
+        {
+          int64_t offset = -(int64_t)(value % 300000);
+          EXPECT_EQ(length + offset, reader.Seek(offset, SEEK_END));
+          pos = length + offset;
+          break;
+        }
+      default:
+        ExpectRead(reader, input, pos, 1 + value % 70000);
+        break;
+      }
+    }
+  }
+}
+
+TEST(TestDVDDemuxReadAhead, SequentialReadsGrowBlocks)
+{
+  CTestInputStream input(4 * 1024 * 1024);
+  CDVDDemuxReadAhead reader(&input, true);
+
+  int64_t pos = 0;
+  while (pos < (int64_t)input.m_data.size())
+    ExpectRead(reader, input, pos, 32768);
+
+  // 32k, 64k, ... 512k, then 1M blocks
+  EXPECT_LE(input.m_reads, 10U);
+  EXPECT_GE(reader.GetStats().requests, 128U);
+  EXPECT_EQ((int64_t)input.m_data.size(), reader.GetStats().bytes);
+}
+
+TEST(TestDVDDemuxReadAhead, SeekBackIsCached)
+{
+  CTestInputStream input(16 * 1024 * 1024);
+  CDVDDemuxReadAhead reader(&input, true);
+
+  // header, index at the end, back to the start of the data
+  int64_t pos = 0;
+  ExpectRead(reader, input, pos, 4096);
+  pos = input.m_data.size() - 200000;
+  EXPECT_EQ(pos, reader.Seek(pos, SEEK_SET));
+  ExpectRead(reader, input, pos, 8);
+
+  unsigned int reads = input.m_reads;
+  unsigned int seeks = input.m_seeks;
+  pos = 4096;
+  EXPECT_EQ(pos, reader.Seek(pos, SEEK_SET));
+  ExpectRead(reader, input, pos, 1000);
+  EXPECT_EQ(reads, input.m_reads);
+  EXPECT_EQ(seeks, input.m_seeks);
+}
+
+TEST(TestDVDDemuxReadAhead, IndexAtEndReadInOneGo)
+{
+  CTestInputStream input(16 * 1024 * 1024);
+  CDVDDemuxReadAhead reader(&input, true);
+
+  int64_t pos = input.m_data.size() - 500000;
+  EXPECT_EQ(pos, reader.Seek(-500000, SEEK_END));
+  unsigned int reads = input.m_reads;
+  while (pos < (int64_t)input.m_data.size())
+    ExpectRead(reader, input, pos, 4096);
+  EXPECT_EQ(reads + 1, input.m_reads);
+
+  ExpectRead(reader, input, pos, 4096);
+}
+
+TEST(TestDVDDemuxReadAhead, PassThrough)
+{
+  CTestInputStream input(1024 * 1024);
+  CDVDDemuxReadAhead reader(&input, false);
+
+  int64_t pos = 0;
+  for (int i = 0; i < 10; i++)
+    ExpectRead(reader, input, pos, 100);
+  EXPECT_EQ(10U, input.m_reads);
+  EXPECT_EQ(10U, reader.GetStats().reads);
+  EXPECT_EQ(1000, reader.GetStats().bytes);
+}
+
+TEST(TestDVDDemuxReadAhead, PositionAndEOFOfDemuxer)
+{
+  CTestInputStream input(256 * 1024);
+  CDVDDemuxReadAhead reader(&input, true);
+
+  // the last block reaches the end of the input, the demuxer doesn't yet
+  int64_t pos = input.m_data.size() - 100000;
+  EXPECT_EQ(pos, reader.Seek(pos, SEEK_SET));
+  ExpectRead(reader, input, pos, 4096);
+  ExpectRead(reader, input, pos, 4096);
+  EXPECT_EQ(pos, reader.GetPosition());
+  EXPECT_FALSE(reader.IsEOF());
+
+  while (pos < (int64_t)input.m_data.size())
+    ExpectRead(reader, input, pos, 32768);
+  ExpectRead(reader, input, pos, 4096);
+  EXPECT_EQ((int64_t)input.m_data.size(), reader.GetPosition());
+  EXPECT_TRUE(reader.IsEOF());
+}
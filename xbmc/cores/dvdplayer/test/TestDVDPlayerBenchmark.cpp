@@ -0,0 +1,595 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Throughput of the DVDPlayer pipeline without a display or an audio device.
+ *
+ * The media files given with --add-benchmark-mediafile(s) are demuxed and
+ * decoded on their own threads, the same way DVDPlayer, DVDPlayerVideo and
+ * DVDPlayerAudio do it, through CDVDMessageQueue's sized like the player's.
+ * Decoded pictures and samples go to null outputs that either take them as
+ * fast as they come or at the rate the stream would be played at. The null
+ * renderer copies each picture into a render buffer in system memory with
+ * CXBMCRenderManager::CopyPicture, the copy AddVideoPicture makes when the
+ * renderer doesn't take the picture itself.
+ *
+ * Each run prints decoded fps, the average and maximum message queue levels,
+ * the frames the null renderer had to drop for being late, the bytes and time
+ * the copy into the render buffer took per picture and the CPU time used by
+ * each of the threads.
+ */
+
+#include "cores/FFmpeg.h"
+#include "cores/dvdplayer/DVDClock.h"
+#include "cores/dvdplayer/DVDMessageQueue.h"
+#include "cores/dvdplayer/DVDPlayerVideo.h"
+#include "cores/dvdplayer/DVDStreamInfo.h"
+#include "cores/dvdplayer/DVDCodecs/DVDFactoryCodec.h"
+#include "cores/dvdplayer/DVDCodecs/Audio/DVDAudioCodec.h"
+#include "cores/dvdplayer/DVDCodecs/Video/DVDVideoCodec.h"
+#include "cores/dvdplayer/DVDDemuxers/DVDDemux.h"
+#include "cores/dvdplayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/dvdplayer/DVDDemuxers/DVDFactoryDemuxer.h"
+#include "cores/dvdplayer/DVDInputStreams/DVDFactoryInputStream.h"
+#include "cores/dvdplayer/DVDInputStreams/DVDInputStream.h"
+#include "cores/VideoRenderers/RenderFormats.h"
+#include "cores/VideoRenderers/RenderManager.h"
+#include "test/TestUtils.h"
+#include "threads/Thread.h"
+#include "utils/TimeUtils.h"
+#if defined(TARGET_POSIX)
+#include "linux/XTimeUtils.h"
+#endif
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+  /* A stream player that decodes whatever arrives on its message queue
+   * and hands the result to a null output.
+   */
+  class CBenchmarkStream : public CThread
+  {
+  public:
+    CBenchmarkStream(const char *name, bool realtime)
+      : CThread(name),
+        m_messageQueue(name),
+        m_frames(0),
+        m_cpuTime(0),
+        m_realtime(realtime),
+        m_start(DVD_NOPTS_VALUE)
+    {
+      m_messageQueue.Init();
+    }
+
+    virtual ~CBenchmarkStream()
+    {
+      StopThread();
+      m_messageQueue.End();
+    }
+
+    CDVDMessageQueue m_messageQueue;
+    unsigned int m_frames;  ///< pictures or audio frames handed to the output
+    int64_t m_cpuTime;      ///< in 100ns units
+
+  protected:
+    virtual void Process()
+    {
+      while (!m_bStop)
+      {
+        CDVDMsg *msg;
+        MsgQueueReturnCode ret = m_messageQueue.Get(&msg, 1000);
+        if (ret == MSGQ_TIMEOUT)
+          continue;
+        if (MSGQ_IS_ERROR(ret))
+          break;
+
+        bool eof = msg->IsType(CDVDMsg::GENERAL_EOF);
+        if (eof)
+          Drain();
+        else if (msg->IsType(CDVDMsg::DEMUXER_PACKET))
+          Decode(((CDVDMsgDemuxerPacket*)msg)->GetPacket());
+        msg->Release();
+        if (eof)
+          break;
+      }
+      // the usage can't be queried anymore once the thread is gone
+      m_cpuTime = GetAbsoluteUsage();
+    }
+
+    virtual void Decode(DemuxPacket *packet) = 0;
+    virtual void Drain() {}
+
+    /* Wait until something that is played at the given time since the start
+     * is due, returns false if it's already late by more than one frame.
+     */
+    bool WaitForClock(double clock, double frametime)
+    {
+      if (!m_realtime)
+        return true;
+
+      double now = CDVDClock::GetAbsoluteClock();
+      if (m_start == DVD_NOPTS_VALUE)
+        m_start = now;
+
+      double wait = m_start + clock - now;
+      if (wait < -frametime)
+        return false;
+      if (wait > 0)
+        Sleep(DVD_TIME_TO_MSEC(wait));
+      return true;
+    }
+
+  private:
+    bool m_realtime;
+    double m_start;
+  };
+
+  class CBenchmarkVideo : public CBenchmarkStream
+  {
+  public:
+    CBenchmarkVideo(CDVDVideoCodec *codec, double frametime, bool realtime)
+      : CBenchmarkStream("BenchmarkVideo", realtime),
+        m_decoderDrops(0),
+        m_bytesCopied(0),
+        m_copyTime(0),
+        m_frameRefs(0),
+        m_codec(codec),
+        m_frametime(frametime),
+        m_format(RENDER_FMT_NONE)
+    {
+      m_messageQueue.SetMaxDataSize(40 * 1024 * 1024);
+      m_messageQueue.SetMaxTimeSize(8.0);
+      m_droppingStats.Reset();
+      memset(&m_image, 0, sizeof(m_image));
+    }
+
+    virtual ~CBenchmarkVideo()
+    {
+      StopThread();
+      delete m_codec;
+    }
+
+    CDroppingStats m_droppingStats;
+    unsigned int m_decoderDrops;
+    uint64_t m_bytesCopied;   ///< into the render buffer
+    int64_t m_copyTime;       ///< in host counter ticks
+    unsigned int m_frameRefs; ///< pictures a renderer could have taken without the copy
+
+    unsigned int GetImageWidth() const { return m_image.width; }
+    unsigned int GetImageHeight() const { return m_image.height; }
+
+  protected:
+    virtual void Decode(DemuxPacket *packet)
+    {
+      HandleState(m_codec->Decode(packet->pData, packet->iSize, packet->dts, packet->pts));
+    }
+
+    virtual void Drain()
+    {
+      // get the pictures the decoder still holds on to
+      for (int i = 0; i < 32 && !m_bStop; i++)
+      {
+        int state = m_codec->Decode(NULL, 0, DVD_NOPTS_VALUE, DVD_NOPTS_VALUE);
+        if (!(state & VC_PICTURE))
+          break;
+        HandleState(state);
+      }
+    }
+
+  private:
+    void HandleState(int state)
+    {
+      while (!m_bStop)
+      {
+        if (state & VC_ERROR)
+          break;
+
+        if (state & VC_PICTURE)
+        {
+          DVDVideoPicture picture;
+          m_codec->ClearPicture(&picture);
+          if (m_codec->GetPicture(&picture))
+            Output(picture);
+        }
+
+        if (state & VC_BUFFER)
+          break;
+        state = m_codec->Decode(NULL, 0, DVD_NOPTS_VALUE, DVD_NOPTS_VALUE);
+      }
+    }
+
+    // the null renderer
+    void Output(const DVDVideoPicture &picture)
+    {
+      if (picture.iFlags & DVP_FLAG_DROPPED)
+      {
+        m_decoderDrops++;
+        return;
+      }
+
+      if (!WaitForClock((m_frames + m_droppingStats.m_lateFrames) * m_frametime, m_frametime))
+      {
+        m_droppingStats.m_lateFrames++;
+        m_droppingStats.AddOutputDropGain(picture.pts, m_frametime / DVD_TIME_BASE);
+        return;
+      }
+
+      if (picture.frameRef)
+        m_frameRefs++;
+      if (!ConfigureImage(picture))
+        return;
+      DVDVideoPicture pic = picture;
+      int64_t start = CurrentHostCounter();
+      m_bytesCopied += CXBMCRenderManager::CopyPicture(m_image, pic);
+      m_copyTime += CurrentHostCounter() - start;
+      m_frames++;
+    }
+
+    /* A render buffer for the picture's format and size, laid out like the
+     * system memory buffers of CLinuxRendererGL.
+     */
+    bool ConfigureImage(const DVDVideoPicture &picture)
+    {
+      if (picture.format == m_format && picture.iWidth == m_image.width && picture.iHeight == m_image.height)
+        return true;
+
+      memset(&m_image, 0, sizeof(m_image));
+      m_format = picture.format;
+      m_image.width = picture.iWidth;
+      m_image.height = picture.iHeight;
+      m_image.cshift_x = 1;
+      m_image.cshift_y = 1;
+      m_image.bpp = 1;
+      switch (m_format)
+      {
+      case RENDER_FMT_YUV420P10:
+      case RENDER_FMT_YUV420P16:
+        m_image.bpp = 2;
+        // fall through
+      case RENDER_FMT_YUV420P:
+        m_image.stride[0] = m_image.width * m_image.bpp;
+        m_image.stride[1] = (m_image.width >> 1) * m_image.bpp;
+        m_image.stride[2] = (m_image.width >> 1) * m_image.bpp;
+        m_image.planesize[0] = m_image.stride[0] * m_image.height;
+        m_image.planesize[1] = m_image.stride[1] * (m_image.height >> 1);
+        m_image.planesize[2] = m_image.stride[2] * (m_image.height >> 1);
+        break;
+      case RENDER_FMT_NV12:
+        m_image.stride[0] = m_image.width;
+        m_image.stride[1] = m_image.width;
+        m_image.planesize[0] = m_image.stride[0] * m_image.height;
+        m_image.planesize[1] = m_image.stride[1] * (m_image.height >> 1);
+        break;
+      case RENDER_FMT_YUYV422:
+      case RENDER_FMT_UYVY422:
+        m_image.stride[0] = m_image.width * 2;
+        m_image.planesize[0] = m_image.stride[0] * m_image.height;
+        break;
+      default:
+        return false;
+      }
+
+      for (int p = 0; p < MAX_PLANES; p++)
+      {
+        m_planes[p].resize(m_image.planesize[p]);
+        m_image.plane[p] = m_planes[p].empty() ? NULL : &m_planes[p][0];
+      }
+      return true;
+    }
+
+    CDVDVideoCodec *m_codec;
+    double m_frametime;
+    ERenderFormat m_format;
+    YV12Image m_image;
+    std::vector<uint8_t> m_planes[MAX_PLANES];
+  };
+
+  class CBenchmarkAudio : public CBenchmarkStream
+  {
+  public:
+    CBenchmarkAudio(CDVDAudioCodec *codec, bool realtime)
+      : CBenchmarkStream("BenchmarkAudio", realtime), m_codec(codec), m_duration(0.0)
+    {
+      m_messageQueue.SetMaxDataSize(6 * 1024 * 1024);
+      m_messageQueue.SetMaxTimeSize(8.0);
+    }
+
+    virtual ~CBenchmarkAudio()
+    {
+      StopThread();
+      delete m_codec;
+    }
+
+  protected:
+    virtual void Decode(DemuxPacket *packet)
+    {
+      uint8_t *data = packet->pData;
+      int size = packet->iSize;
+      while (size > 0 && !m_bStop)
+      {
+        int len = m_codec->Decode(data, size);
+        if (len < 0 || len > size)
+        {
+          m_codec->Reset();
+          break;
+        }
+        data += len;
+        size -= len;
+
+        DVDAudioFrame frame;
+        m_codec->GetData(frame);
+        if (frame.nb_frames)
+          Output(frame);
+        else if (len == 0)
+          break;
+      }
+    }
+
+  private:
+    // the null sink, consumes samples at the rate they would be played at
+    void Output(const DVDAudioFrame &frame)
+    {
+      WaitForClock(m_duration, frame.duration);
+      m_duration += frame.duration;
+      m_frames += frame.nb_frames;
+    }
+
+    CDVDAudioCodec *m_codec;
+    double m_duration;
+  };
+
+  /* Reads the packets of the file and queues them to the stream players,
+   * waiting for room like DVDPlayer does while keeping track of the queue
+   * levels.
+   */
+  class CBenchmarkDemuxer : public CThread
+  {
+  public:
+    CBenchmarkDemuxer(CDVDDemux *demuxer, int videoId, CBenchmarkStream *video, int audioId, CBenchmarkStream *audio)
+      : CThread("BenchmarkDemuxer"),
+        m_packets(0),
+        m_cpuTime(0),
+        m_demuxer(demuxer),
+        m_videoId(videoId),
+        m_audioId(audioId)
+    {
+      m_players[0] = video;
+      m_players[1] = audio;
+      for (int i = 0; i < 2; i++)
+      {
+        m_levelSum[i] = 0;
+        m_levelMax[i] = 0;
+      }
+    }
+
+    virtual ~CBenchmarkDemuxer()
+    {
+      StopThread();
+    }
+
+    double GetAverageLevel(int player) const
+    {
+      return m_packets ? (double)m_levelSum[player] / m_packets : 0.0;
+    }
+
+    int GetMaxLevel(int player) const
+    {
+      return m_levelMax[player];
+    }
+
+    unsigned int m_packets;
+    int64_t m_cpuTime;
+
+  protected:
+    virtual void Process()
+    {
+      DemuxPacket *packet;
+      while (!m_bStop && (packet = m_demuxer->Read()) != NULL)
+      {
+        CBenchmarkStream *player = NULL;
+        if (m_players[0] && packet->iStreamId == m_videoId)
+          player = m_players[0];
+        else if (m_players[1] && packet->iStreamId == m_audioId)
+          player = m_players[1];
+
+        if (!player)
+        {
+          CDVDDemuxUtils::FreeDemuxPacket(packet);
+          continue;
+        }
+
+        while (!m_bStop && player->m_messageQueue.IsFull())
+          Sleep(1);
+        player->m_messageQueue.Put(new CDVDMsgDemuxerPacket(packet));
+
+        for (int i = 0; i < 2; i++)
+        {
+          int level = m_players[i] ? m_players[i]->m_messageQueue.GetLevel() : 0;
+          m_levelSum[i] += level;
+          m_levelMax[i] = std::max(m_levelMax[i], level);
+        }
+        m_packets++;
+      }
+
+      for (int i = 0; i < 2; i++)
+      {
+        if (m_players[i])
+          m_players[i]->m_messageQueue.Put(new CDVDMsg(CDVDMsg::GENERAL_EOF));
+      }
+      m_cpuTime = GetAbsoluteUsage();
+    }
+
+  private:
+    CDVDDemux *m_demuxer;
+    int m_videoId;
+    int m_audioId;
+    CBenchmarkStream *m_players[2];
+    int64_t m_levelSum[2];
+    int m_levelMax[2];
+  };
+
+  double CpuMilliseconds(int64_t usage)
+  {
+    return usage / 10000.0;
+  }
+}
+
+class TestDVDPlayerBenchmark : public testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    avcodec_register_all();
+    av_register_all();
+  }
+
+  void Run(const std::string &file, bool realtime)
+  {
+    CDVDInputStream *input = CDVDFactoryInputStream::CreateInputStream(NULL, file, "");
+    ASSERT_TRUE(input != NULL) << file;
+    CDVDDemux *demuxer = NULL;
+    if (input->Open(file.c_str(), ""))
+      demuxer = CDVDFactoryDemuxer::CreateDemuxer(input);
+    if (!demuxer)
+    {
+      delete input;
+      FAIL() << "unable to open " << file;
+    }
+
+    CBenchmarkVideo *video = NULL;
+    CBenchmarkAudio *audio = NULL;
+    int videoId = -1;
+    int audioId = -1;
+    for (int i = 0; i < demuxer->GetNrOfStreams(); i++)
+    {
+      CDemuxStream *stream = demuxer->GetStream(i);
+      if (!stream)
+        continue;
+
+      if (stream->type == STREAM_VIDEO && !video)
+      {
+        CDVDStreamInfo hint(*stream, true);
+        // hardware decoders need a display, the benchmark is about the software path
+        hint.software = true;
+
+        // what the GL renderer takes without converting
+        std::vector<ERenderFormat> formats;
+        formats.push_back(RENDER_FMT_YUV420P);
+        formats.push_back(RENDER_FMT_YUV420P10);
+        formats.push_back(RENDER_FMT_YUV420P16);
+        formats.push_back(RENDER_FMT_NV12);
+        formats.push_back(RENDER_FMT_UYVY422);
+        formats.push_back(RENDER_FMT_YUYV422);
+
+        CDVDVideoCodec *codec = CDVDFactoryCodec::CreateVideoCodec(hint, 0, formats);
+        if (!codec)
+          continue;
+
+        double frametime = DVD_TIME_BASE / 25.0;
+        if (hint.fpsrate > 0 && hint.fpsscale > 0)
+          frametime = (double)DVD_TIME_BASE * hint.fpsscale / hint.fpsrate;
+        video = new CBenchmarkVideo(codec, frametime, realtime);
+        videoId = stream->iId;
+      }
+      else if (stream->type == STREAM_AUDIO && !audio)
+      {
+        CDVDStreamInfo hint(*stream, true);
+        CDVDAudioCodec *codec = CDVDFactoryCodec::CreateAudioCodec(hint);
+        if (!codec)
+          continue;
+        audio = new CBenchmarkAudio(codec, realtime);
+        audioId = stream->iId;
+      }
+    }
+    EXPECT_TRUE(video != NULL || audio != NULL);
+
+    CBenchmarkDemuxer reader(demuxer, videoId, video, audioId, audio);
+
+    double start = CDVDClock::GetAbsoluteClock();
+    if (video)
+      video->Create();
+    if (audio)
+      audio->Create();
+    reader.Create();
+
+    reader.WaitForThreadExit(0xFFFFFFFF);
+    if (video)
+      video->WaitForThreadExit(0xFFFFFFFF);
+    if (audio)
+      audio->WaitForThreadExit(0xFFFFFFFF);
+    double seconds = (CDVDClock::GetAbsoluteClock() - start) / DVD_TIME_BASE;
+
+    printf("%s (%s)\n", file.c_str(), realtime ? "real-time" : "as fast as possible");
+    XBMC_RECORD_BENCHMARK("wall_time_s", seconds, "s");
+    XBMC_RECORD_BENCHMARK("demuxer_cpu_ms", CpuMilliseconds(reader.m_cpuTime), "ms");
+    XBMC_RECORD_BENCHMARK("demuxer_packets", reader.m_packets, "");
+    if (video)
+    {
+      double fps = seconds > 0 ? video->m_frames / seconds : 0.0;
+      unsigned int bytesPerFrame = video->m_frames ? (unsigned int)(video->m_bytesCopied / video->m_frames) : 0;
+      double copyPerFrame = video->m_frames ? CXBMCTestUtils::TicksToMilliseconds(video->m_copyTime) / video->m_frames : 0.0;
+      // every picture shown went through the copy, at least its luma plane
+      EXPECT_GT(video->m_frames, 0U);
+      EXPECT_GE(bytesPerFrame, video->GetImageWidth() * video->GetImageHeight());
+      XBMC_RECORD_BENCHMARK("video_fps", fps, "fps");
+      XBMC_RECORD_BENCHMARK("video_cpu_ms", CpuMilliseconds(video->m_cpuTime), "ms");
+      XBMC_RECORD_BENCHMARK("video_queue_avg", reader.GetAverageLevel(0), "%");
+      XBMC_RECORD_BENCHMARK("video_queue_max", reader.GetMaxLevel(0), "%");
+      XBMC_RECORD_BENCHMARK("video_late_frames", video->m_droppingStats.m_lateFrames, "");
+      XBMC_RECORD_BENCHMARK("video_late_ms", video->m_droppingStats.m_totalGain * 1000, "ms");
+      XBMC_RECORD_BENCHMARK("video_decoder_drops", video->m_decoderDrops, "");
+      XBMC_RECORD_BENCHMARK("video_bytes_per_frame", bytesPerFrame, "bytes");
+      XBMC_RECORD_BENCHMARK("video_copy_us_per_frame", copyPerFrame * 1000, "us");
+      XBMC_RECORD_BENCHMARK("video_frame_refs", video->m_frameRefs, "");
+    }
+    if (audio)
+    {
+      XBMC_RECORD_BENCHMARK("audio_frames", audio->m_frames, "");
+      XBMC_RECORD_BENCHMARK("audio_cpu_ms", CpuMilliseconds(audio->m_cpuTime), "ms");
+      XBMC_RECORD_BENCHMARK("audio_queue_avg", reader.GetAverageLevel(1), "%");
+      XBMC_RECORD_BENCHMARK("audio_queue_max", reader.GetMaxLevel(1), "%");
+    }
+
+    delete video;
+    delete audio;
+    delete demuxer;
+    delete input;
+  }
+};
+
+TEST_F(TestDVDPlayerBenchmark, AsFastAsPossible)
+{
+  std::vector<std::string> &files = CXBMCTestUtils::Instance().getBenchmarkMediaFiles();
+  for (std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it)
+    Run(*it, false);
+}
+
+TEST_F(TestDVDPlayerBenchmark, RealTime)
+{
+  std::vector<std::string> &files = CXBMCTestUtils::Instance().getBenchmarkMediaFiles();
+  for (std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it)
+    Run(*it, true);
+}
@@ -106,7 +106,7 @@ void PAPlayer::SoftStart(bool wait/* = false */)
   for(StreamList::iterator itt = m_streams.begin(); itt != m_streams.end(); ++itt)
   {
     StreamInfo* si = *itt;
-    if (si->m_fadeOutTriggered)
+    if (si->m_fadeOutTriggered || !si->m_stream)
       continue;
 
     si->m_stream->Resume();
@@ -127,7 +127,7 @@ void PAPlayer::SoftStart(bool wait/* = false */)
       for(StreamList::iterator itt = m_streams.begin(); itt != m_streams.end(); ++itt)
       {
         StreamInfo* si = *itt;
-        if (si->m_stream->IsFading())
+        if (si->m_stream && si->m_stream->IsFading())
         {
           lock.Leave();
           wait = true;
@@ -193,7 +193,8 @@ void PAPlayer::SoftStop(bool wait/* = false */, bool close/* = true */)
       for(StreamList::iterator itt = m_streams.begin(); itt != m_streams.end(); ++itt)
       {
         StreamInfo* si = *itt;
-        si->m_stream->Pause();
+        if (si->m_stream)
+          si->m_stream->Pause();
       }
     }
   }
@@ -402,6 +403,8 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
   si->m_volume             = (fadeIn && m_upcomingCrossfadeMS) ? 0.0f : 1.0f;
   si->m_fadeOutTriggered   = false;
   si->m_isSlaved           = false;
+  si->m_takeOverStream     = false;
+  si->m_replayGainPending  = false;
 
   int64_t streamTotalTime = si->m_decoder.TotalTime();
   if (si->m_endOffset)
@@ -430,7 +433,18 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
   si->m_playNextTriggered = false;
   si->m_waitOnDrain = false;
 
-  if (!PrepareStream(si))
+  /* for gapless playback of a track with the same format, keep feeding the
+   * current AE stream rather than opening and slaving a second one */
+  if (m_currentStream && m_currentStream->m_stream && !m_currentStream->m_playNextTriggered &&
+      !m_upcomingCrossfadeMS &&
+      m_currentStream->m_dataFormat        == si->m_dataFormat &&
+      m_currentStream->m_sampleRate        == si->m_sampleRate &&
+      m_currentStream->m_encodedSampleRate == si->m_encodedSampleRate &&
+      m_currentStream->m_channelInfo       == si->m_channelInfo)
+  {
+    si->m_takeOverStream = true;
+  }
+  else if (!PrepareStream(si))
   {
     CLog::Log(LOGINFO, "PAPlayer::QueueNextFileEx - Error preparing stream");
     
@@ -617,6 +631,23 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
   for(StreamList::iterator itt = m_streams.begin(); itt != m_streams.end(); ++itt)
   {
     StreamInfo* si = *itt;
+    /* a stream waiting to take over its predecessor decodes ahead into the
+     * decoder's 2 second PCM buffer, so it has data to feed right away */
+    if (si->m_takeOverStream && !si->m_stream)
+    {
+      if (si->m_playNextTriggered)
+      {
+        m_streams.erase(itt);
+        if (si == m_currentStream)
+          m_currentStream = NULL;
+        si->m_decoder.Destroy();
+        delete si;
+        return;
+      }
+      si->m_decoder.ReadSamples(PACKET_SIZE);
+      continue;
+    }
+
     if (!m_currentStream && !si->m_started)
     {
       m_currentStream = si;
@@ -666,7 +697,19 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
 
       /* unregister the audio callback */
       si->m_stream->UnRegisterAudioCallback();
-      si->m_decoder.Destroy();      
+      si->m_decoder.Destroy();
+
+      /* hand the stream over if the next track continues it */
+      if (itt != m_streams.end() && (*itt)->m_takeOverStream && !(*itt)->m_stream && !(*itt)->m_playNextTriggered)
+      {
+        StreamInfo* next = *itt;
+        next->m_stream = si->m_stream;
+        next->m_replayGainPending = true;
+        delete si;
+        CLog::Log(LOGDEBUG, "PAPlayer::ProcessStreams - Stream handed over to the next track");
+        return;
+      }
+
       si->m_stream->Drain(false);
       m_finishing.push_back(si);
       return;
@@ -675,6 +718,15 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
     if (!si->m_started)
       continue;
 
+    /* the replay gain of the stream applies to all data it holds, so it
+     * changes once the previous track's tail has been played */
+    if (si->m_replayGainPending &&
+        (double)si->m_framesSent / si->m_sampleRate >= si->m_stream->GetDelay())
+    {
+      si->m_stream->SetReplayGain(si->m_decoder.GetReplayGain());
+      si->m_replayGainPending = false;
+    }
+
     /* is it time to prepare the next stream? */
     if (si->m_prepareNextAtFrame > 0 && !si->m_prepareTriggered && si->m_framesSent >= si->m_prepareNextAtFrame)
     {
@@ -927,6 +979,9 @@ int64_t PAPlayer::GetTimeInternal()
   double time = ((double)m_currentStream->m_framesSent / (double)m_currentStream->m_sampleRate);
   if (m_currentStream->m_stream)
     time -= m_currentStream->m_stream->GetDelay();
+  /* a stream taken over from the previous track still holds its tail */
+  if (time < 0.0)
+    time = 0.0;
   time = time * 1000.0;
 
   m_playerGUIData.m_time = (int64_t)time; //update for GUI
@@ -120,6 +120,8 @@ private:
 
     bool              m_isSlaved;            /* true if the stream has been slaved to another */
     bool              m_waitOnDrain;         /* wait for stream being drained in AE */
+    bool              m_takeOverStream;      /* continue the previous stream's IAEStream instead of opening one */
+    bool              m_replayGainPending;   /* set the replay gain once the previous stream's data has played */
   } StreamInfo;
 
   typedef std::list<StreamInfo*> StreamList;
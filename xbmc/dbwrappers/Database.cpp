@@ -28,6 +28,7 @@
 #include "utils/SortUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
+#include "utils/Trace.h"
 #include "sqlitedataset.h"
 #include "DatabaseManager.h"
 #include "DbUrl.h"
@@ -208,8 +209,24 @@ bool CDatabase::CommitMultipleExecute()
   return true;
 }
 
+unsigned int CDatabase::GetWriteGeneration(const DatabaseSettings &settings)
+{
+  DatabaseSettings dbSettings = settings;
+  InitSettings(dbSettings);
+
+  std::string dbName = dbSettings.name;
+  dbName += StringUtils::Format("%d", GetSchemaVersion());
+  return dbiplus::Database::getWriteGeneration(GetWriteGenerationKey(dbName, dbSettings));
+}
+
+std::string CDatabase::GetWriteGenerationKey(const std::string &dbName, const DatabaseSettings &dbSettings)
+{
+  return dbSettings.type + "://" + dbSettings.host + ":" + dbSettings.port + "/" + dbName;
+}
+
 bool CDatabase::ExecuteQuery(const std::string &strQuery)
 {
+  TRACE_FUNCTION;
   if (m_multipleExecute)
   {
     m_multipleQueries.push_back(strQuery);
@@ -236,6 +253,7 @@ bool CDatabase::ExecuteQuery(const std::string &strQuery)
 
 bool CDatabase::ResultQuery(const std::string &strQuery)
 {
+  TRACE_FUNCTION;
   bool bReturn = false;
 
   try
@@ -454,6 +472,7 @@ bool CDatabase::Connect(const std::string &dbName, const DatabaseSettings &dbSet
 
   // database name is always required
   m_pDB->setDatabase(dbName.c_str());
+  m_pDB->setWriteGenerationKey(GetWriteGenerationKey(dbName, dbSettings));
 
   // set SSL configuration regardless if any are empty (all empty means no SSL).
   m_pDB->setSSLConfig(dbSettings.key.c_str(), dbSettings.cert.c_str(), dbSettings.ca.c_str(), dbSettings.capath.c_str(), dbSettings.ciphers.c_str());
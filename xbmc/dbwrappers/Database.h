@@ -71,6 +71,18 @@ public:
   void RollbackTransaction();
   bool InTransaction();
 
+  /*!
+   * @brief Get the number of writes done to a database so far, without opening it.
+   * Every connection to the same database shares the counter, so it can be used
+   * to tell whether results read earlier may be stale. Only statements that
+   * change data or schema count, and writes in a transaction count on commit.
+   * Writes made by other processes, such as other clients of a MySQL server,
+   * aren't counted.
+   * @param db the settings the database is opened with.
+   * @return the write generation, 0 if nothing has been written since startup.
+   */
+  unsigned int GetWriteGeneration(const DatabaseSettings &db);
+
   std::string PrepareSQL(std::string strStmt, ...) const;
 
   /*!
@@ -212,6 +224,7 @@ protected:
 
 private:
   void InitSettings(DatabaseSettings &dbSettings);
+  static std::string GetWriteGenerationKey(const std::string &dbName, const DatabaseSettings &dbSettings);
   bool Connect(const std::string &dbName, const DatabaseSettings &db, bool create);
   void UpdateVersionNumber();
 
@@ -27,7 +27,10 @@
  **********************************************************************/
 
 #include "dataset.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #include "utils/log.h"
+#include "utils/StringUtils.h"
 #include <cstring>
 
 #ifndef __GNUC__
@@ -49,12 +52,49 @@ Database::Database():
   sequence_table("db_sequence")
 {
   active = false;	// No connection yet
+  write_pending = false;
 }
 
 Database::~Database() {
   disconnect();		// Disconnect if connected to database
 }
 
+static CCriticalSection s_writeGenerationLock;
+static std::map<std::string, unsigned int> s_writeGenerations;
+
+unsigned int Database::getWriteGeneration(const std::string &key) {
+  CSingleLock lock(s_writeGenerationLock);
+  std::map<std::string, unsigned int>::const_iterator it = s_writeGenerations.find(key);
+  return it != s_writeGenerations.end() ? it->second : 0;
+}
+
+void Database::bumpWriteGeneration() {
+  // writes done in a transaction only become visible on commit
+  if (in_transaction()) {
+    write_pending = true;
+    return;
+  }
+  write_pending = false;
+
+  if (write_generation_key.empty())
+    return;
+  CSingleLock lock(s_writeGenerationLock);
+  s_writeGenerations[write_generation_key]++;
+}
+
+bool Database::isWriteStatement(const std::string &sql) {
+  static const char *writes[] = { "INSERT", "UPDATE", "DELETE", "REPLACE", "CREATE", "DROP", "ALTER" };
+
+  size_t start = sql.find_first_not_of(" \t\r\n(");
+  if (start == std::string::npos)
+    return false;
+  for (unsigned int i = 0; i < sizeof(writes) / sizeof(writes[0]); i++) {
+    if (StringUtils::StartsWithNoCase(sql.c_str() + start, writes[i]))
+      return true;
+  }
+  return false;
+}
+
 int Database::connectFull(const char *newHost, const char *newPort, const char *newDb, const char *newLogin, const char *newPasswd,
                         const char *newKey, const char *newCert, const char *newCA, const char *newCApath, const char *newCiphers) {
   host = newHost;
@@ -68,6 +68,8 @@ class Dataset;		// forward declaration of class Dataset
 class Database  {
 protected:
   bool active;
+  bool write_pending; // writes were done in the current transaction
+  std::string write_generation_key; // name writes are counted under, empty for none
   std::string error, // Error description
     host, port, db, login, passwd, //Login info
     sequence_table, //Sequence table for nextid
@@ -92,6 +94,14 @@ public:
   virtual void setDatabase(const char *newDb) { db = newDb; }
 /* gets a database name */
   const char *getDatabase(void) const { return db.c_str(); }
+/* sets the name writes to this database are counted under */
+  void setWriteGenerationKey(const std::string &key) { write_generation_key = key; }
+/* gets the number of writes counted under the given name so far, across all connections */
+  static unsigned int getWriteGeneration(const std::string &key);
+/* called by datasets after a successful write, counted once the transaction (if any) is committed */
+  void bumpWriteGeneration();
+/* whether a statement may change the data or schema, rather than only read or configure the connection */
+  static bool isWriteStatement(const std::string &sql);
 /* sets a new login to database */
   void setLogin(const char *newLogin) { login = newLogin; }
 /* gets a login */
@@ -455,6 +455,9 @@ void MysqlDatabase::commit_transaction() {
     mysql_commit(conn);
     CLog::Log(LOGDEBUG,"Mysql commit transaction");
     _in_transaction = false;
+    // writes done in the transaction only become visible now
+    if (write_pending)
+      bumpWriteGeneration();
   }
 }
 
@@ -464,6 +467,7 @@ void MysqlDatabase::rollback_transaction() {
     mysql_rollback(conn);
     CLog::Log(LOGDEBUG,"Mysql rollback transaction");
     _in_transaction = false;
+    write_pending = false;
   }
 }
 
@@ -1333,6 +1337,7 @@ void MysqlDataset::make_query(StringList &_sql) {
     } // end of for
 
     if (db->in_transaction() && autocommit) db->commit_transaction();
+    db->bumpWriteGeneration();
 
     active = true;
     ds_state = dsSelect;
@@ -1459,6 +1464,8 @@ int MysqlDataset::exec(const string &sql) {
   }
   else
   {
+    if (Database::isWriteStatement(qry))
+      db->bumpWriteGeneration();
     // TODO: collect results and store in exec_res
     return res;
   }
@@ -402,6 +402,9 @@ void SqliteDatabase::commit_transaction() {
   if (active) {
     sqlite3_exec(conn,"commit",NULL,NULL,NULL);
     _in_transaction = false;
+    // writes done in the transaction only become visible now
+    if (write_pending)
+      bumpWriteGeneration();
   }
 }
 
@@ -409,6 +412,7 @@ void SqliteDatabase::rollback_transaction() {
   if (active) {
     sqlite3_exec(conn,"rollback",NULL,NULL,NULL);
     _in_transaction = false;
+    write_pending = false;
   }  
 }
 
@@ -502,6 +506,7 @@ void SqliteDataset::make_query(StringList &_sql) {
 
 
   if (db->in_transaction() && autocommit) db->commit_transaction();
+  db->bumpWriteGeneration();
 
   active = true;
   ds_state = dsSelect;    
@@ -621,7 +626,11 @@ int SqliteDataset::exec(const string &sql) {
   }
 
   if((res = db->setErr(sqlite3_exec(handle(),qry.c_str(),&callback,&exec_res,&errmsg),qry.c_str())) == SQLITE_OK)
+  {
+    if (Database::isWriteStatement(qry))
+      db->bumpWriteGeneration();
     return res;
+  }
   else
     {
       throw DbErrors(db->getErrorMsg());
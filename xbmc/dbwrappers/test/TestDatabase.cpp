@@ -0,0 +1,127 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "dbwrappers/Database.h"
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+  class CTestDatabase : public CDatabase
+  {
+  public:
+    /* opens the database without going through the database manager */
+    bool Open(const DatabaseSettings &settings) { return Update(settings); }
+
+    void Exec(const std::string &sql) { m_pDS->exec(sql); }
+    void Query(const std::string &sql) { m_pDS->query(sql); m_pDS->close(); }
+
+  protected:
+    virtual void CreateTables() { m_pDS->exec("CREATE TABLE item (idItem integer primary key, name text)\n"); }
+    virtual void CreateAnalytics() {}
+    virtual int GetSchemaVersion() const { return 1; }
+    virtual const char *GetBaseDBName() const { return "TestWriteGeneration"; }
+  };
+
+  class TestDatabase : public testing::Test
+  {
+  protected:
+    TestDatabase()
+    {
+      m_tempFile = XBMC_CREATETEMPFILE("");
+      m_settings.type = "sqlite3";
+      m_settings.host = CXBMCTestUtils::Instance().TempFileDirectory(m_tempFile);
+      m_settings.name = "TestWriteGeneration";
+    }
+
+    ~TestDatabase()
+    {
+      XFILE::CFile::Delete(URIUtils::AddFileToFolder(m_settings.host, "TestWriteGeneration1.db"));
+      XBMC_DELETETEMPFILE(m_tempFile);
+    }
+
+    XFILE::CFile *m_tempFile;
+    DatabaseSettings m_settings;
+  };
+}
+
+TEST_F(TestDatabase, WriteGenerationStableAcrossOpens)
+{
+  CTestDatabase db;
+  ASSERT_TRUE(db.Open(m_settings));
+  db.Close();
+
+  // opening runs PRAGMAs on sqlite, which don't change any data
+  unsigned int generation = db.GetWriteGeneration(m_settings);
+  CTestDatabase other;
+  ASSERT_TRUE(other.Open(m_settings));
+  EXPECT_EQ(generation, other.GetWriteGeneration(m_settings));
+  other.Close();
+  ASSERT_TRUE(db.Open(m_settings));
+  EXPECT_EQ(generation, db.GetWriteGeneration(m_settings));
+
+  db.Query("SELECT * FROM item\n");
+  EXPECT_EQ(generation, db.GetWriteGeneration(m_settings));
+
+  db.Exec("INSERT INTO item (name) VALUES ('one')\n");
+  EXPECT_NE(generation, db.GetWriteGeneration(m_settings));
+  db.Close();
+}
+
+TEST_F(TestDatabase, WriteGenerationOnCommit)
+{
+  CTestDatabase db;
+  ASSERT_TRUE(db.Open(m_settings));
+  unsigned int generation = db.GetWriteGeneration(m_settings);
+
+  // writes only count once they are visible to other connections
+  db.BeginTransaction();
+  db.Exec("UPDATE item SET name='two'\n");
+  EXPECT_EQ(generation, db.GetWriteGeneration(m_settings));
+  db.CommitTransaction();
+  EXPECT_NE(generation, db.GetWriteGeneration(m_settings));
+
+  generation = db.GetWriteGeneration(m_settings);
+  db.BeginTransaction();
+  db.Exec("DELETE FROM item\n");
+  db.RollbackTransaction();
+  db.BeginTransaction();
+  db.CommitTransaction();
+  EXPECT_EQ(generation, db.GetWriteGeneration(m_settings));
+  db.Close();
+}
+
+TEST(TestDatabaseWrites, IsWriteStatement)
+{
+  EXPECT_TRUE(dbiplus::Database::isWriteStatement("INSERT INTO item VALUES (1)"));
+  EXPECT_TRUE(dbiplus::Database::isWriteStatement("  update item set name='a'"));
+  EXPECT_TRUE(dbiplus::Database::isWriteStatement("DELETE FROM item"));
+  EXPECT_TRUE(dbiplus::Database::isWriteStatement("REPLACE INTO item VALUES (1)"));
+  EXPECT_TRUE(dbiplus::Database::isWriteStatement("CREATE INDEX ix ON item (name)"));
+  EXPECT_TRUE(dbiplus::Database::isWriteStatement("DROP TABLE item"));
+  EXPECT_TRUE(dbiplus::Database::isWriteStatement("ALTER TABLE item ADD x integer"));
+  EXPECT_FALSE(dbiplus::Database::isWriteStatement("PRAGMA cache_size=4096\n"));
+  EXPECT_FALSE(dbiplus::Database::isWriteStatement("SELECT * FROM item"));
+  EXPECT_FALSE(dbiplus::Database::isWriteStatement(""));
+}
@@ -215,7 +215,10 @@ bool CDirectory::GetDirectory(const CURL& url, CFileItemList &items, const CHint
 
       // cache the directory, if necessary
       if (!(hints.flags & DIR_FLAG_BYPASS_CACHE))
+      {
+        g_directoryCache.SetListing(realURL.Get(), items);
         g_directoryCache.SetDirectory(realURL.Get(), items, pDirectory->GetCacheType(url));
+      }
     }
 
     // now filter for allowed files
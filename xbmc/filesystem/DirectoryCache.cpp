@@ -21,16 +21,20 @@
 #include "DirectoryCache.h"
 #include "FileItem.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
 #include "climits"
 
 #include <algorithm>
+#include <string.h>
 
 using namespace std;
 using namespace XFILE;
 
+#define STAT_CACHE_EXPIRY        60000 // ms
+
 CDirectoryCache::CDir::CDir(DIR_CACHE_TYPE cacheType)
 {
   m_cacheType = cacheType;
@@ -52,6 +56,8 @@ void CDirectoryCache::CDir::SetLastAccess(unsigned int &accessCounter)
 CDirectoryCache::CDirectoryCache(void)
 {
   m_accessCounter = 0;
+  m_statHits = 0;
+  m_statMisses = 0;
 #ifdef _DEBUG
   m_cacheHits = 0;
   m_cacheMisses = 0;
@@ -133,6 +139,8 @@ void CDirectoryCache::ClearDirectory(const std::string& strPath)
   iCache i = m_cache.find(storedPath);
   if (i != m_cache.end())
     Delete(i);
+
+  ClearStats(storedPath, false);
 }
 
 void CDirectoryCache::ClearSubPaths(const std::string& strPath)
@@ -150,6 +158,8 @@ void CDirectoryCache::ClearSubPaths(const std::string& strPath)
     else
       i++;
   }
+
+  ClearStats(storedPath, true);
 }
 
 void CDirectoryCache::AddFile(const std::string& strFile)
@@ -167,6 +177,8 @@ void CDirectoryCache::AddFile(const std::string& strFile)
     dir->m_Items->Add(item);
     dir->SetLastAccess(m_accessCounter);
   }
+
+  SetExists(strFile, true);
 }
 
 bool CDirectoryCache::FileExists(const std::string& strFile, bool& bInCache)
@@ -204,6 +216,10 @@ void CDirectoryCache::Clear()
   iCache i = m_cache.begin();
   while (i != m_cache.end() )
     Delete(i++);
+
+  m_stats.clear();
+  m_statOrder.clear();
+  m_listings.clear();
 }
 
 void CDirectoryCache::InitCache(set<std::string>& dirs)
@@ -259,6 +275,265 @@ void CDirectoryCache::Delete(iCache it)
   m_cache.erase(it);
 }
 
+void CDirectoryCache::SetListing(const std::string& strPath, const CFileItemList &items)
+{
+  if (!IsStatCacheable(strPath))
+    return;
+
+  CSingleLock lock (m_cs);
+
+  std::string storedPath = strPath;
+  URIUtils::RemoveSlashAtEnd(storedPath);
+  ClearStats(storedPath, false);
+
+  // a listing only tells which files are missing if all items are in the directory itself
+  bool complete = true;
+  unsigned int expires = XbmcThreads::SystemClockMillis() + STAT_CACHE_EXPIRY;
+  for (int i = 0; i < items.Size(); i++)
+  {
+    std::string path = items[i]->GetPath();
+    URIUtils::RemoveSlashAtEnd(path);
+    std::string directory = URIUtils::GetDirectory(path);
+    URIUtils::RemoveSlashAtEnd(directory);
+    if (directory != storedPath)
+    {
+      complete = false;
+      continue;
+    }
+
+    CStatEntry entry;
+    entry.m_exists = true;
+    entry.m_isFolder = items[i]->m_bIsFolder;
+    entry.m_hasStat = false;
+    entry.m_expires = expires;
+    SetStatEntry(path, entry);
+  }
+
+  if (!complete)
+    return;
+
+  if (m_listings.size() >= STAT_CACHE_MAX_LISTINGS)
+  { // drop the listing that expires first
+    map<std::string, unsigned int>::iterator oldest = m_listings.begin();
+    for (map<std::string, unsigned int>::iterator it = m_listings.begin(); it != m_listings.end(); ++it)
+    {
+      if ((int)(it->second - oldest->second) < 0)
+        oldest = it;
+    }
+    m_listings.erase(oldest);
+  }
+  m_listings[storedPath] = expires;
+}
+
+bool CDirectoryCache::HasListing(const std::string& strPath)
+{
+  CSingleLock lock (m_cs);
+  return IsListed(strPath);
+}
+
+bool CDirectoryCache::GetExists(const std::string& strFile, bool& exists)
+{
+  if (!IsStatCacheable(strFile))
+    return false;
+
+  CSingleLock lock (m_cs);
+
+  StatMap::iterator it = FindStatEntry(strFile);
+  if (it != m_stats.end())
+  {
+    // CFile::Exists() on a folder depends on the implementation
+    if (it->second.m_isFolder)
+    {
+      m_statMisses++;
+      return false;
+    }
+    exists = it->second.m_exists;
+    m_statHits++;
+    return true;
+  }
+
+  if (IsListed(URIUtils::GetDirectory(strFile)))
+  {
+    exists = false;
+    m_statHits++;
+    return true;
+  }
+
+  m_statMisses++;
+  return false;
+}
+
+void CDirectoryCache::SetExists(const std::string& strFile, bool exists)
+{
+  if (!IsStatCacheable(strFile))
+    return;
+
+  CSingleLock lock (m_cs);
+
+  StatMap::iterator it = FindStatEntry(strFile);
+  if (it != m_stats.end() && it->second.m_exists == exists && !it->second.m_isFolder)
+    return; // keep what we know
+
+  CStatEntry entry;
+  entry.m_exists = exists;
+  entry.m_isFolder = false;
+  entry.m_hasStat = false;
+  entry.m_expires = XbmcThreads::SystemClockMillis() + STAT_CACHE_EXPIRY;
+  SetStatEntry(strFile, entry);
+}
+
+bool CDirectoryCache::GetStat(const std::string& strFile, struct __stat64* buffer, int& result)
+{
+  if (!IsStatCacheable(strFile))
+    return false;
+
+  CSingleLock lock (m_cs);
+
+  StatMap::iterator it = FindStatEntry(strFile);
+  if (it != m_stats.end() && it->second.m_hasStat)
+  {
+    *buffer = it->second.m_stat;
+    result = it->second.m_exists ? 0 : -1;
+    m_statHits++;
+    return true;
+  }
+
+  if ((it != m_stats.end() && !it->second.m_exists) ||
+      (it == m_stats.end() && IsListed(URIUtils::GetDirectory(strFile))))
+  {
+    memset(buffer, 0, sizeof(struct __stat64));
+    result = -1;
+    m_statHits++;
+    return true;
+  }
+
+  m_statMisses++;
+  return false;
+}
+
+void CDirectoryCache::SetStat(const std::string& strFile, const struct __stat64* buffer, int result)
+{
+  if (!IsStatCacheable(strFile))
+    return;
+
+  CStatEntry entry;
+  entry.m_exists = result == 0;
+  entry.m_isFolder = entry.m_exists && (buffer->st_mode & S_IFMT) == S_IFDIR;
+  entry.m_hasStat = true;
+  if (entry.m_exists)
+    entry.m_stat = *buffer;
+  else
+    memset(&entry.m_stat, 0, sizeof(struct __stat64));
+  entry.m_expires = XbmcThreads::SystemClockMillis() + STAT_CACHE_EXPIRY;
+
+  CSingleLock lock (m_cs);
+  SetStatEntry(strFile, entry);
+}
+
+void CDirectoryCache::GetStatCacheCounts(unsigned int& hits, unsigned int& misses)
+{
+  CSingleLock lock (m_cs);
+  hits = m_statHits;
+  misses = m_statMisses;
+}
+
+bool CDirectoryCache::IsStatCacheable(const std::string& strPath)
+{
+  // only worth it where every stat is a round trip to a server
+  return URIUtils::IsSmb(strPath) || URIUtils::IsNfs(strPath) || URIUtils::IsDAV(strPath) ||
+         URIUtils::IsFTP(strPath) || URIUtils::IsAfp(strPath);
+}
+
+void CDirectoryCache::SetStatEntry(const std::string& strPath, const CStatEntry& entry)
+{
+  std::string storedPath = strPath;
+  URIUtils::RemoveSlashAtEnd(storedPath);
+
+  StatMap::iterator it = m_stats.find(storedPath);
+  if (it != m_stats.end())
+  {
+    std::list<std::string>::iterator order = it->second.m_order;
+    m_statOrder.splice(m_statOrder.end(), m_statOrder, order);
+    it->second = entry;
+    it->second.m_order = order;
+    return;
+  }
+
+  m_statOrder.push_back(storedPath);
+  CStatEntry &stored = m_stats[storedPath];
+  stored = entry;
+  stored.m_order = --m_statOrder.end();
+
+  while (m_stats.size() > STAT_CACHE_MAX_ENTRIES)
+  {
+    // the listing of the directory no longer tells which files are missing
+    std::string directory = URIUtils::GetDirectory(m_statOrder.front());
+    URIUtils::RemoveSlashAtEnd(directory);
+    m_listings.erase(directory);
+
+    m_stats.erase(m_statOrder.front());
+    m_statOrder.pop_front();
+  }
+}
+
+CDirectoryCache::StatMap::iterator CDirectoryCache::FindStatEntry(const std::string& strPath)
+{
+  std::string storedPath = strPath;
+  URIUtils::RemoveSlashAtEnd(storedPath);
+
+  StatMap::iterator it = m_stats.find(storedPath);
+  if (it != m_stats.end() && (int)(it->second.m_expires - XbmcThreads::SystemClockMillis()) <= 0)
+  {
+    m_statOrder.erase(it->second.m_order);
+    m_stats.erase(it);
+    return m_stats.end();
+  }
+  return it;
+}
+
+bool CDirectoryCache::IsListed(const std::string& strDirectory)
+{
+  std::string storedPath = strDirectory;
+  URIUtils::RemoveSlashAtEnd(storedPath);
+
+  map<std::string, unsigned int>::iterator it = m_listings.find(storedPath);
+  if (it == m_listings.end())
+    return false;
+  if ((int)(it->second - XbmcThreads::SystemClockMillis()) <= 0)
+  {
+    m_listings.erase(it);
+    return false;
+  }
+  return true;
+}
+
+void CDirectoryCache::ClearStats(const std::string& strPath, bool subPaths)
+{
+  // the path itself, its listing and the files in it (or everything below it)
+  StatMap::iterator it = m_stats.lower_bound(strPath);
+  while (it != m_stats.end() && StringUtils::StartsWith(it->first, strPath))
+  {
+    std::string directory = URIUtils::GetDirectory(it->first);
+    URIUtils::RemoveSlashAtEnd(directory);
+    if (subPaths || it->first == strPath || directory == strPath)
+    {
+      m_statOrder.erase(it->second.m_order);
+      m_stats.erase(it++);
+    }
+    else
+      ++it;
+  }
+
+  if (subPaths)
+  {
+    map<std::string, unsigned int>::iterator listing = m_listings.lower_bound(strPath);
+    while (listing != m_listings.end() && StringUtils::StartsWith(listing->first, strPath))
+      m_listings.erase(listing++);
+  }
+  else
+    m_listings.erase(strPath);
+}
+
 #ifdef _DEBUG
 void CDirectoryCache::PrintStats() const
 {
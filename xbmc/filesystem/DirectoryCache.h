@@ -22,12 +22,18 @@
 #include "IDirectory.h"
 #include "Directory.h"
 #include "threads/CriticalSection.h"
+#include "PlatformDefs.h" // for __stat64
 
+#include <list>
 #include <map>
 #include <set>
+#include <sys/stat.h>
 
 class CFileItem;
 
+#define STAT_CACHE_MAX_ENTRIES   10000 // files and folders whose stat or exists result is kept
+#define STAT_CACHE_MAX_LISTINGS    500 // directory listings that tell which files are missing
+
 namespace XFILE
 {
   class CDirectoryCache
@@ -57,6 +63,35 @@ namespace XFILE
     void Clear();
     void AddFile(const std::string& strFile);
     bool FileExists(const std::string& strPath, bool& bInCache);
+
+    /*! \brief Remember a listing of a remote directory in the stat cache.
+     Until it expires the listing answers exists queries for the directory's
+     files, and stat queries for files that aren't there.
+     \param strPath the directory that was listed.
+     \param items the full (unfiltered) listing.
+     */
+    void SetListing(const std::string& strPath, const CFileItemList &items);
+
+    /*! \brief Whether an unexpired listing of the directory is in the stat cache */
+    bool HasListing(const std::string& strPath);
+
+    /*! \brief Whether stat and exists results for the path are cached (remote filesystems only) */
+    static bool IsStatCacheable(const std::string& strPath);
+
+    /*! \brief Look up whether a remote file exists in the stat cache.
+     \return true if the answer is cached, it's returned in exists.
+     */
+    bool GetExists(const std::string& strFile, bool& exists);
+    void SetExists(const std::string& strFile, bool exists);
+
+    /*! \brief Look up the stat result of a remote file in the stat cache.
+     \return true if the answer is cached, the result of CFile::Stat() is returned in result.
+     */
+    bool GetStat(const std::string& strFile, struct __stat64* buffer, int& result);
+    void SetStat(const std::string& strFile, const struct __stat64* buffer, int result);
+
+    /*! \brief Number of stat cache lookups answered (each saving a round trip) and not answered */
+    void GetStatCacheCounts(unsigned int& hits, unsigned int& misses);
 #ifdef _DEBUG
     void PrintStats() const;
 #endif
@@ -70,6 +105,29 @@ namespace XFILE
     typedef std::map<std::string, CDir*>::const_iterator ciCache;
     void Delete(iCache i);
 
+    class CStatEntry
+    {
+    public:
+      bool m_exists;
+      bool m_isFolder;
+      bool m_hasStat;
+      struct __stat64 m_stat;
+      unsigned int m_expires;
+      std::list<std::string>::iterator m_order;
+    };
+    typedef std::map<std::string, CStatEntry> StatMap;
+
+    void SetStatEntry(const std::string& strPath, const CStatEntry& entry);
+    StatMap::iterator FindStatEntry(const std::string& strPath);
+    bool IsListed(const std::string& strDirectory);
+    void ClearStats(const std::string& strPath, bool subPaths);
+
+    StatMap m_stats;                          ///< stat and exists results by path (without slash at the end)
+    std::list<std::string> m_statOrder;       ///< paths in m_stats, oldest first
+    std::map<std::string, unsigned int> m_listings; ///< expiry of the directories whose listing is in m_stats
+    unsigned int m_statHits;
+    unsigned int m_statMisses;
+
     CCriticalSection m_cs;
 
     unsigned int m_accessCounter;
@@ -62,6 +62,23 @@ unsigned long ssl_thread_id(void)
 
 using namespace XCURL;
 
+static CCriticalSection g_curlShareLocks[CURL_LOCK_DATA_LAST];
+
+extern "C"
+{
+
+static void curl_share_lock(CURL_HANDLE *handle, curl_lock_data data, curl_lock_access access, void *userptr)
+{
+  g_curlShareLocks[data].lock();
+}
+
+static void curl_share_unlock(CURL_HANDLE *handle, curl_lock_data data, void *userptr)
+{
+  g_curlShareLocks[data].unlock();
+}
+
+}
+
 /* okey this is damn ugly. our dll loader doesn't allow for postload, preunload functions */
 static long g_curlReferences = 0;
 #if(0)
@@ -92,6 +109,18 @@ bool DllLibCurlGlobal::Load()
   /* check idle will clean up the last one */
   g_curlReferences = 2;
 
+  m_share = share_init();
+  if (m_share)
+  {
+    share_setopt(m_share, CURLSHOPT_LOCKFUNC, curl_share_lock);
+    share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, curl_share_unlock);
+    share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+    share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+  }
+
 #if defined(HAS_CURL_STATIC)
   // Initialize ssl locking array
   m_sslLockArray = new CCriticalSection*[CRYPTO_num_locks()];
@@ -113,6 +142,12 @@ void DllLibCurlGlobal::Unload()
     if (!IsLoaded())
       return;
 
+    if (m_share)
+    {
+      share_cleanup(m_share);
+      m_share = NULL;
+    }
+
     // close libcurl
     global_cleanup();
 
@@ -193,8 +228,13 @@ void DllLibCurlGlobal::easy_aquire(const char *protocol, const char *hostname, C
         it->m_busy = true;
         if(easy_handle)
         {
+          /* easy_reset keeps the share, so only a new handle needs it */
           if(!it->m_easy)
+          {
             it->m_easy = easy_init();
+            if(m_share)
+              easy_setopt(it->m_easy, CURLOPT_SHARE, m_share);
+          }
 
           *easy_handle = it->m_easy;
         }
@@ -223,6 +263,8 @@ void DllLibCurlGlobal::easy_aquire(const char *protocol, const char *hostname, C
   if(easy_handle)
   {
     session.m_easy = easy_init();
+    if(m_share)
+      easy_setopt(session.m_easy, CURLOPT_SHARE, m_share);
     *easy_handle = session.m_easy;
   }
 
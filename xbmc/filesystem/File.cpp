@@ -370,13 +370,22 @@ bool CFile::Exists(const CURL& file, bool bUseCache /* = true */)
         return true;
       if (bPathInCache)
         return false;
+
+      bool bExists;
+      if (g_directoryCache.GetExists(url.Get(), bExists))
+        return bExists;
     }
 
     unique_ptr<IFile> pFile(CFileFactory::CreateLoader(url));
     if (!pFile.get())
       return false;
 
-    return pFile->Exists(url);
+    errno = 0;
+    bool bExists = pFile->Exists(url);
+    // a failure could be a server that is down for a moment, only remember a definite no
+    if (bExists || errno == ENOENT)
+      g_directoryCache.SetExists(url.Get(), bExists);
+    return bExists;
   }
   XBMCCOMMONS_HANDLE_UNCHECKED
   catch (CRedirectException *pRedirectEx)
@@ -454,10 +463,23 @@ int CFile::Stat(const CURL& file, struct __stat64* buffer)
 
   try
   {
+    int result;
+    if (g_directoryCache.GetStat(url.Get(), buffer, result))
+    {
+      if (result != 0)
+        errno = ENOENT;
+      return result;
+    }
+
     unique_ptr<IFile> pFile(CFileFactory::CreateLoader(url));
     if (!pFile.get())
       return -1;
-    return pFile->Stat(url, buffer);
+    errno = 0;
+    result = pFile->Stat(url, buffer);
+    // don't remember failures that might be temporary
+    if (result == 0 || errno == ENOENT)
+      g_directoryCache.SetStat(url.Get(), buffer, result);
+    return result;
   }
   XBMCCOMMONS_HANDLE_UNCHECKED
   catch (CRedirectException *pRedirectEx)
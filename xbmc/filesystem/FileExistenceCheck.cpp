@@ -0,0 +1,165 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+
+#include "FileExistenceCheck.h"
+#include "Directory.h"
+#include "File.h"
+#include "FileItem.h"
+#include "threads/SingleLock.h"
+#include "utils/URIUtils.h"
+
+using namespace XFILE;
+
+CFileExistenceCheck::CFileExistenceCheck(unsigned int workers /* = 4 */)
+  : m_workers(workers > 0 ? workers : 1),
+    m_next(0),
+    m_done(0),
+    m_running(0),
+    m_cancelled(false),
+    m_finished(true)
+{
+}
+
+CFileExistenceCheck::~CFileExistenceCheck()
+{
+  Cancel();
+  for (std::vector<CThread*>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+  {
+    (*it)->StopThread(true);
+    delete *it;
+  }
+}
+
+size_t CFileExistenceCheck::Add(const std::string &path)
+{
+  size_t index = m_files.size();
+  m_files.push_back(path);
+  // files that are never checked (cancelled) are assumed to exist
+  m_exists.push_back(1);
+  m_directories[URIUtils::GetDirectory(path)].push_back(index);
+  return index;
+}
+
+void CFileExistenceCheck::Start()
+{
+  CSingleLock lock(m_lock);
+  for (std::map<std::string, std::vector<size_t> >::const_iterator it = m_directories.begin(); it != m_directories.end(); ++it)
+    m_queue.push_back(&it->second);
+
+  if (m_queue.empty())
+  {
+    m_finished.Set();
+    return;
+  }
+
+  unsigned int workers = std::min<size_t>(m_workers, m_queue.size());
+  m_running = workers;
+  for (unsigned int i = 0; i < workers; i++)
+  {
+    CThread *thread = new CThread(this, "FileExistenceCheck");
+    m_threads.push_back(thread);
+    thread->Create();
+  }
+}
+
+bool CFileExistenceCheck::Wait(unsigned int milliseconds)
+{
+  return m_finished.WaitMSec(milliseconds);
+}
+
+void CFileExistenceCheck::Wait()
+{
+  m_finished.Wait();
+}
+
+void CFileExistenceCheck::Cancel()
+{
+  CSingleLock lock(m_lock);
+  m_cancelled = true;
+}
+
+int CFileExistenceCheck::GetProgress()
+{
+  CSingleLock lock(m_lock);
+  if (m_queue.empty())
+    return 100;
+  return (int)(m_done * 100 / m_queue.size());
+}
+
+bool CFileExistenceCheck::Exists(size_t index) const
+{
+  return index < m_exists.size() && m_exists[index] != 0;
+}
+
+void CFileExistenceCheck::Run()
+{
+  while (true)
+  {
+    const std::vector<size_t> *files = NULL;
+    {
+      CSingleLock lock(m_lock);
+      if (m_cancelled || m_next >= m_queue.size())
+        break;
+      files = m_queue[m_next++];
+    }
+
+    CheckDirectory(*files);
+
+    CSingleLock lock(m_lock);
+    m_done++;
+  }
+
+  CSingleLock lock(m_lock);
+  if (--m_running == 0)
+    m_finished.Set();
+}
+
+void CFileExistenceCheck::CheckDirectory(const std::vector<size_t> &files)
+{
+  // a single file is cheaper to check on its own than by listing its directory
+  std::set<std::string> listed;
+  if (files.size() > 1)
+    ListDirectory(URIUtils::GetDirectory(m_files[files[0]]), listed);
+
+  for (std::vector<size_t>::const_iterator it = files.begin(); it != files.end(); ++it)
+  {
+    const std::string &path = m_files[*it];
+    m_exists[*it] = (listed.find(path) != listed.end() || FileExists(path)) ? 1 : 0;
+  }
+}
+
+bool CFileExistenceCheck::ListDirectory(const std::string &directory, std::set<std::string> &listed)
+{
+  CFileItemList items;
+  if (!CDirectory::GetDirectory(directory, items, "",
+                                DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO | DIR_FLAG_GET_HIDDEN | DIR_FLAG_BYPASS_CACHE))
+    return false;
+
+  for (int i = 0; i < items.Size(); i++)
+    listed.insert(items[i]->GetPath());
+  return true;
+}
+
+bool CFileExistenceCheck::FileExists(const std::string &path)
+{
+  return CFile::Exists(path, false);
+}
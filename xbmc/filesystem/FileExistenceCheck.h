@@ -0,0 +1,106 @@
+#pragma once
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+namespace XFILE
+{
+  /*!
+   \brief Checks whether each of a (large) set of files exists.
+
+   Files are grouped by their parent directory and each directory is listed
+   once instead of checking every file on its own, using a few worker threads.
+   Files missing from a listing are checked with CFile::Exists() again, so the
+   result is the same as calling CFile::Exists() on each of them.
+
+   Usage:
+     CFileExistenceCheck check;
+     size_t index = check.Add(path);
+     ...
+     check.Start();
+     while (!check.Wait(100))
+       progress->SetPercentage(check.GetProgress());
+     if (!check.Exists(index))
+       ...
+   */
+  class CFileExistenceCheck : private IRunnable
+  {
+  public:
+    CFileExistenceCheck(unsigned int workers = 4);
+    virtual ~CFileExistenceCheck();
+
+    /*! \brief Add a file to check, must be called before Start().
+     \return the index of the file to pass to Exists().
+     */
+    size_t Add(const std::string &path);
+
+    void Start();
+
+    /*! \brief Wait for all files to be checked.
+     \return true if the check has finished (or was cancelled).
+     */
+    bool Wait(unsigned int milliseconds);
+    void Wait();
+
+    /*! \brief Stop the check, unchecked files are reported as existing.
+     */
+    void Cancel();
+
+    /*! \brief Percentage of directories checked so far.
+     */
+    int GetProgress();
+
+    bool Exists(size_t index) const;
+
+  protected:
+    /*! \brief List a directory, the paths of its files are added to listed.
+     \return true if the directory could be listed.
+     */
+    virtual bool ListDirectory(const std::string &directory, std::set<std::string> &listed);
+    virtual bool FileExists(const std::string &path);
+
+  private:
+    virtual void Run();
+    void CheckDirectory(const std::vector<size_t> &files);
+
+    unsigned int m_workers;
+    std::vector<CThread*> m_threads;
+
+    std::vector<std::string> m_files;
+    std::vector<char> m_exists;
+    std::map<std::string, std::vector<size_t> > m_directories;
+    std::vector<const std::vector<size_t>*> m_queue;
+
+    CCriticalSection m_lock;
+    size_t m_next;
+    size_t m_done;
+    unsigned int m_running;
+    bool m_cancelled;
+    CEvent m_finished;
+  };
+}
@@ -33,6 +33,7 @@
 #include "threads/SystemClock.h"
 
 #include <nfsc/libnfs-raw-mount.h>
+#include <errno.h>
 
 #ifdef TARGET_WINDOWS
 #include <fcntl.h>
@@ -601,6 +602,9 @@ int CNFSFile::Stat(const CURL& url, struct __stat64* buffer)
   NFSSTAT tmpBuffer = {0};
 
   ret = gNfsConnection.GetImpl()->nfs_stat(gNfsConnection.GetNfsContext(), filename.c_str(), &tmpBuffer);
+  // libnfs returns the error instead of setting errno
+  if (ret < 0)
+    errno = -ret;
   
   //if buffer == NULL we where called from Exists - in that case don't spam the log with errors
   if (ret != 0 && buffer != NULL) 
@@ -131,12 +131,15 @@ bool CPluginDirectory::StartScript(const std::string& strPath, bool retrievingDi
   // run the script
   CLog::Log(LOGDEBUG, "%s - calling plugin %s('%s','%s','%s')", __FUNCTION__, m_addon->Name().c_str(), argv[0].c_str(), argv[1].c_str(), argv[2].c_str());
   bool success = false;
+  unsigned int startTime = XbmcThreads::SystemClockMillis();
   std::string file = m_addon->LibPath();
   int id = CScriptInvocationManager::Get().Execute(file, m_addon, argv);
   if (id >= 0)
   { // wait for our script to finish
     std::string scriptName = m_addon->Name();
     success = WaitOnScriptResult(file, id, scriptName, retrievingDir);
+    CLog::Log(LOGDEBUG, "%s - plugin %s returned %s after %u ms", __FUNCTION__, m_addon->Name().c_str(),
+              retrievingDir ? "its listing" : "its result", XbmcThreads::SystemClockMillis() - startTime);
   }
   else
     CLog::Log(LOGERROR, "Unable to run plugin %s", m_addon->Name().c_str());
@@ -198,6 +201,19 @@ bool CPluginDirectory::AddItems(int handle, const CFileItemList *items, int tota
   return !dir->m_cancelled;
 }
 
+bool CPluginDirectory::AppendItems(int handle, CFileItemList &&items, int totalItems)
+{
+  CSingleLock lock(m_handleLock);
+  CPluginDirectory *dir = dirFromHandle(handle);
+  if (!dir)
+    return false;
+
+  dir->m_listItems->Append(std::move(items));
+  dir->m_totalItems = totalItems;
+
+  return !dir->m_cancelled;
+}
+
 void CPluginDirectory::EndOfDirectory(int handle, bool success, bool replaceListing, bool cacheToDisc)
 {
   CSingleLock lock(m_handleLock);
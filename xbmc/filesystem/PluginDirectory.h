@@ -54,6 +54,10 @@ public:
   // callbacks from python
   static bool AddItem(int handle, const CFileItem *item, int totalItems);
   static bool AddItems(int handle, const CFileItemList *items, int totalItems);
+  /*! \brief Add items without copying them like AddItems does.
+   The items are moved into the listing, leaving items empty.
+   */
+  static bool AppendItems(int handle, CFileItemList &&items, int totalItems);
   static void EndOfDirectory(int handle, bool success, bool replaceListing, bool cacheToDisc);
   static void AddSortMethod(int handle, SORT_METHOD sortMethod, const std::string &label2Mask);
   static std::string GetSetting(int handle, const std::string &key);
@@ -18,7 +18,9 @@
  *
  */
 
+#include <map>
 #include <math.h>
+#include <memory>
 
 #include "SmartPlaylistDirectory.h"
 #include "FileItem.h"
@@ -27,7 +29,11 @@
 #include "filesystem/FileDirectoryFactory.h"
 #include "music/MusicDatabase.h"
 #include "playlists/SmartPlayList.h"
+#include "profiles/ProfilesManager.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -39,8 +45,91 @@
 #define PROPERTY_GROUP_BY           "group.by"
 #define PROPERTY_GROUP_MIXED        "group.mixed"
 
+#define MAX_CACHED_PLAYLISTS        32
+
 namespace XFILE
 {
+  /*! \brief Results of smart playlist files, e.g. for home screen widgets.
+   An entry is valid as long as the playlist file, the sort setting and the
+   write generation of the databases it was read from are unchanged.
+   */
+  class CSmartPlaylistResultCache
+  {
+  public:
+    bool Get(const std::string &path, const std::string &stamp, CFileItemList &items)
+    {
+      CSingleLock lock(m_lock);
+      std::map<std::string, Entry>::const_iterator it = m_entries.find(path);
+      if (it == m_entries.end() || it->second.stamp != stamp)
+        return false;
+
+      items.Copy(*it->second.items);
+      return true;
+    }
+
+    void Set(const std::string &path, const std::string &stamp, const CFileItemList &items)
+    {
+      CSingleLock lock(m_lock);
+      if (m_entries.size() >= MAX_CACHED_PLAYLISTS && m_entries.find(path) == m_entries.end())
+        m_entries.clear();
+
+      Entry &entry = m_entries[path];
+      entry.stamp = stamp;
+      entry.items.reset(new CFileItemList);
+      entry.items->Copy(items);
+    }
+
+  private:
+    struct Entry
+    {
+      std::string stamp;
+      std::shared_ptr<CFileItemList> items;
+    };
+
+    CCriticalSection m_lock;
+    std::map<std::string, Entry> m_entries;
+  };
+
+  static CSmartPlaylistResultCache g_smartPlaylistCache;
+
+  // returns an empty stamp if the results can't be cached
+  static std::string GetCacheStamp(const CURL &url, const CSmartPlaylist &playlist)
+  {
+    // a random order is expected to change every time
+    if (playlist.GetOrder() == SortByRandom)
+      return "";
+
+    // the write generations only count the writes of this process, other
+    // clients of a shared library write to it too
+    bool isVideo = playlist.IsVideoType();
+    bool isMusic = playlist.IsMusicType() || playlist.GetType().empty();
+    if ((isVideo && StringUtils::EqualsNoCase(g_advancedSettings.m_databaseVideo.type, "mysql")) ||
+        (isMusic && StringUtils::EqualsNoCase(g_advancedSettings.m_databaseMusic.type, "mysql")))
+      return "";
+
+    struct __stat64 st;
+    if (CFile::Stat(url, &st) != 0)
+      return "";
+
+    std::string stamp = StringUtils::Format("%u:%" PRId64":%" PRId64":%d", CProfilesManager::Get().GetCurrentProfileIndex(),
+                                            (int64_t)st.st_mtime, (int64_t)st.st_size,
+                                            CSettings::Get().GetBool("filelists.ignorethewhensorting") ? 1 : 0);
+
+    // the databases don't need to be opened for this
+    if (isVideo)
+    {
+      CVideoDatabase db;
+      stamp += StringUtils::Format(":v%u", db.GetWriteGeneration(g_advancedSettings.m_databaseVideo));
+    }
+    if (isMusic)
+    {
+      CMusicDatabase db;
+      stamp += StringUtils::Format(":m%u", db.GetWriteGeneration(g_advancedSettings.m_databaseMusic));
+    }
+
+    return stamp;
+  }
+
   CSmartPlaylistDirectory::CSmartPlaylistDirectory()
   {
   }
@@ -55,9 +144,19 @@ namespace XFILE
     CSmartPlaylist playlist;
     if (!playlist.Load(url))
       return false;
+
+    std::string path = url.Get();
+    std::string stamp = GetCacheStamp(url, playlist);
+    if (!stamp.empty() && g_smartPlaylistCache.Get(path, stamp, items))
+      return true;
+
     bool result = GetDirectory(playlist, items);
     if (result)
+    {
       items.SetProperty("library.smartplaylist", true);
+      if (!stamp.empty())
+        g_smartPlaylistCache.Set(path, stamp, items);
+    }
     
     return result;
   }
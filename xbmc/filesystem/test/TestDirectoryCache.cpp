@@ -0,0 +1,108 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filesystem/DirectoryCache.h"
+#include "FileItem.h"
+#include "utils/StringUtils.h"
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+
+TEST(TestDirectoryCache, StatListing)
+{
+  XFILE::CDirectoryCache cache;
+  CFileItemList items;
+  items.Add(CFileItemPtr(new CFileItem("smb://server/share/movie/movie.mkv", false)));
+  items.Add(CFileItemPtr(new CFileItem("smb://server/share/movie/extras/", true)));
+  cache.SetListing("smb://server/share/movie/", items);
+
+  bool exists = false;
+  EXPECT_TRUE(cache.GetExists("smb://server/share/movie/movie.mkv", exists));
+  EXPECT_TRUE(exists);
+  EXPECT_TRUE(cache.GetExists("smb://server/share/movie/poster.jpg", exists));
+  EXPECT_FALSE(exists);
+  EXPECT_FALSE(cache.GetExists("smb://server/share/movie/extras", exists));
+  EXPECT_FALSE(cache.GetExists("smb://server/share/other/poster.jpg", exists));
+
+  struct __stat64 buffer;
+  int result = 0;
+  EXPECT_TRUE(cache.GetStat("smb://server/share/movie/fanart.jpg", &buffer, result));
+  EXPECT_EQ(-1, result);
+  EXPECT_FALSE(cache.GetStat("smb://server/share/movie/movie.mkv", &buffer, result));
+
+  unsigned int hits, misses;
+  cache.GetStatCacheCounts(hits, misses);
+  EXPECT_EQ(3U, hits);
+  EXPECT_EQ(3U, misses);
+
+  cache.ClearDirectory("smb://server/share/movie/");
+  EXPECT_FALSE(cache.GetExists("smb://server/share/movie/movie.mkv", exists));
+  EXPECT_FALSE(cache.GetExists("smb://server/share/movie/poster.jpg", exists));
+}
+
+TEST(TestDirectoryCache, StatResults)
+{
+  XFILE::CDirectoryCache cache;
+  struct __stat64 buffer;
+  memset(&buffer, 0, sizeof(buffer));
+  buffer.st_size = 1234;
+  buffer.st_mode = S_IFREG;
+  cache.SetStat("nfs://server/export/file.mkv", &buffer, 0);
+  cache.SetExists("nfs://server/export/missing.nfo", false);
+
+  int result = -1;
+  memset(&buffer, 0, sizeof(buffer));
+  EXPECT_TRUE(cache.GetStat("nfs://server/export/file.mkv", &buffer, result));
+  EXPECT_EQ(0, result);
+  EXPECT_EQ(1234, buffer.st_size);
+
+  bool exists = true;
+  EXPECT_TRUE(cache.GetExists("nfs://server/export/missing.nfo", exists));
+  EXPECT_FALSE(exists);
+
+  cache.AddFile("nfs://server/export/missing.nfo");
+  EXPECT_TRUE(cache.GetExists("nfs://server/export/missing.nfo", exists));
+  EXPECT_TRUE(exists);
+
+  // local files are never cached
+  cache.SetExists("/tmp/file.mkv", true);
+  EXPECT_FALSE(cache.GetExists("/tmp/file.mkv", exists));
+}
+
+TEST(TestDirectoryCache, StatListingLimit)
+{
+  // the thumb loader lists at most this many art folders ahead
+  XFILE::CDirectoryCache cache;
+  for (int i = 0; i <= STAT_CACHE_MAX_LISTINGS; i++)
+  {
+    CFileItemList items;
+    std::string folder = StringUtils::Format("smb://server/share/movie%d/", i);
+    items.Add(CFileItemPtr(new CFileItem(folder + "movie.mkv", false)));
+    cache.SetListing(folder, items);
+    EXPECT_TRUE(cache.HasListing(folder));
+  }
+
+  // one listing more than the cache holds drops one of the earlier ones
+  unsigned int listed = 0;
+  for (int i = 0; i <= STAT_CACHE_MAX_LISTINGS; i++)
+    listed += cache.HasListing(StringUtils::Format("smb://server/share/movie%d/", i)) ? 1 : 0;
+  EXPECT_EQ((unsigned int)STAT_CACHE_MAX_LISTINGS, listed);
+}
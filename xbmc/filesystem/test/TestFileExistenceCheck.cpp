@@ -0,0 +1,201 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/FileExistenceCheck.h"
+#include "filesystem/SpecialProtocol.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include <stdio.h>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+  /* Counts the round trips made, each of which takes latency ms as on a
+     network share. Files named "missing*" don't exist, all others do. */
+  class CLatencyCheck : public XFILE::CFileExistenceCheck
+  {
+  public:
+    CLatencyCheck(unsigned int latency) : m_latency(latency), m_listings(0), m_exists(0) {}
+
+    size_t AddFile(const std::string &path)
+    {
+      m_added.push_back(path);
+      return Add(path);
+    }
+
+    static bool IsMissing(const std::string &path)
+    {
+      return StringUtils::StartsWith(URIUtils::GetFileName(path), "missing");
+    }
+
+    unsigned int m_latency;
+    unsigned int m_listings;
+    unsigned int m_exists;
+
+  protected:
+    virtual bool ListDirectory(const std::string &directory, std::set<std::string> &listed)
+    {
+      RoundTrip(m_listings);
+      for (std::vector<std::string>::const_iterator it = m_added.begin(); it != m_added.end(); ++it)
+      {
+        if (URIUtils::GetDirectory(*it) == directory && !IsMissing(*it))
+          listed.insert(*it);
+      }
+      return true;
+    }
+
+    virtual bool FileExists(const std::string &path)
+    {
+      RoundTrip(m_exists);
+      return !IsMissing(path);
+    }
+
+  private:
+    void RoundTrip(unsigned int &counter)
+    {
+      {
+        CSingleLock lock(m_countLock);
+        counter++;
+      }
+      if (m_latency)
+        XbmcThreads::ThreadSleep(m_latency);
+    }
+
+    std::vector<std::string> m_added;
+    CCriticalSection m_countLock;
+  };
+}
+
+TEST(TestFileExistenceCheck, LocalFiles)
+{
+  std::string root = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"), "TestFileExistenceCheck");
+  ASSERT_TRUE(XFILE::CDirectory::Create(root));
+
+  std::vector<std::string> created;
+  std::vector<std::string> paths;
+  for (int d = 0; d < 3; d++)
+  {
+    std::string dir = URIUtils::AddFileToFolder(root, StringUtils::Format("dir%d", d));
+    ASSERT_TRUE(XFILE::CDirectory::Create(dir));
+    for (int f = 0; f < 4; f++)
+    {
+      std::string path = URIUtils::AddFileToFolder(dir, StringUtils::Format("file%d.mkv", f));
+      XFILE::CFile file;
+      ASSERT_TRUE(file.OpenForWrite(path, true));
+      file.Close();
+      created.push_back(path);
+      paths.push_back(path);
+    }
+    paths.push_back(URIUtils::AddFileToFolder(dir, "missing.mkv"));
+  }
+  // a file on its own in a directory that doesn't exist
+  paths.push_back(URIUtils::AddFileToFolder(URIUtils::AddFileToFolder(root, "gone"), "file.mkv"));
+
+  XFILE::CFileExistenceCheck check(2);
+  std::vector<size_t> indexes;
+  for (std::vector<std::string>::const_iterator it = paths.begin(); it != paths.end(); ++it)
+    indexes.push_back(check.Add(*it));
+  check.Start();
+  check.Wait();
+  EXPECT_EQ(100, check.GetProgress());
+
+  for (size_t i = 0; i < paths.size(); i++)
+    EXPECT_EQ(XFILE::CFile::Exists(paths[i], false), check.Exists(indexes[i])) << paths[i];
+  EXPECT_FALSE(check.Exists(paths.size()));
+
+  for (std::vector<std::string>::const_iterator it = created.begin(); it != created.end(); ++it)
+    EXPECT_TRUE(XFILE::CFile::Delete(*it));
+  for (int d = 0; d < 3; d++)
+    EXPECT_TRUE(XFILE::CDirectory::Remove(URIUtils::AddFileToFolder(root, StringUtils::Format("dir%d", d))));
+  EXPECT_TRUE(XFILE::CDirectory::Remove(root));
+}
+
+TEST(TestFileExistenceCheck, Empty)
+{
+  XFILE::CFileExistenceCheck check;
+  check.Start();
+  EXPECT_TRUE(check.Wait(0));
+  EXPECT_EQ(100, check.GetProgress());
+}
+
+TEST(TestFileExistenceCheck, RoundTripsWithLatency)
+{
+  // 20 directories of 50 files on a share with 5ms per round trip, 2 files
+  // missing from each directory. Checking each file on its own would be
+  // 1000 round trips one after the other.
+  const unsigned int directories = 20, files = 50, missing = 2, latency = 5;
+
+  CLatencyCheck check(latency);
+  std::vector<size_t> indexes;
+  for (unsigned int d = 0; d < directories; d++)
+  {
+    for (unsigned int f = 0; f < files; f++)
+    {
+      std::string name = StringUtils::Format(f < missing ? "missing%u.mkv" : "file%u.mkv", f);
+      indexes.push_back(check.AddFile(StringUtils::Format("smb://server/share/dir%u/%s", d, name.c_str())));
+    }
+  }
+
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  check.Start();
+  check.Wait();
+  unsigned int elapsed = XbmcThreads::SystemClockMillis() - start;
+
+  for (unsigned int d = 0; d < directories; d++)
+  {
+    for (unsigned int f = 0; f < files; f++)
+      EXPECT_EQ(f >= missing, check.Exists(indexes[d * files + f]));
+  }
+
+  // one listing per directory, and a check of each file not in its listing
+  EXPECT_EQ(directories, check.m_listings);
+  EXPECT_EQ(directories * missing, check.m_exists);
+
+  printf("%u files in %u directories, %ums latency: %u round trips in %ums, "
+         "per file check: %u round trips in %ums\n",
+         directories * files, directories, latency,
+         check.m_listings + check.m_exists, elapsed,
+         directories * files, directories * files * latency);
+}
+
+TEST(TestFileExistenceCheck, Cancel)
+{
+  CLatencyCheck check(20);
+  std::vector<size_t> indexes;
+  for (unsigned int d = 0; d < 50; d++)
+    indexes.push_back(check.AddFile(StringUtils::Format("smb://server/share/dir%u/missing.mkv", d)));
+
+  check.Start();
+  check.Cancel();
+  check.Wait();
+
+  // files that were never checked are reported as existing
+  unsigned int exist = 0;
+  for (std::vector<size_t>::const_iterator it = indexes.begin(); it != indexes.end(); ++it)
+    exist += check.Exists(*it) ? 1 : 0;
+  EXPECT_EQ(indexes.size(), exist + check.m_exists);
+  EXPECT_LT(check.m_exists, indexes.size());
+}
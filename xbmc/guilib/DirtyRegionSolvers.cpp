@@ -21,6 +21,8 @@
 #include "DirtyRegionSolvers.h"
 #include "GraphicContext.h"
 #include <stdio.h>
+#include <string.h>
+#include <algorithm>
 
 void CUnionDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegionList &output)
 {
@@ -81,3 +83,82 @@ void CGreedyDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegion
       output.push_back(currentRegion);
   }
 }
+
+void CGridDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegionList &output)
+{
+  if (input.empty())
+    return;
+
+  const CRect view = g_graphicsContext.GetViewWindow();
+  const float cellWidth = view.Width() / COLUMNS;
+  const float cellHeight = view.Height() / ROWS;
+  if (cellWidth <= 0 || cellHeight <= 0)
+    return;
+
+  for (int y = 0; y < ROWS; y++)
+    for (int x = 0; x < COLUMNS; x++)
+      m_cells[y][x] = CRect();
+
+  for (unsigned int i = 0; i < input.size(); i++)
+  {
+    CRect region(input[i]);
+    region.Intersect(view);
+    if (region.IsEmpty())
+      continue;
+
+    int x1 = std::max(0, std::min(COLUMNS - 1, (int)((region.x1 - view.x1) / cellWidth)));
+    int x2 = std::max(0, std::min(COLUMNS - 1, (int)((region.x2 - view.x1) / cellWidth)));
+    int y1 = std::max(0, std::min(ROWS - 1, (int)((region.y1 - view.y1) / cellHeight)));
+    int y2 = std::max(0, std::min(ROWS - 1, (int)((region.y2 - view.y1) / cellHeight)));
+    for (int y = y1; y <= y2; y++)
+    {
+      for (int x = x1; x <= x2; x++)
+      {
+        CRect cell(view.x1 + x * cellWidth, view.y1 + y * cellHeight,
+                   view.x1 + (x + 1) * cellWidth, view.y1 + (y + 1) * cellHeight);
+        m_cells[y][x].Union(cell.Intersect(region));
+      }
+    }
+  }
+
+  // the runs of the previous row, as first column, last column and index into output
+  int previous[COLUMNS][3], current[COLUMNS][3];
+  int previousRuns = 0;
+  for (int y = 0; y < ROWS; y++)
+  {
+    int currentRuns = 0;
+    for (int x = 0; x < COLUMNS; x++)
+    {
+      if (m_cells[y][x].IsEmpty())
+        continue;
+
+      CRect run(m_cells[y][x]);
+      int first = x;
+      while (x + 1 < COLUMNS && !m_cells[y][x + 1].IsEmpty())
+        run.Union(m_cells[y][++x]);
+
+      int index = -1;
+      for (int i = 0; i < previousRuns; i++)
+      {
+        if (previous[i][0] == first && previous[i][1] == x)
+        {
+          index = previous[i][2];
+          break;
+        }
+      }
+      if (index >= 0)
+        output[index].Union(run);
+      else
+      {
+        index = output.size();
+        output.push_back(CDirtyRegion(run));
+      }
+      current[currentRuns][0] = first;
+      current[currentRuns][1] = x;
+      current[currentRuns][2] = index;
+      currentRuns++;
+    }
+    memcpy(previous, current, currentRuns * sizeof(current[0]));
+    previousRuns = currentRuns;
+  }
+}
@@ -48,3 +48,19 @@ private:
   float m_costNewRegion;
   float m_costPerArea;
 };
+
+/*!
+ \brief Merges dirty regions through a coarse grid over the view window.
+ Every cell keeps the bounds of the dirty area inside it, runs of dirty cells in a row
+ become one region and runs spanning the same columns in consecutive rows are merged.
+ The cost is linear in the number of regions, and far apart regions never end up in
+ one big pass as they do with the union solver.
+ */
+class CGridDirtyRegionSolver : public IDirtyRegionSolver
+{
+public:
+  virtual void Solve(const CDirtyRegionList &input, CDirtyRegionList &output);
+private:
+  enum { COLUMNS = 16, ROWS = 9 };
+  CRect m_cells[ROWS][COLUMNS];
+};
@@ -40,6 +40,10 @@ void CDirtyRegionTracker::SelectAlgorithm()
 
   switch (g_advancedSettings.m_guiAlgorithmDirtyRegions)
   {
+    case DIRTYREGION_SOLVER_GRID:
+      CLog::Log(LOGDEBUG, "guilib: Grid as algorithm for solving rendering passes");
+      m_solver = new CGridDirtyRegionSolver();
+      break;
     case DIRTYREGION_SOLVER_FILL_VIEWPORT_ON_CHANGE:
       CLog::Log(LOGDEBUG, "guilib: Fill viewport on change for solving rendering passes");
       m_solver = new CFillViewportOnChangeRegionSolver();
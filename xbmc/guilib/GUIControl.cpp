@@ -53,6 +53,7 @@ CGUIControl::CGUIControl() :
   m_pushedUpdates = false;
   m_pulseOnSelect = false;
   m_controlIsDirty = true;
+  m_subtreeDirty = true;
 }
 
 CGUIControl::CGUIControl(int parentID, int controlID, float posX, float posY, float width, float height)
@@ -79,6 +80,7 @@ CGUIControl::CGUIControl(int parentID, int controlID, float posX, float posY, fl
   m_pushedUpdates = false;
   m_pulseOnSelect = false;
   m_controlIsDirty = false;
+  m_subtreeDirty = true;
 }
 
 
@@ -131,6 +133,8 @@ void CGUIControl::DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyreg
 
   if (IsVisible())
   {
+    // anything marking us dirty from here on is picked up next frame
+    m_subtreeDirty = false;
     m_cachedTransform = g_graphicsContext.AddTransform(m_transform);
     if (m_hasCamera)
       g_graphicsContext.SetCameraPosition(m_camera);
@@ -166,6 +170,25 @@ void CGUIControl::Process(unsigned int currentTime, CDirtyRegionList &dirtyregio
   m_hasProcessed = true;
 }
 
+bool CGUIControl::CanSkipProcess() const
+{
+  // without animations our transform is the identity, so the cached one is our parent's
+  return !m_subtreeDirty && m_hasProcessed && IsVisible() && IsStatic() &&
+         m_cachedTransform == g_graphicsContext.GetGUIMatrix();
+}
+
+bool CGUIControl::HasStaticProperties() const
+{
+  return !m_visibleCondition && !m_enableCondition && m_animations.empty() &&
+         !m_pulseOnSelect && m_diffuseColor.IsConstant();
+}
+
+void CGUIControl::MarkSubtreeDirty()
+{
+  for (CGUIControl *control = this; control; control = control->m_parentControl)
+    control->m_subtreeDirty = true;
+}
+
 // the main render routine.
 // 1. set the animation transform
 // 2. if visible, paint
@@ -401,6 +424,7 @@ void CGUIControl::SetEnableCondition(const std::string &expression)
     m_enabled = false;
   else
     m_enableCondition = g_infoManager.Register(expression, GetParentID());
+  MarkSubtreeDirty();
 }
 
 void CGUIControl::SetPosition(float posX, float posY)
@@ -421,6 +445,7 @@ bool CGUIControl::SetColorDiffuse(const CGUIInfoColor &color)
 {
   bool changed = m_diffuseColor != color;
   m_diffuseColor = color;
+  MarkSubtreeDirty();
   return changed;
 }
 
@@ -447,6 +472,7 @@ float CGUIControl::GetHeight() const
 void CGUIControl::MarkDirtyRegion()
 {
   m_controlIsDirty = true;
+  MarkSubtreeDirty();
 }
 
 CRect CGUIControl::CalcRenderRegion() const
@@ -640,6 +666,7 @@ void CGUIControl::SetVisibleCondition(const std::string &expression, const std::
   else  // register with the infomanager for updates
     m_visibleCondition = g_infoManager.Register(expression, GetParentID());
   m_allowHiddenFocus.Parse(allowHiddenFocus, GetParentID());
+  MarkSubtreeDirty();
 }
 
 void CGUIControl::SetAnimations(const vector<CAnimation> &animations)
@@ -909,6 +936,7 @@ void CGUIControl::SetCamera(const CPoint &camera)
 {
   m_camera = camera;
   m_hasCamera = true;
+  MarkSubtreeDirty();
 }
 
 CPoint CGUIControl::GetRenderPosition() const
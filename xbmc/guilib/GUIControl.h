@@ -90,6 +90,19 @@ public:
   /*! \brief Returns whether or not we have processed */
   bool HasProcessed() const { return m_hasProcessed; };
 
+  /*! \brief Returns whether the control only changes when it's marked dirty or invalidated
+   Static controls have no conditions, info or animations and nothing that changes on its own,
+   so as long as nothing touches them they look the same as when they were last processed.
+   \sa CanSkipProcess
+   */
+  virtual bool IsStatic() const { return false; };
+
+  /*! \brief Returns whether processing the control (and any children) may be skipped this frame
+   True for visible static controls that haven't been touched since they were last processed,
+   with the same transform as now.
+   */
+  bool CanSkipProcess() const;
+
   // OnAction() is called by our window when we are the focused control.
   // We should process any control-specific actions in the derived classes,
   // and return true if we have taken care of the action.  Returning false
@@ -216,8 +229,8 @@ public:
   virtual void UpdateVisibility(const CGUIListItem *item = NULL);
   virtual void SetInitialVisibility();
   virtual void SetEnabled(bool bEnable);
-  virtual void SetInvalid() { m_bInvalidated = true; };
-  virtual void SetPulseOnSelect(bool pulse) { m_pulseOnSelect = pulse; };
+  virtual void SetInvalid() { m_bInvalidated = true; MarkSubtreeDirty(); };
+  virtual void SetPulseOnSelect(bool pulse) { m_pulseOnSelect = pulse; MarkSubtreeDirty(); };
   virtual std::string GetDescription() const { return ""; };
   virtual std::string GetDescriptionByIndex(int index) const { return ""; };
 
@@ -317,6 +330,17 @@ protected:
   void UpdateStates(ANIMATION_TYPE type, ANIMATION_PROCESS currentProcess, ANIMATION_STATE currentState);
   bool SendWindowMessage(CGUIMessage &message) const;
 
+  /*! \brief Returns whether the properties CGUIControl handles are static
+   \sa IsStatic
+   */
+  bool HasStaticProperties() const;
+
+  /*! \brief Make sure this control and its parents are processed in the next frame
+   Needed whenever a static control is changed by anything other than its Process()
+   \sa IsStatic
+   */
+  void MarkSubtreeDirty();
+
   // navigation and actions
   ActionMap m_actions;
 
@@ -357,6 +381,7 @@ protected:
   TransformMatrix m_cachedTransform; // Contains the absolute transform the control
 
   bool  m_controlIsDirty;
+  bool  m_subtreeDirty;         // this control or one of its children changed since it was last processed
   CRect m_renderRegion;         // In screen coordinates
 };
 
@@ -21,7 +21,9 @@
 #include "GUIControlGroup.h"
 #include "GUIControlProfiler.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 
 using namespace std;
 
@@ -31,6 +33,7 @@ CGUIControlGroup::CGUIControlGroup()
   m_defaultAlways = false;
   m_focusedControl = 0;
   m_renderFocusedLast = false;
+  m_static = false;
   ControlType = GUICONTROL_GROUP;
 }
 
@@ -41,6 +44,7 @@ CGUIControlGroup::CGUIControlGroup(int parentID, int controlID, float posX, floa
   m_defaultAlways = false;
   m_focusedControl = 0;
   m_renderFocusedLast = false;
+  m_static = false;
   ControlType = GUICONTROL_GROUP;
 }
 
@@ -57,6 +61,7 @@ CGUIControlGroup::CGUIControlGroup(const CGUIControlGroup &from)
 
   // defaults
   m_focusedControl = 0;
+  m_static = false;
   ControlType = GUICONTROL_GROUP;
 }
 
@@ -101,19 +106,27 @@ void CGUIControlGroup::Process(unsigned int currentTime, CDirtyRegionList &dirty
   g_graphicsContext.SetOrigin(pos.x, pos.y);
 
   CRect rect;
+  bool isStatic = HasStaticProperties();
   for (iControls it = m_children.begin(); it != m_children.end(); ++it)
   {
     CGUIControl *control = *it;
+    if (control->CanSkipProcess())
+    { // untouched since the last frame, so neither visibility nor anything else can have changed
+      rect.Union(control->GetRenderRegion());
+      continue;
+    }
     control->UpdateVisibility();
     unsigned int oldDirty = dirtyregions.size();
     control->DoProcess(currentTime, dirtyregions);
     if (control->IsVisible() || (oldDirty != dirtyregions.size())) // visible or dirty (was visible?)
       rect.Union(control->GetRenderRegion());
+    isStatic &= control->IsStatic();
   }
 
   g_graphicsContext.RestoreOrigin();
   CGUIControl::Process(currentTime, dirtyregions);
   m_renderRegion = rect;
+  m_static = isStatic;
 }
 
 void CGUIControlGroup::Render()
@@ -443,40 +456,37 @@ bool CGUIControlGroup::HasVisibleID(int id) const
   return false;
 }
 
-CGUIControl *CGUIControlGroup::GetControl(int iControl)
+namespace
 {
-  CGUIControl *pPotential = NULL;
-  LookupMap::iterator first = m_lookup.find(iControl);
-  if (first != m_lookup.end())
+  struct LookupCompare
   {
-    LookupMap::iterator last = m_lookup.upper_bound(iControl);
-    for (LookupMap::iterator i = first; i != last; ++i)
-    {
-      CGUIControl *control = i->second;
-      if (control->IsVisible())
-        return control;
-      else if (!pPotential)
-        pPotential = control;
-    }
-  }
-  return pPotential;
+    bool operator()(const std::pair<int, CGUIControl *> &left, int right) const { return left.first < right; }
+    bool operator()(int left, const std::pair<int, CGUIControl *> &right) const { return left < right.first; }
+    bool operator()(const std::pair<int, CGUIControl *> &left, const std::pair<int, CGUIControl *> &right) const { return left.first < right.first; }
+  };
+}
+
+pair<CGUIControlGroup::LookupMap::const_iterator, CGUIControlGroup::LookupMap::const_iterator> CGUIControlGroup::FindLookup(const LookupMap &map, int id)
+{
+  return equal_range(map.begin(), map.end(), id, LookupCompare());
+}
+
+CGUIControl *CGUIControlGroup::GetControl(int iControl)
+{
+  return const_cast<CGUIControl *>(static_cast<const CGUIControlGroup *>(this)->GetControl(iControl));
 }
 
 const CGUIControl* CGUIControlGroup::GetControl(int iControl) const
 {
   const CGUIControl *pPotential = NULL;
-  LookupMap::const_iterator first = m_lookup.find(iControl);
-  if (first != m_lookup.end())
+  pair<LookupMap::const_iterator, LookupMap::const_iterator> range = FindLookup(m_lookup, iControl);
+  for (LookupMap::const_iterator i = range.first; i != range.second; ++i)
   {
-    LookupMap::const_iterator last = m_lookup.upper_bound(iControl);
-    for (LookupMap::const_iterator i = first; i != last; ++i)
-    {
-      const CGUIControl *control = i->second;
-      if (control->IsVisible())
-        return control;
-      else if (!pPotential)
-        pPotential = control;
-    }
+    const CGUIControl *control = i->second;
+    if (control->IsVisible())
+      return control;
+    else if (!pPotential)
+      pPotential = control;
   }
   return pPotential;
 }
@@ -495,7 +505,7 @@ CGUIControl *CGUIControlGroup::GetFocusedControl() const
   if (m_focusedControl)
   {
     // we may have multiple controls with same id - we pick first that has focus
-    pair<LookupMap::const_iterator, LookupMap::const_iterator> range = m_lookup.equal_range(m_focusedControl);
+    pair<LookupMap::const_iterator, LookupMap::const_iterator> range = FindLookup(m_lookup, m_focusedControl);
     for (LookupMap::const_iterator i = range.first; i != range.second; ++i)
     {
       if (i->second->HasFocus())
@@ -558,12 +568,15 @@ void CGUIControlGroup::AddLookup(CGUIControl *control)
 {
   if (control->IsGroup())
   { // first add all the subitems of this group (if they exist)
-    const LookupMap map = ((CGUIControlGroup *)control)->GetLookup();
-    for (LookupMap::const_iterator i = map.begin(); i != map.end(); ++i)
-      m_lookup.insert(m_lookup.upper_bound(i->first), make_pair(i->first, i->second));
+    // merge keeps ours first for equal ids, as inserting each at its upper bound would
+    const LookupMap &map = ((CGUIControlGroup *)control)->GetLookup();
+    LookupMap merged;
+    merged.reserve(m_lookup.size() + map.size());
+    merge(m_lookup.begin(), m_lookup.end(), map.begin(), map.end(), back_inserter(merged), LookupCompare());
+    m_lookup.swap(merged);
   }
   if (control->GetID())
-    m_lookup.insert(m_lookup.upper_bound(control->GetID()), make_pair(control->GetID(), control));
+    m_lookup.insert(upper_bound(m_lookup.begin(), m_lookup.end(), control->GetID(), LookupCompare()), make_pair(control->GetID(), control));
   // ensure that our size is what it should be
   if (m_parentControl)
     ((CGUIControlGroup *)m_parentControl)->AddLookup(control);
@@ -83,6 +83,7 @@ public:
   virtual void SaveStates(std::vector<CControlState> &states);
 
   virtual bool IsGroup() const { return true; };
+  virtual bool IsStatic() const { return m_static; };
 
 #ifdef _DEBUG
   virtual void DumpTextureUse();
@@ -104,8 +105,9 @@ protected:
   typedef std::vector<CGUIControl *>::reverse_iterator rControls;
   typedef std::vector<CGUIControl *>::const_reverse_iterator crControls;
 
-  // fast lookup by id
-  typedef std::multimap<int, CGUIControl *> LookupMap;
+  // fast lookup by id - a flat multimap, sorted by id and then in order of insertion
+  typedef std::vector< std::pair<int, CGUIControl *> > LookupMap;
+  static std::pair<LookupMap::const_iterator, LookupMap::const_iterator> FindLookup(const LookupMap &map, int id);
   void AddLookup(CGUIControl *control);
   void RemoveLookup(CGUIControl *control);
   const LookupMap &GetLookup() const { return m_lookup; };
@@ -115,5 +117,6 @@ protected:
   bool m_defaultAlways;
   int m_focusedControl;
   bool m_renderFocusedLast;
+  bool m_static;             ///< all children were static when last processed \sa CGUIControl::IsStatic
 };
 
@@ -29,8 +29,12 @@
 #include "windowing/WindowingFactory.h"
 #include "URL.h"
 #include "filesystem/File.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
+#include "utils/auto_buffer.h"
 
+#include <algorithm>
+#include <map>
 #include <math.h>
 #include <memory>
 
@@ -40,6 +44,7 @@
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_STROKER_H
+#include FT_SIZES_H
 
 #define USE_RELEASE_LIBS
 
@@ -64,12 +69,23 @@ public:
 
   virtual ~CFreeTypeLibrary()
   {
+    for (FaceMap::iterator it = m_faces.begin(); it != m_faces.end(); ++it)
+    {
+      FT_Done_Face(it->second->face);
+      delete it->second;
+    }
     if (m_library)
       FT_Done_FreeType(m_library);
   }
 
-  FT_Face GetFont(const std::string &filename, float size, float aspect, XUTILS::auto_buffer& memoryBuf)
+  /*! \brief Get a face of the given font file, set to the given size.
+   Faces are shared by all sizes of a font file, each size having its own FT_Size.
+   The size is active when this returns, and needs activating again before
+   the face is used after any other size of it might have been.
+   */
+  FT_Face GetFont(const std::string &filename, float size, float aspect, FT_Size &faceSize)
   {
+    CSingleLock lock(m_section);
     // don't have it yet - create it
     if (!m_library)
       FT_Init_FreeType(&m_library);
@@ -79,31 +95,17 @@ public:
       return NULL;
     }
 
-    FT_Face face;
-
-    // ok, now load the font face
-    CURL realFile(CSpecialProtocol::TranslatePath(filename));
-    if (realFile.GetFileName().empty())
+    SharedFace *shared = GetFace(filename);
+    if (!shared)
       return NULL;
 
-    memoryBuf.clear();
-#ifndef TARGET_WINDOWS
-    if (!realFile.GetProtocol().empty())
-#endif // ! TARGET_WINDOWS
+    FT_Face face = shared->face;
+    if (FT_New_Size(face, &faceSize))
     {
-      // load file into memory if it is not on local drive
-      // in case of win32: always load file into memory as filename is in UTF-8,
-      //                   but freetype expect filename in ANSI encoding
-      XFILE::CFile f;
-      if (f.LoadFile(realFile, memoryBuf) <= 0)
-        return NULL;
-      if (FT_New_Memory_Face(m_library, (const FT_Byte*)memoryBuf.get(), memoryBuf.size(), 0, &face) != 0)
-        return NULL;
-    }
-#ifndef TARGET_WINDOWS
-    else if (FT_New_Face( m_library, realFile.GetFileName().c_str(), 0, &face ))
+      ReleaseFace(face);
       return NULL;
-#endif // ! TARGET_WINDOWS
+    }
+    FT_Activate_Size(faceSize);
 
     unsigned int ydpi = 72; // 72 points to the inch is the freetype default
     unsigned int xdpi = (unsigned int)MathUtils::round_int(ydpi * aspect);
@@ -114,7 +116,8 @@ public:
     // scaling to pixel ratio on screen perhaps?
     if (FT_Set_Char_Size( face, 0, (int)(size*64 + 0.5f), xdpi, ydpi ))
     {
-      FT_Done_Face(face);
+      FT_Done_Size(faceSize);
+      ReleaseFace(face);
       return NULL;
     }
 
@@ -133,10 +136,12 @@ public:
     return stroker;
   };
 
-  static void ReleaseFont(FT_Face face)
+  void ReleaseFont(FT_Face face, FT_Size faceSize)
   {
     assert(face);
-    FT_Done_Face(face);
+    CSingleLock lock(m_section);
+    FT_Done_Size(faceSize);
+    ReleaseFace(face);
   };
   
   static void ReleaseStroker(FT_Stroker stroker)
@@ -146,7 +151,72 @@ public:
   }
 
 private:
+  struct SharedFace
+  {
+    FT_Face face;
+    XUTILS::auto_buffer memory; // used only in some cases, see GetFace()
+    unsigned int references;
+  };
+  typedef std::map<std::string, SharedFace*> FaceMap;
+
+  SharedFace *GetFace(const std::string &filename)
+  {
+    FaceMap::iterator it = m_faces.find(filename);
+    if (it != m_faces.end())
+    {
+      it->second->references++;
+      return it->second;
+    }
+
+    // ok, now load the font face
+    CURL realFile(CSpecialProtocol::TranslatePath(filename));
+    if (realFile.GetFileName().empty())
+      return NULL;
+
+    std::unique_ptr<SharedFace> shared(new SharedFace);
+#ifndef TARGET_WINDOWS
+    if (!realFile.GetProtocol().empty())
+#endif // ! TARGET_WINDOWS
+    {
+      // load file into memory if it is not on local drive
+      // in case of win32: always load file into memory as filename is in UTF-8,
+      //                   but freetype expect filename in ANSI encoding
+      XFILE::CFile f;
+      if (f.LoadFile(realFile, shared->memory) <= 0)
+        return NULL;
+      if (FT_New_Memory_Face(m_library, (const FT_Byte*)shared->memory.get(), shared->memory.size(), 0, &shared->face) != 0)
+        return NULL;
+    }
+#ifndef TARGET_WINDOWS
+    else if (FT_New_Face( m_library, realFile.GetFileName().c_str(), 0, &shared->face ))
+      return NULL;
+#endif // ! TARGET_WINDOWS
+
+    shared->references = 1;
+    m_faces[filename] = shared.get();
+    return shared.release();
+  }
+
+  void ReleaseFace(FT_Face face)
+  {
+    for (FaceMap::iterator it = m_faces.begin(); it != m_faces.end(); ++it)
+    {
+      if (it->second->face == face)
+      {
+        if (--it->second->references == 0)
+        {
+          FT_Done_Face(face);
+          delete it->second;
+          m_faces.erase(it);
+        }
+        return;
+      }
+    }
+  }
+
   FT_Library   m_library;
+  FaceMap      m_faces;
+  CCriticalSection m_section;
 };
 
 XBMC_GLOBAL_REF(CFreeTypeLibrary, g_freeTypeLibrary); // our freetype library
@@ -162,6 +232,7 @@ CGUIFontTTFBase::CGUIFontTTFBase(const std::string& strFileName) : m_staticCache
   m_vertex.reserve(4*1024);
 
   m_face = NULL;
+  m_faceSize = NULL;
   m_stroker = NULL;
   memset(m_charquick, 0, sizeof(m_charquick));
   m_strFileName = strFileName;
@@ -228,8 +299,9 @@ void CGUIFontTTFBase::Clear()
   m_nestedBeginCount = 0;
 
   if (m_face)
-    g_freeTypeLibrary.ReleaseFont(m_face);
+    g_freeTypeLibrary.ReleaseFont(m_face, m_faceSize);
   m_face = NULL;
+  m_faceSize = NULL;
   if (m_stroker)
     g_freeTypeLibrary.ReleaseStroker(m_stroker);
   m_stroker = NULL;
@@ -238,14 +310,13 @@ void CGUIFontTTFBase::Clear()
   m_vertex.clear();
 
   m_strFileName.clear();
-  m_fontFileInMemory.clear();
 }
 
 bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float aspect, float lineSpacing, bool border)
 {
   // we now know that this object is unique - only the GUIFont objects are non-unique, so no need
   // for reference tracking these fonts
-  m_face = g_freeTypeLibrary.GetFont(strFilename, height, aspect, m_fontFileInMemory);
+  m_face = g_freeTypeLibrary.GetFont(strFilename, height, aspect, m_faceSize);
 
   if (!m_face)
     return false;
@@ -277,7 +348,7 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
      add on the strength of any border - the non-bordered font needs
      aligning with the bordered font by utilising GetTextBaseLine()
      */
-    FT_Pos strength = FT_MulFix( m_face->units_per_EM, m_face->size->metrics.y_scale) / 12;
+    FT_Pos strength = FT_MulFix( m_face->units_per_EM, m_faceSize->metrics.y_scale) / 12;
     if (strength < 128)
       strength = 128;
 
@@ -386,6 +457,9 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const vecColors &colors
                            dirtyCache));
   if (dirtyCache)
   {
+    // cache all of the text's characters in one go, rather than one at a time below
+    CacheCharacters(text.begin(), text.end());
+
     // save the origin, which is scaled separately
     m_originX = x;
     m_originY = y;
@@ -529,7 +603,14 @@ float CGUIFontTTFBase::GetTextWidthInternal(vecText::const_iterator start, vecTe
   float width = 0;
   while (start != end)
   {
-    Character *c = GetCharacter(*start++);
+    Character *c = FindCharacter(*start);
+    if (!c && (*start & 0xffff) != L'\r')
+    {
+      // cache the rest of the line in one go on the first miss
+      CacheCharacters(start, end);
+      c = FindCharacter(*start);
+    }
+    ++start;
     if (c)
     {
       // If last character in line, we want to add render width
@@ -558,8 +639,8 @@ float CGUIFontTTFBase::GetTextHeight(float lineSpacing, int numLines) const
 
 float CGUIFontTTFBase::GetLineHeight(float lineSpacing) const
 {
-  if (m_face)
-    return lineSpacing * m_face->size->metrics.height / 64.0f;
+  if (m_faceSize)
+    return lineSpacing * m_faceSize->metrics.height / 64.0f;
   return 0.0f;
 }
 
@@ -573,12 +654,25 @@ unsigned int CGUIFontTTFBase::GetTextureLineHeight() const
 CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
 {
   wchar_t letter = (wchar_t)(chr & 0xffff);
-  character_t style = (chr & 0x3000000) >> 24;
 
   // ignore linebreaks
   if (letter == L'\r')
     return NULL;
 
+  Character *ch = FindCharacter(chr);
+  if (ch)
+    return ch;
+
+  vecText text(1, chr);
+  CacheCharacters(text.begin(), text.end());
+  return FindCharacter(chr);
+}
+
+CGUIFontTTFBase::Character* CGUIFontTTFBase::FindCharacter(character_t chr)
+{
+  wchar_t letter = (wchar_t)(chr & 0xffff);
+  character_t style = (chr & 0x3000000) >> 24;
+
   // quick access to ascii chars
   if (letter < 255)
   {
@@ -602,44 +696,52 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
     else
       return &m_char[mid];
   }
-  // if we get to here, then low is where we should insert the new character
-
-  // increase the size of the buffer if we need it
-  if (m_numChars >= m_maxChars)
-  { // need to increase the size of the buffer
-    Character *newTable = new Character[m_maxChars + CHAR_CHUNK];
-    if (m_char)
-    {
-      memcpy(newTable, m_char, low * sizeof(Character));
-      memcpy(newTable + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
-      delete[] m_char;
-    }
-    m_char = newTable;
-    m_maxChars += CHAR_CHUNK;
+  return NULL;
+}
 
+void CGUIFontTTFBase::CacheCharacters(vecText::const_iterator start, vecText::const_iterator end)
+{
+  // collect everything we don't have yet, stored based on style and letter
+  std::vector<character_t> missing;
+  for (vecText::const_iterator it = start; it != end; ++it)
+  {
+    wchar_t letter = (wchar_t)(*it & 0xffff);
+    if (letter != L'\r' && !FindCharacter(*it))
+      missing.push_back((((*it & 0x3000000) >> 24) << 16) | letter);
   }
-  else
-  { // just move the data along as necessary
-    memmove(m_char + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
-  }
-  // render the character to our texture
+  if (missing.empty())
+    return;
+
+  std::sort(missing.begin(), missing.end());
+  missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+
+  unsigned int startTime = XbmcThreads::SystemClockMillis();
+
+  // render the characters to our texture
   // must End() as we can't render text to our texture during a Begin(), End() block
   unsigned int nestedBeginCount = m_nestedBeginCount;
   m_nestedBeginCount = 1;
   if (nestedBeginCount) End();
-  if (!CacheCharacter(letter, style, m_char + low))
-  { // unable to cache character - try clearing them all out and starting over
-    CLog::Log(LOGDEBUG, "%s: Unable to cache character.  Clearing character cache of %i characters", __FUNCTION__, m_numChars);
-    ClearCharacterCache();
-    low = 0;
-    if (!CacheCharacter(letter, style, m_char + low))
-    {
-      CLog::Log(LOGERROR, "%s: Unable to cache character (out of memory?)", __FUNCTION__);
-      if (nestedBeginCount) Begin();
-      m_nestedBeginCount = nestedBeginCount;
-      return NULL;
+
+  // new characters go on the end and are merged in once they're all there
+  ReserveCharacters(m_numChars + missing.size());
+  int cached = m_numChars;
+  for (std::vector<character_t>::const_iterator it = missing.begin(); it != missing.end(); ++it)
+  {
+    wchar_t letter = (wchar_t)(*it & 0xffff);
+    uint32_t style = *it >> 16;
+    if (!CacheCharacter(letter, style, m_char + m_numChars))
+    { // unable to cache character - try clearing them all out and starting over
+      CLog::Log(LOGDEBUG, "%s: Unable to cache character.  Clearing character cache of %i characters", __FUNCTION__, m_numChars);
+      ClearCharacterCache();
+      ReserveCharacters(missing.end() - it);
+      cached = 0;
+      if (!CacheCharacter(letter, style, m_char + m_numChars))
+        CLog::Log(LOGERROR, "%s: Unable to cache character (out of memory?)", __FUNCTION__);
     }
   }
+  std::inplace_merge(m_char, m_char + cached, m_char + m_numChars);
+
   if (nestedBeginCount) Begin();
   m_nestedBeginCount = nestedBeginCount;
 
@@ -654,11 +756,35 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
     }
   }
 
-  return m_char + low;
+  // only log the batches worth measuring (i.e. a new page of CJK text), not single characters
+  if (missing.size() >= 16)
+    CLog::Log(LOGDEBUG, "%s: cached %u characters of %s in %u ms, texture now %ux%u", __FUNCTION__,
+              (unsigned int)missing.size(), m_strFileName.c_str(), XbmcThreads::SystemClockMillis() - startTime,
+              m_textureWidth, m_textureHeight);
+}
+
+void CGUIFontTTFBase::ReserveCharacters(int numChars)
+{
+  if (numChars <= m_maxChars)
+    return;
+
+  // grow in whole chunks
+  int maxChars = ((numChars + CHAR_CHUNK - 1) / CHAR_CHUNK) * CHAR_CHUNK;
+  Character *newTable = new Character[maxChars];
+  if (m_char)
+  {
+    memcpy(newTable, m_char, m_numChars * sizeof(Character));
+    delete[] m_char;
+  }
+  m_char = newTable;
+  m_maxChars = maxChars;
 }
 
 bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
 {
+  // the face is shared with the other sizes of this font
+  FT_Activate_Size(m_faceSize);
+
   int glyph_index = FT_Get_Char_Index( m_face, letter );
 
   FT_Glyph glyph = NULL;
@@ -934,7 +1060,7 @@ void CGUIFontTTFBase::EmboldenGlyph(FT_GlyphSlot slot)
 
   /* some reasonable strength */
   FT_Pos strength = FT_MulFix( m_face->units_per_EM,
-                    m_face->size->metrics.y_scale ) / 24;
+                    m_faceSize->metrics.y_scale ) / 24;
 
   FT_BBox bbox_before, bbox_after;
   FT_Outline_Get_CBox( &slot->outline, &bbox_before );
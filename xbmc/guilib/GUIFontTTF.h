@@ -31,7 +31,6 @@
 #include <stdint.h>
 #include <vector>
 
-#include "utils/auto_buffer.h"
 #include "Geometry.h"
 
 // forward definition
@@ -42,12 +41,14 @@ struct FT_LibraryRec_;
 struct FT_GlyphSlotRec_;
 struct FT_BitmapGlyphRec_;
 struct FT_StrokerRec_;
+struct FT_SizeRec_;
 
 typedef struct FT_FaceRec_ *FT_Face;
 typedef struct FT_LibraryRec_ *FT_Library;
 typedef struct FT_GlyphSlotRec_ *FT_GlyphSlot;
 typedef struct FT_BitmapGlyphRec_ *FT_BitmapGlyph;
 typedef struct FT_StrokerRec_ *FT_Stroker;
+typedef struct FT_SizeRec_ *FT_Size;
 
 typedef uint32_t character_t;
 typedef uint32_t color_t;
@@ -102,6 +103,7 @@ protected:
     float left, top, right, bottom;
     float advance;
     character_t letterAndStyle;
+    bool operator<(const Character &right) const { return letterAndStyle < right.letterAndStyle; };
   };
   void AddReference();
   void RemoveReference();
@@ -121,6 +123,13 @@ protected:
 
   // Stuff for pre-rendering for speed
   inline Character *GetCharacter(character_t letter);
+  Character *FindCharacter(character_t letter);
+  /*! \brief Cache all characters of the text that aren't cached yet.
+   Caching a run of text at once needs a single texture update and character table merge,
+   rather than one for each new character, which adds up for CJK text.
+   */
+  void CacheCharacters(vecText::const_iterator start, vecText::const_iterator end);
+  void ReserveCharacters(int numChars);
   bool CacheCharacter(wchar_t letter, uint32_t style, Character *ch);
   void RenderCharacter(float posX, float posY, const Character *ch, color_t color, bool roundX, std::vector<SVertex> &vertices);
   void ClearCharacterCache();
@@ -161,7 +170,8 @@ protected:
   unsigned int m_nestedBeginCount;             // speedups
 
   // freetype stuff
-  FT_Face    m_face;
+  FT_Face    m_face;                 // shared by all sizes of the font file
+  FT_Size    m_faceSize;             // our size of m_face
   FT_Stroker m_stroker;
 
   float m_originX;
@@ -185,7 +195,6 @@ protected:
   float    m_textureScaleY;
 
   std::string m_strFileName;
-  XUTILS::auto_buffer m_fontFileInMemory; // used only in some cases, see CFreeTypeLibrary::GetFont()
 
   CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue> m_staticCache;
   CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue> m_dynamicCache;
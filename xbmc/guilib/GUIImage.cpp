@@ -285,6 +285,12 @@ bool CGUIImage::CanFocus() const
   return false;
 }
 
+bool CGUIImage::IsStatic() const
+{
+  return HasStaticProperties() && m_info.IsConstant() && !m_crossFadeTime &&
+         m_fadingTextures.empty() && m_texture.IsStatic();
+}
+
 float CGUIImage::GetTextureWidth() const
 {
   return m_texture.GetTextureWidth();
@@ -313,6 +319,7 @@ const std::string &CGUIImage::GetFileName() const
 void CGUIImage::SetAspectRatio(const CAspectRatio &aspect)
 {
   m_texture.SetAspectRatio(aspect);
+  MarkSubtreeDirty();
 }
 
 void CGUIImage::SetCrossFade(unsigned int time)
@@ -320,12 +327,16 @@ void CGUIImage::SetCrossFade(unsigned int time)
   m_crossFadeTime = time;
   if (!m_crossFadeTime && m_texture.IsLazyLoaded() && !m_info.GetFallback().empty())
     m_crossFadeTime = 1;
+  MarkSubtreeDirty();
 }
 
 void CGUIImage::SetFileName(const std::string& strFileName, bool setConstant, const bool useCache)
 {
   if (setConstant)
+  {
     m_info.SetLabel(strFileName, "", GetParentID());
+    MarkSubtreeDirty();
+  }
 
   // Set whether or not to use cache
   m_texture.SetUseCache(useCache);
@@ -390,6 +401,7 @@ void CGUIImage::SetInfo(const CGUIInfoLabel &info)
   // a constant image never needs updating
   if (m_info.IsConstant())
     m_texture.SetFileName(m_info.GetLabel(0));
+  MarkSubtreeDirty();
 }
 
 unsigned char CGUIImage::GetFadeLevel(unsigned int time) const
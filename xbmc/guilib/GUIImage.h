@@ -82,6 +82,7 @@ public:
   virtual void SetInvalid();
   virtual bool CanFocus() const;
   virtual void UpdateInfo(const CGUIListItem *item = NULL);
+  virtual bool IsStatic() const;
 
   virtual void SetInfo(const CGUIInfoLabel &info);
   virtual void SetFileName(const std::string& strFileName, bool setConstant = false, const bool useCache = true);
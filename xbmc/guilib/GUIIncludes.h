@@ -51,6 +51,9 @@ public:
   void ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
   const INFO::CSkinVariableString* CreateSkinVariable(const std::string& name, int context);
 
+  /*! \brief The include files loaded so far */
+  const std::vector<std::string>& GetFiles() const { return m_files; }
+
 private:
   void ResolveIncludesForNode(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
   std::string ResolveConstant(const std::string &constant) const;
@@ -64,6 +64,9 @@ public:
   bool Update();
   void Parse(const std::string &label, int context);
 
+  /*! \brief whether the color is fixed, rather than coming from an info label */
+  bool IsConstant() const { return m_info == 0; };
+
 private:
   color_t GetColor() const;
   int     m_info;
@@ -135,6 +135,12 @@ void CGUILabel::SetInvalid()
   m_invalid = true;
 }
 
+bool CGUILabel::IsStatic() const
+{
+  bool overFlows = (m_renderRect.Width() + 0.5f < m_textLayout.GetTextWidth()); // 0.5f to deal with floating point rounding issues
+  return !m_invalid && m_label.HasConstantColors() && !(overFlows && m_scrolling);
+}
+
 bool CGUILabel::UpdateColors()
 {
   return m_label.UpdateColors();
@@ -56,6 +56,12 @@ public:
 
     return changed;
   };
+
+  bool HasConstantColors() const
+  {
+    return textColor.IsConstant() && shadowColor.IsConstant() && selectedColor.IsConstant() &&
+           disabledColor.IsConstant() && focusedColor.IsConstant() && invalidColor.IsConstant();
+  };
   
   CGUIInfoColor textColor;
   CGUIInfoColor shadowColor;
@@ -168,6 +174,11 @@ public:
   /*! \brief Update this labels colors
    */
   bool UpdateColors();
+
+  /*! \brief Returns whether Process() and UpdateColors() have nothing to do
+   True for laid out labels with fixed colors that don't need to scroll.
+   */
+  bool IsStatic() const;
   
   /*! \brief Returns the precalculated final layout of the current text
    \return CRect containing the extents of the current text
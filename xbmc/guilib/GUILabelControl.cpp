@@ -45,6 +45,7 @@ CGUILabelControl::~CGUILabelControl(void)
 void CGUILabelControl::ShowCursor(bool bShow)
 {
   m_bShowCursor = bShow;
+  MarkSubtreeDirty();
 }
 
 void CGUILabelControl::SetCursorPos(int iPos)
@@ -64,6 +65,7 @@ void CGUILabelControl::SetCursorPos(int iPos)
 void CGUILabelControl::SetInfo(const CGUIInfoLabel &infoLabel)
 {
   m_infoLabel = infoLabel;
+  MarkSubtreeDirty();
 }
 
 bool CGUILabelControl::UpdateColors()
@@ -142,6 +144,13 @@ CRect CGUILabelControl::CalcRenderRegion() const
   return m_label.GetRenderRect();
 }
 
+bool CGUILabelControl::IsStatic() const
+{
+  return HasStaticProperties() && m_infoLabel.IsConstant() && !m_bShowCursor &&
+         m_startHighlight >= m_endHighlight && m_startSelection >= m_endSelection &&
+         m_label.IsStatic();
+}
+
 void CGUILabelControl::Render()
 {
   m_label.Render();
@@ -276,12 +285,14 @@ void CGUILabelControl::SetHighlight(unsigned int start, unsigned int end)
 {
   m_startHighlight = start;
   m_endHighlight = end;
+  MarkSubtreeDirty();
 }
 
 void CGUILabelControl::SetSelection(unsigned int start, unsigned int end)
 {
   m_startSelection = start;
   m_endSelection = end;
+  MarkSubtreeDirty();
 }
 
 std::string CGUILabelControl::GetDescription() const
@@ -0,0 +1,356 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+
+#include "GUISkinCache.h"
+#include "GUIInfoManager.h"
+#include "addons/Skin.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/auto_buffer.h"
+#include "utils/Crc32.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+using namespace XFILE;
+
+// bump whenever the layout below changes
+#define SKINCACHE_MAGIC   "XBSC"
+#define SKINCACHE_VERSION 1
+
+// compiled copies kept per window, one for each set of include condition values
+#define SKINCACHE_VARIANTS 4
+
+#define NODE_ELEMENT 1
+#define NODE_TEXT    2
+
+/* A compiled window is laid out as
+     magic, version
+     skin id, skin version, window path
+     dependency count, { path, mtime, size }
+     include condition count, { expression, value }
+     root element
+
+   with an element being
+     NODE_ELEMENT, name, attribute count, { name, value }, child count, { element or text }
+   and text being
+     NODE_TEXT, value
+
+   strings are a uint32 length followed by the characters. Integers are stored in the
+   native byte order, as the cache never leaves the box it was written on.
+ */
+
+class CSkinCacheWriter
+{
+public:
+  void WriteUInt(uint32_t value) { m_buffer.append((const char *)&value, sizeof(value)); }
+  void WriteInt64(int64_t value) { m_buffer.append((const char *)&value, sizeof(value)); }
+  void WriteString(const std::string &value)
+  {
+    WriteUInt((uint32_t)value.size());
+    m_buffer.append(value);
+  }
+
+  void WriteElement(const TiXmlElement *element)
+  {
+    WriteUInt(NODE_ELEMENT);
+    WriteString(element->ValueStr());
+
+    uint32_t attributes = 0;
+    for (const TiXmlAttribute *attribute = element->FirstAttribute(); attribute; attribute = attribute->Next())
+      attributes++;
+    WriteUInt(attributes);
+    for (const TiXmlAttribute *attribute = element->FirstAttribute(); attribute; attribute = attribute->Next())
+    {
+      WriteString(attribute->Name());
+      WriteString(attribute->Value());
+    }
+
+    // comments and the like are of no interest to the control factory
+    uint32_t children = 0;
+    for (const TiXmlNode *child = element->FirstChild(); child; child = child->NextSibling())
+    {
+      if (child->Type() == TiXmlNode::TINYXML_ELEMENT || child->Type() == TiXmlNode::TINYXML_TEXT)
+        children++;
+    }
+    WriteUInt(children);
+    for (const TiXmlNode *child = element->FirstChild(); child; child = child->NextSibling())
+    {
+      if (child->Type() == TiXmlNode::TINYXML_ELEMENT)
+        WriteElement(child->ToElement());
+      else if (child->Type() == TiXmlNode::TINYXML_TEXT)
+      {
+        WriteUInt(NODE_TEXT);
+        WriteString(child->ValueStr());
+      }
+    }
+  }
+
+  const std::string &GetBuffer() const { return m_buffer; }
+
+private:
+  std::string m_buffer;
+};
+
+class CSkinCacheReader
+{
+public:
+  CSkinCacheReader(const char *buffer, size_t size) : m_pos(buffer), m_end(buffer + size) {}
+
+  bool ReadUInt(uint32_t &value) { return Read(&value, sizeof(value)); }
+  bool ReadInt64(int64_t &value) { return Read(&value, sizeof(value)); }
+  bool ReadString(std::string &value)
+  {
+    uint32_t size;
+    if (!ReadUInt(size) || size > (size_t)(m_end - m_pos))
+      return false;
+    value.assign(m_pos, size);
+    m_pos += size;
+    return true;
+  }
+
+  /*! \brief Read an element and its children into the given element */
+  bool ReadElement(TiXmlElement &element)
+  {
+    uint32_t type, count;
+    std::string name, value;
+    if (!ReadUInt(type) || type != NODE_ELEMENT || !ReadString(name) || !ReadUInt(count))
+      return false;
+    element.SetValue(name);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+      if (!ReadString(name) || !ReadString(value))
+        return false;
+      element.SetAttribute(name, value);
+    }
+
+    if (!ReadUInt(count))
+      return false;
+    for (uint32_t i = 0; i < count; i++)
+    {
+      const char *pos = m_pos;
+      if (!ReadUInt(type))
+        return false;
+      if (type == NODE_TEXT)
+      {
+        if (!ReadString(value))
+          return false;
+        element.LinkEndChild(new TiXmlText(value));
+      }
+      else
+      {
+        m_pos = pos;
+        TiXmlElement *child = new TiXmlElement("");
+        element.LinkEndChild(child);
+        if (!ReadElement(*child))
+          return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  bool Read(void *value, size_t size)
+  {
+    if (size > (size_t)(m_end - m_pos))
+      return false;
+    memcpy(value, m_pos, size);
+    m_pos += size;
+    return true;
+  }
+
+  const char *m_pos;
+  const char *m_end;
+};
+
+static bool GetFileStamp(const std::string &path, int64_t &mtime, int64_t &size)
+{
+  struct __stat64 buffer;
+  if (CFile::Stat(path, &buffer) != 0)
+    return false;
+  mtime = (int64_t)buffer.st_mtime;
+  size = (int64_t)buffer.st_size;
+  return true;
+}
+
+std::string CGUISkinCache::GetCachePath(const std::string &path, unsigned int variant)
+{
+  Crc32 crc;
+  crc.ComputeFromLowerCase(path);
+  return StringUtils::Format("special://temp/skincache/%s/%08x-%u.bin", g_SkinInfo->ID().c_str(), (uint32_t)crc, variant);
+}
+
+TiXmlElement *CGUISkinCache::LoadWindow(const std::string &path, std::map<INFO::InfoPtr, bool> &xmlIncludeConditions)
+{
+  if (!g_advancedSettings.m_guiSkinCache || !g_SkinInfo)
+    return NULL;
+
+  for (unsigned int variant = 0; variant < SKINCACHE_VARIANTS; variant++)
+  {
+    TiXmlElement *root = LoadCompiled(GetCachePath(path, variant), path, xmlIncludeConditions);
+    if (root)
+      return root;
+  }
+  return NULL;
+}
+
+TiXmlElement *CGUISkinCache::LoadCompiled(const std::string &cachePath, const std::string &path, std::map<INFO::InfoPtr, bool> &xmlIncludeConditions)
+{
+  XUTILS::auto_buffer buffer;
+  CFile file;
+  if (!CFile::Exists(cachePath) || file.LoadFile(cachePath, buffer) <= 0)
+    return NULL;
+
+  CSkinCacheReader reader(buffer.get(), buffer.size());
+  std::string magic, skinID, skinVersion, windowPath;
+  uint32_t version;
+  if (!reader.ReadString(magic) || magic != SKINCACHE_MAGIC ||
+      !reader.ReadUInt(version) || version != SKINCACHE_VERSION ||
+      !reader.ReadString(skinID) || skinID != g_SkinInfo->ID() ||
+      !reader.ReadString(skinVersion) || skinVersion != g_SkinInfo->Version().asString() ||
+      !reader.ReadString(windowPath) || windowPath != path)
+    return NULL;
+
+  uint32_t count;
+  if (!reader.ReadUInt(count))
+    return NULL;
+  std::vector<std::string> includeFiles;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    std::string dependency;
+    int64_t mtime, size, currentMTime, currentSize;
+    if (!reader.ReadString(dependency) || !reader.ReadInt64(mtime) || !reader.ReadInt64(size))
+      return NULL;
+    if (!GetFileStamp(dependency, currentMTime, currentSize) || currentMTime != mtime || currentSize != size)
+    {
+      CLog::Log(LOGDEBUG, "CGUISkinCache: %s changed, recompiling %s", dependency.c_str(), path.c_str());
+      return NULL;
+    }
+    if (i > 0)
+      includeFiles.push_back(dependency);
+  }
+
+  if (!reader.ReadUInt(count))
+    return NULL;
+  std::map<INFO::InfoPtr, bool> conditions;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    std::string expression;
+    uint32_t value;
+    if (!reader.ReadString(expression) || !reader.ReadUInt(value))
+      return NULL;
+    INFO::InfoPtr condition = g_infoManager.Register(expression);
+    if (condition->Get() != (value != 0))
+      return NULL; // resolved differently this time around
+    conditions[condition] = value != 0;
+  }
+
+  TiXmlElement *root = new TiXmlElement("");
+  if (!reader.ReadElement(*root))
+  {
+    CLog::Log(LOGERROR, "CGUISkinCache: %s is corrupt", cachePath.c_str());
+    delete root;
+    return NULL;
+  }
+
+  // skin variables are created from the include files when the controls are loaded
+  for (std::vector<std::string>::const_iterator it = includeFiles.begin(); it != includeFiles.end(); ++it)
+    g_SkinInfo->LoadIncludeFile(*it);
+
+  xmlIncludeConditions.swap(conditions);
+  return root;
+}
+
+void CGUISkinCache::StoreWindow(const std::string &path, const TiXmlElement *root, const std::map<INFO::InfoPtr, bool> &xmlIncludeConditions)
+{
+  if (!g_advancedSettings.m_guiSkinCache || !g_SkinInfo || !root)
+    return;
+
+  CSkinCacheWriter writer;
+  writer.WriteString(SKINCACHE_MAGIC);
+  writer.WriteUInt(SKINCACHE_VERSION);
+  writer.WriteString(g_SkinInfo->ID());
+  writer.WriteString(g_SkinInfo->Version().asString());
+  writer.WriteString(path);
+
+  // the window itself comes first, followed by everything it may have been resolved against
+  std::vector<std::string> dependencies = g_SkinInfo->GetIncludeFiles();
+  dependencies.insert(dependencies.begin(), path);
+  writer.WriteUInt((uint32_t)dependencies.size());
+  for (std::vector<std::string>::const_iterator it = dependencies.begin(); it != dependencies.end(); ++it)
+  {
+    int64_t mtime, size;
+    if (!GetFileStamp(*it, mtime, size))
+      return; // not a file we can check later on
+    writer.WriteString(*it);
+    writer.WriteInt64(mtime);
+    writer.WriteInt64(size);
+  }
+
+  writer.WriteUInt((uint32_t)xmlIncludeConditions.size());
+  for (std::map<INFO::InfoPtr, bool>::const_iterator it = xmlIncludeConditions.begin(); it != xmlIncludeConditions.end(); ++it)
+  {
+    writer.WriteString(it->first->GetExpression());
+    writer.WriteUInt(it->second ? 1 : 0);
+  }
+
+  writer.WriteElement(root);
+
+  // take the place of a variant that isn't there, or else of the one written longest ago
+  std::string cachePath;
+  int64_t oldest = 0;
+  for (unsigned int variant = 0; variant < SKINCACHE_VARIANTS; variant++)
+  {
+    std::string variantPath = GetCachePath(path, variant);
+    int64_t mtime, size;
+    if (!GetFileStamp(variantPath, mtime, size))
+    {
+      cachePath = variantPath;
+      break;
+    }
+    if (cachePath.empty() || mtime < oldest)
+    {
+      cachePath = variantPath;
+      oldest = mtime;
+    }
+  }
+
+  CDirectory::Create("special://temp/skincache/");
+  CDirectory::Create(URIUtils::GetDirectory(cachePath));
+  CFile file;
+  const std::string &buffer = writer.GetBuffer();
+  if (!file.OpenForWrite(cachePath, true))
+  {
+    CLog::Log(LOGWARNING, "CGUISkinCache: unable to write %s", cachePath.c_str());
+    return;
+  }
+  bool written = file.Write(buffer.c_str(), buffer.size()) == (ssize_t)buffer.size();
+  file.Close();
+  if (!written)
+  {
+    CLog::Log(LOGWARNING, "CGUISkinCache: unable to write %s", cachePath.c_str());
+    CFile::Delete(cachePath);
+  }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <map>
+#include <string>
+#include "interfaces/info/InfoBool.h"
+
+// forward definitions
+class TiXmlElement;
+
+/*!
+ \ingroup guilib
+ \brief Compiled copies of the skin's windows, with includes, defaults and constants resolved.
+
+ Loading a window otherwise means parsing its xml and copying in the include trees
+ every time it's opened. The compiled copy is a binary dump of the resolved tree,
+ stored in special://temp/skincache/<skin>/ and read back in a single pass.
+
+ A compiled window is only used while the skin's version, the window file and every
+ include file it was resolved against are unchanged, and while the include conditions
+ it was resolved with still have the same values. A few compiled copies are kept per
+ window, so switching between values of its include conditions doesn't recompile it.
+ */
+class CGUISkinCache
+{
+public:
+  /*! \brief Load the compiled copy of a window.
+   \param path the window's xml file.
+   \param xmlIncludeConditions [out] the include conditions the window was resolved with.
+   \return the resolved root element, owned by the caller, or NULL if there is no usable copy.
+   */
+  static TiXmlElement *LoadWindow(const std::string &path, std::map<INFO::InfoPtr, bool> &xmlIncludeConditions);
+
+  /*! \brief Store the compiled copy of a window.
+   \param path the window's xml file.
+   \param root the window's root element with its includes resolved.
+   \param xmlIncludeConditions the include conditions used to resolve it.
+   */
+  static void StoreWindow(const std::string &path, const TiXmlElement *root, const std::map<INFO::InfoPtr, bool> &xmlIncludeConditions);
+
+private:
+  static TiXmlElement *LoadCompiled(const std::string &cachePath, const std::string &path, std::map<INFO::InfoPtr, bool> &xmlIncludeConditions);
+  static std::string GetCachePath(const std::string &path, unsigned int variant);
+};
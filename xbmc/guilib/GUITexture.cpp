@@ -81,6 +81,7 @@ CGUITextureBase::CGUITextureBase(float posX, float posY, float width, float heig
 
   m_allocateDynamically = false;
   m_isAllocated = NO;
+  m_largeSize = m_largeWanted = m_largeUpgrade = 0;
   m_invalid = true;
   m_use_cache = true;
 }
@@ -119,6 +120,7 @@ CGUITextureBase::CGUITextureBase(const CGUITextureBase &right) :
   m_currentLoop = 0;
 
   m_isAllocated = NO;
+  m_largeSize = m_largeWanted = m_largeUpgrade = 0;
   m_invalid = true;
 }
 
@@ -132,6 +134,8 @@ bool CGUITextureBase::AllocateOnDemand()
   { // visible, so make sure we're allocated
     if (!IsAllocated() || (m_isAllocated == LARGE && !m_texture.size()))
       return AllocResources();
+    if (m_isAllocated == LARGE && CGUILargeTextureManager::IsLarger(m_largeWanted, m_largeSize))
+      return UpdateLargeTexture();
   }
   else
   { // hidden, so deallocate as applicable
@@ -146,6 +150,58 @@ bool CGUITextureBase::AllocateOnDemand()
   return false;
 }
 
+bool CGUITextureBase::UpdateLargeTexture()
+{
+  // keep drawing the texture we have until the larger one arrives
+  bool firstRequest = !CGUILargeTextureManager::IsLarger(m_largeUpgrade, m_largeSize);
+  if (firstRequest && !g_largeTextureManager.CanUpgrade())
+    return false;
+
+  CTextureArray texture;
+  unsigned int size = firstRequest ? m_largeWanted : m_largeUpgrade;
+  unsigned int loadedSize = size;
+  if (!g_largeTextureManager.GetImage(m_info.filename, texture, firstRequest, m_use_cache, size, &loadedSize))
+  { // make do with what we have
+    g_largeTextureManager.ReleaseImage(m_info.filename, true, loadedSize);
+    m_largeWanted = m_largeUpgrade = m_largeSize;
+    return false;
+  }
+  m_largeUpgrade = loadedSize;
+  if (CGUILargeTextureManager::IsLarger(size, loadedSize))
+  { // given a smaller resolution while the wanted one loads, which is only of use if it beats ours
+    m_largeUpgrade = size;
+    if (!CGUILargeTextureManager::IsLarger(loadedSize, m_largeSize))
+    {
+      g_largeTextureManager.ReleaseImage(m_info.filename, false, loadedSize);
+      return false;
+    }
+  }
+  if (!texture.size()) // not ready as yet
+    return false;
+
+  g_largeTextureManager.ReleaseImage(m_info.filename, false, m_largeSize);
+  m_largeSize = loadedSize;
+  m_texture = texture;
+  m_frameWidth = (float)m_texture.m_width;
+  m_frameHeight = (float)m_texture.m_height;
+  CalculateSize();
+  return true;
+}
+
+unsigned int CGUITextureBase::GetLargeStreamSize() const
+{
+  // centered images are drawn at their own size, and cropped ones may show any part of it at any size
+  if (m_aspect.ratio == CAspectRatio::AR_CENTER || m_aspect.ratio == CAspectRatio::AR_SCALE)
+    return 0;
+  return CGUILargeTextureManager::GetStreamSize(m_width * g_graphicsContext.GetGUIScaleX(), m_height * g_graphicsContext.GetGUIScaleY());
+}
+
+bool CGUITextureBase::IsStatic() const
+{
+  return m_texture.size() == 1 && (m_isAllocated == NORMAL || m_isAllocated == LARGE) && !m_invalid &&
+         !CGUILargeTextureManager::IsLarger(m_largeWanted, m_largeSize);
+}
+
 bool CGUITextureBase::Process(unsigned int currentTime)
 {
   bool changed = false;
@@ -316,9 +372,15 @@ bool CGUITextureBase::AllocResources()
       }
     }
     if (m_isAllocated != NORMAL)
-    { // use our large image background loader
+    { // use our large image background loader, at the resolution we're drawn at
       CTextureArray texture;
-      if (g_largeTextureManager.GetImage(m_info.filename, texture, !IsAllocated(), m_use_cache))
+      if (!IsAllocated())
+        m_largeWanted = GetLargeStreamSize();
+      unsigned int size = IsAllocated() ? m_largeSize : m_largeWanted;
+      bool loaded = g_largeTextureManager.GetImage(m_info.filename, texture, !IsAllocated(), m_use_cache, size, &m_largeSize);
+      // a smaller resolution comes with the wanted one queued as an upgrade
+      m_largeUpgrade = CGUILargeTextureManager::IsLarger(size, m_largeSize) ? size : m_largeSize;
+      if (loaded)
       {
         m_isAllocated = LARGE;
 
@@ -367,6 +429,9 @@ bool CGUITextureBase::CalculateSize()
   if (m_currentFrame >= m_texture.size())
     return false;
 
+  if (m_isAllocated == LARGE) // we may have grown
+    m_largeWanted = GetLargeStreamSize();
+
   m_texCoordsScaleU = 1.0f / m_texture.m_texWidth;
   m_texCoordsScaleV = 1.0f / m_texture.m_texHeight;
 
@@ -460,7 +525,11 @@ bool CGUITextureBase::CalculateSize()
 void CGUITextureBase::FreeResources(bool immediately /* = false */)
 {
   if (m_isAllocated == LARGE || m_isAllocated == LARGE_FAILED)
-    g_largeTextureManager.ReleaseImage(m_info.filename, immediately || (m_isAllocated == LARGE_FAILED));
+  {
+    g_largeTextureManager.ReleaseImage(m_info.filename, immediately || (m_isAllocated == LARGE_FAILED), m_largeSize);
+    if (CGUILargeTextureManager::IsLarger(m_largeUpgrade, m_largeSize))
+      g_largeTextureManager.ReleaseImage(m_info.filename, immediately, m_largeUpgrade);
+  }
   else if (m_isAllocated == NORMAL && m_texture.size())
     g_TextureManager.ReleaseTexture(m_info.filename, immediately);
 
@@ -479,6 +548,7 @@ void CGUITextureBase::FreeResources(bool immediately /* = false */)
   Free();
 
   m_isAllocated = NO;
+  m_largeSize = m_largeWanted = m_largeUpgrade = 0;
 }
 
 void CGUITextureBase::DynamicResourceAlloc(bool allocateDynamically)
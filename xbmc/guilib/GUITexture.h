@@ -120,12 +120,16 @@ public:
 
   bool HitTest(const CPoint &point) const { return CRect(m_posX, m_posY, m_posX + m_width, m_posY + m_height).PtInRect(point); };
   bool IsAllocated() const { return m_isAllocated != NO; };
+  /*! \brief whether the texture is loaded, sized and not animated, so Process() has nothing to do */
+  bool IsStatic() const;
   bool FailedToAlloc() const { return m_isAllocated == NORMAL_FAILED || m_isAllocated == LARGE_FAILED; };
   bool ReadyToRender() const;
 protected:
   bool CalculateSize();
   void LoadDiffuseImage();
   bool AllocateOnDemand();
+  bool UpdateLargeTexture();
+  unsigned int GetLargeStreamSize() const;
   bool UpdateAnimFrame();
   void Render(float left, float top, float bottom, float right, float u1, float v1, float u2, float v2, float u3, float v3);
   static void OrientateTexture(CRect &rect, float width, float height, int orientation);
@@ -166,6 +170,11 @@ protected:
   enum ALLOCATE_TYPE { NO = 0, NORMAL, LARGE, NORMAL_FAILED, LARGE_FAILED };
   ALLOCATE_TYPE m_isAllocated;
 
+  // resolutions of large textures, see CGUILargeTextureManager::GetStreamSize
+  unsigned int m_largeSize;    // of the texture we have
+  unsigned int m_largeWanted;  // our size on screen calls for
+  unsigned int m_largeUpgrade; // of the texture being streamed in to replace ours
+
   CTextureInfo m_info;
   CAspectRatio m_aspect;
 
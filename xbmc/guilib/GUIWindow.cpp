@@ -26,6 +26,8 @@
 #include "GUIControlFactory.h"
 #include "GUIControlGroup.h"
 #include "GUIControlProfiler.h"
+#include "GUISkinCache.h"
+#include "TextureManager.h"
 
 #include "addons/Skin.h"
 #include "GUIInfoManager.h"
@@ -71,6 +73,7 @@ CGUIWindow::CGUIWindow(int id, const std::string &xmlFile)
   m_exclusiveMouseControl = 0;
   m_clearBackground = 0xff000000; // opaque black -> always clear
   m_windowXMLRootElement = NULL;
+  m_windowXMLResolved = false;
 }
 
 CGUIWindow::~CGUIWindow(void)
@@ -87,10 +90,9 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
   if (m_windowLoaded || g_SkinInfo == NULL)
     return true;      // no point loading if it's already there
 
-#ifdef _DEBUG
   int64_t start;
   start = CurrentHostCounter();
-#endif
+
   const char* strLoadType;
   switch (m_loadType)
   {
@@ -123,18 +125,35 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
 
   bool ret = LoadXML(strPath.c_str(), strLowerPath.c_str());
 
-#ifdef _DEBUG
   int64_t end, freq;
   end = CurrentHostCounter();
   freq = CurrentHostFrequency();
   CLog::Log(LOGDEBUG,"Load %s: %.2fms", GetProperty("xmlfile").c_str(), 1000.f * (end - start) / freq);
-#endif
   return ret;
 }
 
 bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLowerPath)
 {
-  // load window xml if we don't have it stored yet
+  // a stored compiled window only fits the include condition values it was resolved with
+  if (m_windowXMLRootElement && m_windowXMLResolved && g_infoManager.ConditionsChangedValues(m_xmlIncludeConditions))
+  {
+    delete m_windowXMLRootElement;
+    m_windowXMLRootElement = NULL;
+  }
+
+  // load window xml if we don't have it stored yet, compiling it only when it was parsed
+  std::string compiledPath;
+  if (!m_windowXMLRootElement)
+  {
+    // a window compiled on an earlier load comes with its includes resolved already
+    m_windowXMLRootElement = CGUISkinCache::LoadWindow(strPath, m_xmlIncludeConditions);
+    m_windowXMLResolved = m_windowXMLRootElement != NULL;
+    if (m_windowXMLResolved)
+      CLog::Log(LOGDEBUG, "Using compiled xml for %s", strPath.c_str());
+  }
+  else
+    CLog::Log(LOGDEBUG, "Using already stored xml root node for %s", strPath.c_str());
+
   if (!m_windowXMLRootElement)
   {
     CXBMCTinyXML xmlDoc;
@@ -147,14 +166,15 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
       return false;
     }
     m_windowXMLRootElement = (TiXmlElement*)xmlDoc.RootElement()->Clone();
+    compiledPath = strPath;
   }
-  else
-    CLog::Log(LOGDEBUG, "Using already stored xml root node for %s", strPath.c_str());
 
-  return Load(m_windowXMLRootElement);
+  if (m_windowXMLResolved)
+    return LoadResolved((TiXmlElement*)m_windowXMLRootElement->Clone());
+  return Load(m_windowXMLRootElement, compiledPath);
 }
 
-bool CGUIWindow::Load(TiXmlElement* pRootElement)
+bool CGUIWindow::Load(TiXmlElement* pRootElement, const std::string &compiledPath /* = "" */)
 {
   if (!pRootElement)
     return false;
@@ -169,12 +189,41 @@ bool CGUIWindow::Load(TiXmlElement* pRootElement)
   // and we don't want original root element to change
   pRootElement = (TiXmlElement*)pRootElement->Clone();
 
+  // Resolve any includes that may be present and save conditions used to do it
+  g_SkinInfo->ResolveIncludes(pRootElement, &m_xmlIncludeConditions);
+  if (!compiledPath.empty())
+    CGUISkinCache::StoreWindow(compiledPath, pRootElement, m_xmlIncludeConditions);
+
+  return LoadResolved(pRootElement);
+}
+
+// the textures the controls below the element name, other than those given by info labels
+static void GetTextures(const TiXmlElement *element, std::vector<std::string> &textures)
+{
+  for (const TiXmlElement *child = element->FirstChildElement(); child; child = child->NextSiblingElement())
+  {
+    if (child->ValueStr().find("texture") != std::string::npos &&
+        child->FirstChild() && child->FirstChild()->Type() == TiXmlNode::TINYXML_TEXT)
+    {
+      const std::string &texture = child->FirstChild()->ValueStr();
+      if (texture.find('$') == std::string::npos && texture.find("://") == std::string::npos)
+        textures.push_back(texture);
+    }
+    GetTextures(child, textures);
+  }
+}
+
+bool CGUIWindow::LoadResolved(TiXmlElement* pRootElement)
+{
+  // unpack the bundled textures of the window on worker threads while its controls are created
+  std::vector<std::string> textures;
+  GetTextures(pRootElement, textures);
+  g_TextureManager.Prefetch(textures);
+
   // set the scaling resolution so that any control creation or initialisation can
   // be done with respect to the correct aspect ratio
   g_graphicsContext.SetScalingResolution(m_coordsRes, m_needsScaling);
 
-  // Resolve any includes that may be present and save conditions used to do it
-  g_SkinInfo->ResolveIncludes(pRootElement, &m_xmlIncludeConditions);
   // now load in the skin file
   SetDefaults();
 
@@ -196,7 +196,8 @@ public:
 protected:
   virtual EVENT_RESULT OnMouseEvent(const CPoint &point, const CMouseEvent &event);
   virtual bool LoadXML(const std::string& strPath, const std::string &strLowerPath);  ///< Loads from the given file
-  bool Load(TiXmlElement *pRootElement);                 ///< Loads from the given XML root element
+  bool Load(TiXmlElement *pRootElement, const std::string &compiledPath = "");  ///< Loads from the given XML root element, compiling it for the next load if a path is given
+  bool LoadResolved(TiXmlElement *pRootElement);         ///< Loads from the given XML root element with includes resolved, taking ownership of it
   /*! \brief Check if XML file needs (re)loading
    XML file has to be (re)loaded when window is not loaded or include conditions values were changed
    */
@@ -269,6 +270,7 @@ protected:
   CGUIAction m_unloadActions;
 
   TiXmlElement* m_windowXMLRootElement;
+  bool m_windowXMLResolved; ///< \brief whether m_windowXMLRootElement came compiled, with its includes resolved
 
   bool m_manualRunActions;
 
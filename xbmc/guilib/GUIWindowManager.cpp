@@ -159,6 +159,9 @@ CGUIWindowManager::CGUIWindowManager(void)
   m_bShowOverlay = true;
   m_iNested = 0;
   m_initialized = false;
+  m_renderStats.markedRegions = 0;
+  m_renderStats.passes = 0;
+  m_renderStats.coverage = 0;
 }
 
 CGUIWindowManager::~CGUIWindowManager(void)
@@ -561,6 +564,12 @@ void CGUIWindowManager::Add(CGUIWindow* pWindow)
       return;
     }
     m_mapWindows.insert(pair<int, CGUIWindow *>(*idIt, pWindow));
+    if (*idIt >= WINDOW_HOME && *idIt <= WINDOW_ADDON_END)
+    {
+      if (*idIt - WINDOW_HOME >= (int)m_windowTable.size())
+        m_windowTable.resize(*idIt - WINDOW_HOME + 1, NULL);
+      m_windowTable[*idIt - WINDOW_HOME] = pWindow;
+    }
   }
 }
 
@@ -596,6 +605,8 @@ void CGUIWindowManager::Remove(int id)
     }
 
     m_mapWindows.erase(it);
+    if (id >= WINDOW_HOME && id - WINDOW_HOME < (int)m_windowTable.size())
+      m_windowTable[id - WINDOW_HOME] = NULL;
   }
   else
   {
@@ -935,12 +946,18 @@ bool CGUIWindowManager::Render()
 
   CDirtyRegionList dirtyRegions = m_tracker.GetDirtyRegions();
 
+  m_renderStats.markedRegions = m_tracker.GetMarkedRegions().size();
+  m_renderStats.passes = 0;
+  m_renderStats.coverage = 0;
+
   bool hasRendered = false;
   // If we visualize the regions we will always render the entire viewport
   if (g_advancedSettings.m_guiVisualizeDirtyRegions || g_advancedSettings.m_guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_FILL_VIEWPORT_ALWAYS)
   {
     RenderPass();
     hasRendered = true;
+    m_renderStats.passes = 1;
+    m_renderStats.coverage = 1.0f;
   }
   else if (g_advancedSettings.m_guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_FILL_VIEWPORT_ON_CHANGE)
   {
@@ -948,10 +965,13 @@ bool CGUIWindowManager::Render()
     {
       RenderPass();
       hasRendered = true;
+      m_renderStats.passes = 1;
+      m_renderStats.coverage = 1.0f;
     }
   }
   else
   {
+    float area = 0;
     for (CDirtyRegionList::const_iterator i = dirtyRegions.begin(); i != dirtyRegions.end(); ++i)
     {
       if (i->IsEmpty())
@@ -960,8 +980,15 @@ bool CGUIWindowManager::Render()
       g_graphicsContext.SetScissors(*i);
       RenderPass();
       hasRendered = true;
+      m_renderStats.passes++;
+      area += i->Area();
     }
     g_graphicsContext.ResetScissors();
+
+    // overlapping passes may add up to more than the screen
+    float screen = g_graphicsContext.GetViewWindow().Area();
+    if (screen > 0)
+      m_renderStats.coverage = std::min(area / screen, 1.0f);
   }
 
   if (g_advancedSettings.m_guiVisualizeDirtyRegions)
@@ -1035,11 +1062,16 @@ CGUIWindow* CGUIWindowManager::GetWindow(int id) const
     return window;
 
   CSingleLock lock(g_graphicsContext);
-  WindowMap::const_iterator it = m_mapWindows.find(id);
-  if (it != m_mapWindows.end())
-    window = (*it).second;
+  if (id >= WINDOW_HOME && id <= WINDOW_ADDON_END)
+    window = id - WINDOW_HOME < (int)m_windowTable.size() ? m_windowTable[id - WINDOW_HOME] : NULL;
   else
-    window = NULL;
+  {
+    WindowMap::const_iterator it = m_mapWindows.find(id);
+    if (it != m_mapWindows.end())
+      window = (*it).second;
+    else
+      window = NULL;
+  }
   m_idCache.Set(id, window);
   return window;
 }
@@ -97,6 +97,16 @@ public:
    */
   void AfterRender();
 
+  /*! \brief What the last Render() had to do, for the debug overlay.
+   */
+  struct RenderStats
+  {
+    unsigned int markedRegions; ///< regions marked dirty by the controls
+    unsigned int passes;        ///< render passes, one per scissored region
+    float        coverage;      ///< fraction of the screen that was redrawn
+  };
+  const RenderStats &GetRenderStats() const { return m_renderStats; };
+
   /*! \brief Per-frame updating of the current window and any dialogs
    FrameMove is called every frame to update the current window and any dialogs
    on screen. It should only be called from the application thread.
@@ -170,6 +180,7 @@ private:
 
   typedef std::map<int, CGUIWindow *> WindowMap;
   WindowMap m_mapWindows;
+  std::vector<CGUIWindow *> m_windowTable; ///< direct lookup of the windows in m_mapWindows from WINDOW_HOME to WINDOW_ADDON_END
   std::vector <CGUIWindow*> m_vecCustomWindows;
   std::vector <CGUIWindow*> m_activeDialogs;
   std::vector <CGUIWindow*> m_deleteWindows;
@@ -190,6 +201,7 @@ private:
   bool m_initialized;
 
   CDirtyRegionTracker m_tracker;
+  RenderStats m_renderStats;
 
 private:
   class CGUIWindowManagerIdCache
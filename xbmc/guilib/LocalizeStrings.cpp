@@ -30,6 +30,8 @@
 #include "threads/SingleLock.h"
 #include "utils/StringUtils.h"
 
+#include <algorithm>
+
 CLocalizeStrings::CLocalizeStrings(void)
 {
 
@@ -71,6 +73,7 @@ bool CLocalizeStrings::LoadSkinStrings(const std::string& path, const std::strin
   if (!StringUtils::EqualsNoCase(language, SOURCE_LANGUAGE))
     LoadStr2Mem(path, SOURCE_LANGUAGE, encoding);
 
+  UpdateIndex();
   return true;
 }
 
@@ -227,22 +230,25 @@ bool CLocalizeStrings::Load(const std::string& strPathName, const std::string& s
   m_strings[20210].strTranslated = "yard/s";
   m_strings[20211].strTranslated = "Furlong/Fortnight";
 
+  UpdateIndex();
   return true;
 }
 
 const std::string& CLocalizeStrings::Get(uint32_t dwCode) const
 {
-  ciStrings i = m_strings.find(dwCode);
-  if (i == m_strings.end())
+  // binary search over a flat array of ids, rather than chasing the map's nodes
+  std::vector<uint32_t>::const_iterator i = std::lower_bound(m_indexIds.begin(), m_indexIds.end(), dwCode);
+  if (i == m_indexIds.end() || *i != dwCode)
   {
     return StringUtils::Empty;
   }
-  return i->second.strTranslated;
+  return *m_indexStrings[i - m_indexIds.begin()];
 }
 
 void CLocalizeStrings::Clear()
 {
   m_strings.clear();
+  UpdateIndex();
 }
 
 void CLocalizeStrings::Clear(uint32_t start, uint32_t end)
@@ -255,4 +261,19 @@ void CLocalizeStrings::Clear(uint32_t start, uint32_t end)
     else
       ++it;
   }
+  UpdateIndex();
+}
+
+void CLocalizeStrings::UpdateIndex()
+{
+  m_indexIds.clear();
+  m_indexStrings.clear();
+  m_indexIds.reserve(m_strings.size());
+  m_indexStrings.reserve(m_strings.size());
+  // the map is already sorted by id
+  for (ciStrings it = m_strings.begin(); it != m_strings.end(); ++it)
+  {
+    m_indexIds.push_back(it->first);
+    m_indexStrings.push_back(&it->second.strTranslated);
+  }
 }
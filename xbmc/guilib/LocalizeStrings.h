@@ -33,6 +33,7 @@
 #include <map>
 #include <string>
 #include <stdint.h>
+#include <vector>
 
 /*!
  \ingroup strings
@@ -97,6 +98,14 @@ protected:
   typedef std::map<uint32_t, LocStr>::const_iterator ciStrings;
   typedef std::map<uint32_t, LocStr>::iterator       iStrings;
 
+  /*! \brief Rebuilds the lookup index used by Get() from m_strings.
+   Needs calling whenever m_strings changes.
+   */
+  void UpdateIndex();
+
+  std::vector<uint32_t>            m_indexIds;     ///< sorted ids of m_strings
+  std::vector<const std::string *> m_indexStrings; ///< translated strings of m_indexIds, owned by m_strings
+
   CCriticalSection m_critSection;
 };
 
@@ -318,6 +318,21 @@ bool CBaseTexture::LoadFromMemory(unsigned int width, unsigned int height, unsig
   return true;
 }
 
+bool CBaseTexture::LoadFromTexture(const CBaseTexture &texture)
+{
+  if (texture.m_pixels == NULL)
+    return false;
+
+  Update(texture.m_textureWidth, texture.m_textureHeight, texture.GetPitch(), texture.m_format, texture.m_pixels, false);
+  m_imageWidth = texture.m_imageWidth;
+  m_imageHeight = texture.m_imageHeight;
+  m_originalWidth = texture.m_originalWidth;
+  m_originalHeight = texture.m_originalHeight;
+  m_orientation = texture.m_orientation;
+  m_hasAlpha = texture.m_hasAlpha;
+  return true;
+}
+
 bool CBaseTexture::LoadPaletted(unsigned int width, unsigned int height, unsigned int pitch, unsigned int format, const unsigned char *pixels, const COLOR *palette)
 {
   if (pixels == NULL || palette == NULL)
@@ -73,6 +73,11 @@ public:
                                             unsigned int idealWidth = 0, unsigned int idealHeight = 0);
 
   bool LoadFromMemory(unsigned int width, unsigned int height, unsigned int pitch, unsigned int format, bool hasAlpha, unsigned char* pixels);
+  /*! \brief Copy the pixels, sizes and orientation of a texture that still has its pixels
+   \param texture the texture to copy.
+   \return true if the texture was copied, false if it has no pixels.
+   */
+  bool LoadFromTexture(const CBaseTexture &texture);
   bool LoadPaletted(unsigned int width, unsigned int height, unsigned int pitch, unsigned int format, const unsigned char *pixels, const COLOR *palette);
 
   bool HasAlpha() const;
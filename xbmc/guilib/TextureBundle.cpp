@@ -103,6 +103,12 @@ int CTextureBundle::LoadAnim(const std::string& Filename, CBaseTexture*** ppText
   }
 }
 
+void CTextureBundle::Prefetch(const std::vector<std::string> &textures)
+{
+  if (m_useXBT)
+    m_tbXBT.Prefetch(textures);
+}
+
 void CTextureBundle::Cleanup()
 {
   m_tbXBT.Cleanup();
@@ -33,12 +33,160 @@
 #include "XBTF.h"
 #include <lzo/lzo1x.h>
 #include "utils/StringUtils.h"
+#include "utils/Job.h"
+#include "utils/JobManager.h"
+#include "threads/Condition.h"
+#include "threads/SingleLock.h"
 
 #ifdef TARGET_WINDOWS
 #pragma comment(lib,"liblzo2.lib")
 #endif
 
+/*! \brief Textures unpacked ahead of their LoadTexture()
+ Shared with the jobs doing the unpacking, so a job that only runs once the
+ bundle is gone finds nothing left to do. Jobs read from the mapping of the
+ bundle, so Clear() waits for the running ones before it may be unmapped.
+ */
+class CTextureBundleXBT::CPrefetchQueue
+{
+public:
+  CPrefetchQueue() : m_running(0) {}
+  ~CPrefetchQueue() { Clear(); }
+
+  bool Add(const std::string &name, const unsigned char *packed, const CXBTFFrame &frame)
+  {
+    CSingleLock lock(m_section);
+    if (m_entries.find(name) != m_entries.end())
+      return false;
+
+    CEntry &entry = m_entries[name];
+    entry.state = QUEUED;
+    entry.packed = packed;
+    entry.packedSize = (lzo_uint)frame.GetPackedSize();
+    entry.unpackedSize = (lzo_uint)frame.GetUnpackedSize();
+    entry.unpacked = NULL;
+    return true;
+  }
+
+  void Unpack(const std::string &name)
+  {
+    CSingleLock lock(m_section);
+    std::map<std::string, CEntry>::iterator it = m_entries.find(name);
+    if (it == m_entries.end() || it->second.state != QUEUED)
+      return;
+    it->second.state = RUNNING;
+    m_running++;
+    CEntry entry = it->second;
+    lock.Leave();
+
+    unsigned char *unpacked = new unsigned char[entry.unpackedSize];
+    lzo_uint size = entry.unpackedSize;
+    if (lzo1x_decompress_safe(entry.packed, entry.packedSize, unpacked, &size, NULL) != LZO_E_OK ||
+        size != entry.unpackedSize)
+    {
+      delete[] unpacked;
+      unpacked = NULL;
+    }
+
+    // running entries are never removed, only waited for
+    lock.Enter();
+    it = m_entries.find(name);
+    it->second.unpacked = unpacked;
+    it->second.state = DONE;
+    m_running--;
+    m_done.notifyAll();
+  }
+
+  /*! \brief Take the unpacked pixels of a prefetched texture
+   Waits for the texture if it is being unpacked. One that hasn't been
+   started yet is taken off the queue and left to the caller.
+   \return the unpacked pixels to be delete[]d by the caller, NULL if there are none
+   */
+  unsigned char *Take(const std::string &name)
+  {
+    CSingleLock lock(m_section);
+    std::map<std::string, CEntry>::iterator it = m_entries.find(name);
+    while (it != m_entries.end() && it->second.state == RUNNING)
+    {
+      m_done.wait(lock);
+      it = m_entries.find(name);
+    }
+    if (it == m_entries.end())
+      return NULL;
+
+    unsigned char *unpacked = it->second.unpacked;
+    m_entries.erase(it);
+    return unpacked;
+  }
+
+  /*! \brief Drop the textures that haven't been taken, leaving the running ones to finish */
+  void Drop()
+  {
+    CSingleLock lock(m_section);
+    DropUnused();
+  }
+
+  /*! \brief Drop all textures, waiting for the running ones */
+  void Clear()
+  {
+    CSingleLock lock(m_section);
+    DropUnused();
+    while (m_running)
+      m_done.wait(lock);
+    DropUnused();
+  }
+
+private:
+  enum STATE { QUEUED, RUNNING, DONE };
+  struct CEntry
+  {
+    STATE state;
+    const unsigned char *packed;
+    lzo_uint packedSize;
+    lzo_uint unpackedSize;
+    unsigned char *unpacked;
+  };
+
+  void DropUnused()
+  {
+    for (std::map<std::string, CEntry>::iterator it = m_entries.begin(); it != m_entries.end();)
+    {
+      if (it->second.state == RUNNING)
+        ++it;
+      else
+      {
+        delete[] it->second.unpacked;
+        m_entries.erase(it++);
+      }
+    }
+  }
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_done;
+  std::map<std::string, CEntry> m_entries;
+  unsigned int m_running;
+};
+
+class CTextureBundleXBT::CPrefetchJob : public CJob
+{
+public:
+  CPrefetchJob(const std::shared_ptr<CPrefetchQueue> &queue, const std::string &name)
+    : m_queue(queue), m_name(name) {}
+
+  virtual bool DoWork()
+  {
+    m_queue->Unpack(m_name);
+    return true;
+  }
+  virtual const char *GetType() const { return "texturebundleprefetch"; }
+
+private:
+  std::shared_ptr<CPrefetchQueue> m_queue;
+  std::string m_name;
+};
+
 CTextureBundleXBT::CTextureBundleXBT(void)
+  : m_prefetch(new CPrefetchQueue)
 {
   m_themeBundle = false;
   m_TimeStamp = 0;
@@ -146,7 +294,7 @@ bool CTextureBundleXBT::LoadTexture(const std::string& Filename, CBaseTexture**
     return false;
 
   CXBTFFrame& frame = file->GetFrames().at(0);
-  if (!ConvertFrameToTexture(Filename, frame, ppTexture))
+  if (!ConvertFrameToTexture(Filename, frame, ppTexture, m_prefetch->Take(name)))
   {
     return false;
   }
@@ -192,22 +340,58 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename, CBaseTexture*** ppT
   return nTextures;
 }
 
-bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture)
+void CTextureBundleXBT::Prefetch(const std::vector<std::string> &textures)
 {
-  // found texture - allocate the necessary buffers
-  squish::u8 *buffer = new squish::u8[(size_t)frame.GetPackedSize()];
-  if (buffer == NULL)
+  m_prefetch->Drop();
+
+  for (std::vector<std::string>::const_iterator it = textures.begin(); it != textures.end(); ++it)
   {
-    CLog::Log(LOGERROR, "Out of memory loading texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetPackedSize());
-    return false;
+    std::string name = Normalize(*it);
+    CXBTFFile* file = m_XBTFReader.Find(name);
+    if (!file || file->GetFrames().size() != 1)
+      continue;
+
+    const CXBTFFrame& frame = file->GetFrames().at(0);
+    const unsigned char *packed = m_XBTFReader.GetData(frame);
+    if (!packed || !frame.IsPacked())
+      continue;
+
+    if (m_prefetch->Add(name, packed, frame))
+      CJobManager::GetInstance().AddJob(new CPrefetchJob(m_prefetch, name), NULL, CJob::PRIORITY_NORMAL);
+  }
+}
+
+bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture, unsigned char *unpacked /* = NULL */)
+{
+  if (unpacked)
+  { // unpacked by Prefetch() already
+    *ppTexture = new CTexture();
+    (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), unpacked);
+    delete[] unpacked;
+    return true;
   }
 
-  // load the compressed texture
-  if (!m_XBTFReader.Load(frame, buffer))
+  // if the bundle is memory mapped we can unpack straight from it
+  const squish::u8 *packed = m_XBTFReader.GetData(frame);
+  squish::u8 *buffer = NULL;
+  if (!packed)
   {
-    CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
-    delete[] buffer;
-    return false;
+    // found texture - allocate the necessary buffers
+    buffer = new squish::u8[(size_t)frame.GetPackedSize()];
+    if (buffer == NULL)
+    {
+      CLog::Log(LOGERROR, "Out of memory loading texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetPackedSize());
+      return false;
+    }
+
+    // load the compressed texture
+    if (!m_XBTFReader.Load(frame, buffer))
+    {
+      CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
+      delete[] buffer;
+      return false;
+    }
+    packed = buffer;
   }
 
   // check if it's packed with lzo
@@ -221,7 +405,7 @@ bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFram
       return false;
     }
     lzo_uint s = (lzo_uint)frame.GetUnpackedSize();
-    if (lzo1x_decompress_safe(buffer, (lzo_uint)frame.GetPackedSize(), unpacked, &s, NULL) != LZO_E_OK ||
+    if (lzo1x_decompress_safe(packed, (lzo_uint)frame.GetPackedSize(), unpacked, &s, NULL) != LZO_E_OK ||
         s != frame.GetUnpackedSize())
     {
       CLog::Log(LOGERROR, "Error loading texture: %s: Decompression error", name.c_str());
@@ -231,11 +415,12 @@ bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFram
     }
     delete[] buffer;
     buffer = unpacked;
+    packed = buffer;
   }
 
-  // create an xbmc texture
+  // create an xbmc texture (this copies the pixels)
   *ppTexture = new CTexture();
-  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), buffer);
+  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), const_cast<squish::u8*>(packed));
 
   delete[] buffer;
 
@@ -244,6 +429,9 @@ bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFram
 
 void CTextureBundleXBT::Cleanup()
 {
+  // the prefetch jobs unpack from the bundle's mapping
+  m_prefetch->Clear();
+
   if (m_XBTFReader.IsOpen())
   {
     m_XBTFReader.Close();
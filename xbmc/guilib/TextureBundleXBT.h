@@ -21,6 +21,7 @@
  */
 
 #include <map>
+#include <memory>
 #include <string>
 #include "XBTFReader.h"
 
@@ -44,12 +45,25 @@ public:
   int LoadAnim(const std::string& Filename, CBaseTexture*** ppTextures,
                 int &width, int &height, int& nLoops, int** ppDelays);
 
+  /*! \brief Unpack textures on worker threads ahead of their LoadTexture()
+   Only lzo packed single frame textures of a memory mapped bundle are
+   unpacked, as the stdio path shares one FILE. Textures of an earlier call
+   that haven't been loaded since are dropped.
+   \param textures names of the textures, as passed to LoadTexture()
+   */
+  void Prefetch(const std::vector<std::string> &textures);
+
 private:
+  class CPrefetchQueue;
+  class CPrefetchJob;
+
   bool OpenBundle();
-  bool ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture);
+  bool ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture, unsigned char *unpacked = NULL);
 
   time_t m_TimeStamp;
 
+  std::shared_ptr<CPrefetchQueue> m_prefetch;
+
   bool m_themeBundle;
   CXBTFReader m_XBTFReader;
 };
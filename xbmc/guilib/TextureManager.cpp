@@ -35,6 +35,7 @@
 #include "filesystem/Directory.h"
 #include "URL.h"
 #include <assert.h>
+#include <set>
 
 #if defined(TARGET_DARWIN_IOS) && !defined(TARGET_DARWIN_IOS_ATV2)
 #include "windowing/WindowingFactory.h" // for g_Windowing in CGUITextureManager::FreeUnusedTextures
@@ -428,6 +429,38 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
 }
 
 
+void CGUITextureManager::Prefetch(const std::vector<std::string> &textures)
+{
+  CSingleLock lock(g_graphicsContext);
+
+  std::set<std::string> names(textures.begin(), textures.end());
+  for (ivecTextures i = m_vecTextures.begin(); i != m_vecTextures.end(); ++i)
+    names.erase((*i)->GetName());
+  for (ilistUnused i = m_unusedTextures.begin(); i != m_unusedTextures.end(); ++i)
+    names.erase(i->first->GetName());
+
+  // only bundled textures, and not the animated ones
+  std::vector<std::string> bundled[2];
+  for (std::set<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+  {
+    if (!CanLoad(*it) || StringUtils::EndsWithNoCase(*it, ".gif"))
+      continue;
+
+    std::string bundledName = CTextureBundle::Normalize(*it);
+    for (int i = 0; i < 2; i++)
+    {
+      if (m_TexBundle[i].HasFile(bundledName))
+      {
+        bundled[i].push_back(*it);
+        break;
+      }
+    }
+  }
+
+  for (int i = 0; i < 2; i++)
+    m_TexBundle[i].Prefetch(bundled[i]);
+}
+
 void CGUITextureManager::ReleaseTexture(const std::string& strTextureName, bool immediately /*= false */)
 {
   CSingleLock lock(g_graphicsContext);
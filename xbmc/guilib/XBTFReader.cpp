@@ -28,7 +28,12 @@
 #endif
 
 #include <string.h>
+#include <algorithm>
 #include "PlatformDefs.h"
+#if defined(TARGET_POSIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #define READ_STR(str, size, file) \
   if (1 != fread(str, size, 1, file)) \
@@ -44,9 +49,30 @@
     return false; \
   i = Endian_SwapLE64(i);
 
+namespace
+{
+class CPathLess
+{
+public:
+  CPathLess(std::vector<CXBTFFile>& files) : m_files(files) {}
+  bool operator()(size_t lhs, size_t rhs) const
+  {
+    return strcmp(m_files[lhs].GetPath(), m_files[rhs].GetPath()) < 0;
+  }
+  bool operator()(size_t lhs, const std::string& rhs) const
+  {
+    return strcmp(m_files[lhs].GetPath(), rhs.c_str()) < 0;
+  }
+private:
+  std::vector<CXBTFFile>& m_files;
+};
+}
+
 CXBTFReader::CXBTFReader()
 {
   m_file = NULL;
+  m_mapped = NULL;
+  m_mappedSize = 0;
 }
 
 bool CXBTFReader::IsOpen() const
@@ -124,8 +150,6 @@ bool CXBTFReader::Open(const std::string& fileName)
     }
 
     m_xbtf.GetFiles().push_back(file);
-
-    m_filesMap[file.GetPath()] = file;
   }
 
   // Sanity check
@@ -136,11 +160,33 @@ bool CXBTFReader::Open(const std::string& fileName)
     return false;
   }
 
+  // build a sorted index rather than a map so lookups don't need a copy of every file entry
+  std::vector<CXBTFFile>& files = m_xbtf.GetFiles();
+  m_index.resize(files.size());
+  for (size_t i = 0; i < files.size(); i++)
+    m_index[i] = i;
+  std::stable_sort(m_index.begin(), m_index.end(), CPathLess(files));
+
+  // a path that is in the bundle more than once resolves to its last entry
+  std::vector<size_t>::iterator last = m_index.begin();
+  for (std::vector<size_t>::const_iterator i = m_index.begin(); i != m_index.end(); ++i)
+  {
+    if (last != m_index.begin() && strcmp(files[*(last - 1)].GetPath(), files[*i].GetPath()) == 0)
+      *(last - 1) = *i;
+    else
+      *last++ = *i;
+  }
+  m_index.erase(last, m_index.end());
+
+  Map();
+
   return true;
 }
 
 void CXBTFReader::Close()
 {
+  Unmap();
+
   if (m_file)
   {
     fclose(m_file);
@@ -148,7 +194,33 @@ void CXBTFReader::Close()
   }
 
   m_xbtf.GetFiles().clear();
-  m_filesMap.clear();
+  m_index.clear();
+}
+
+void CXBTFReader::Map()
+{
+#if defined(TARGET_POSIX)
+  struct stat fileStat;
+  if (fstat(fileno(m_file), &fileStat) == -1 || fileStat.st_size <= 0)
+    return;
+
+  void* mapped = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_SHARED, fileno(m_file), 0);
+  if (mapped == MAP_FAILED)
+    return;
+
+  m_mapped = (unsigned char*)mapped;
+  m_mappedSize = fileStat.st_size;
+#endif
+}
+
+void CXBTFReader::Unmap()
+{
+#if defined(TARGET_POSIX)
+  if (m_mapped)
+    munmap(m_mapped, (size_t)m_mappedSize);
+#endif
+  m_mapped = NULL;
+  m_mappedSize = 0;
 }
 
 time_t CXBTFReader::GetLastModificationTimestamp()
@@ -174,13 +246,25 @@ bool CXBTFReader::Exists(const std::string& name)
 
 CXBTFFile* CXBTFReader::Find(const std::string& name)
 {
-  std::map<std::string, CXBTFFile>::iterator iter = m_filesMap.find(name);
-  if (iter == m_filesMap.end())
+  std::vector<CXBTFFile>& files = m_xbtf.GetFiles();
+  std::vector<size_t>::const_iterator iter = std::lower_bound(m_index.begin(), m_index.end(), name, CPathLess(files));
+  if (iter == m_index.end() || name != files[*iter].GetPath())
+  {
+    return NULL;
+  }
+
+  return &files[*iter];
+}
+
+const unsigned char* CXBTFReader::GetData(const CXBTFFrame& frame) const
+{
+  if (!m_mapped || frame.GetOffset() > m_mappedSize ||
+      frame.GetPackedSize() > m_mappedSize - frame.GetOffset())
   {
     return NULL;
   }
 
-  return &(iter->second);
+  return m_mapped + frame.GetOffset();
 }
 
 bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer)
@@ -189,6 +273,13 @@ bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer)
   {
     return false;
   }
+
+  const unsigned char* data = GetData(frame);
+  if (data)
+  {
+    memcpy(buffer, data, (size_t)frame.GetPackedSize());
+    return true;
+  }
 #if defined(TARGET_DARWIN) || defined(TARGET_FREEBSD) || defined(TARGET_ANDROID)
     if (fseeko(m_file, (off_t)frame.GetOffset(), SEEK_SET) == -1)
 #else
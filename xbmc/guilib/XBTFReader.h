@@ -22,7 +22,6 @@
 #define XBTFREADER_H_
 
 #include <vector>
-#include <map>
 #include <string>
 #include "XBTF.h"
 
@@ -37,13 +36,25 @@ public:
   bool Exists(const std::string& name);
   CXBTFFile* Find(const std::string& name);
   bool Load(const CXBTFFrame& frame, unsigned char* buffer);
+
+  /*! \brief Get the (packed) data of a frame without copying it.
+   \param frame the frame to look up.
+   \return pointer into the memory mapped bundle, or NULL if the bundle isn't mapped
+   (in which case Load() must be used).
+   */
+  const unsigned char* GetData(const CXBTFFrame& frame) const;
   std::vector<CXBTFFile>&  GetFiles();
 
 private:
+  void Map();
+  void Unmap();
+
   CXBTF      m_xbtf;
   std::string m_fileName;
   FILE*      m_file;
-  std::map<std::string, CXBTFFile> m_filesMap;
+  unsigned char* m_mapped;
+  uint64_t   m_mappedSize;
+  std::vector<size_t> m_index; ///< indices into m_xbtf.GetFiles(), sorted by path
 };
 
 #endif
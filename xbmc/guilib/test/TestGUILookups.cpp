@@ -0,0 +1,339 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * The lookups the GUI makes every frame, checked against the data they are
+ * built from.
+ *
+ * Confluence's Home.xml is turned into a tree of control groups and plain
+ * controls with the ids of the real ones, the English and Confluence strings
+ * are loaded and a window manager is filled with a window for each of the
+ * ids from WINDOW_HOME on, plus some outside its direct table. Each lookup
+ * of CGUIControlGroup, CLocalizeStrings and CGUIWindowManager must then give
+ * what a plain search of that data would.
+ *
+ * DISABLED_Benchmark times about a frame's worth of those lookups.
+ */
+
+#include "guilib/GUIControlGroup.h"
+#include "guilib/GUIWindow.h"
+#include "guilib/GUIWindowManager.h"
+#include "guilib/LocalizeStrings.h"
+#include "guilib/WindowIDs.h"
+#include "test/TestUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+#include <set>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+
+#define BENCHMARK_FRAMES  1000
+#define BENCHMARK_WINDOWS 150
+
+namespace
+{
+  /* A control that does nothing but take up an id. */
+  class CTestControl : public CGUIControl
+  {
+  public:
+    CTestControl(int parentID, int controlID) : CGUIControl(parentID, controlID, 0, 0, 0, 0) {}
+    virtual CTestControl *Clone() const { return new CTestControl(*this); }
+  };
+
+  void AddLocalizeIds(const std::string &text, std::set<uint32_t> &ids)
+  {
+    if (!text.empty() && StringUtils::IsNaturalNumber(text))
+    {
+      ids.insert(atoi(text.c_str()));
+      return;
+    }
+    for (size_t pos = text.find("$LOCALIZE["); pos != std::string::npos; pos = text.find("$LOCALIZE[", pos))
+    {
+      pos += 10;
+      ids.insert(atoi(text.c_str() + pos));
+    }
+  }
+
+  void CollectLocalizeIds(const TiXmlElement *element, std::set<uint32_t> &ids)
+  {
+    for (const TiXmlElement *child = element->FirstChildElement(); child; child = child->NextSiblingElement())
+    {
+      if (child->FirstChild() && child->FirstChild()->Type() == TiXmlNode::TINYXML_TEXT)
+        AddLocalizeIds(child->FirstChild()->ValueStr(), ids);
+      CollectLocalizeIds(child, ids);
+    }
+  }
+
+  /* Add the controls below the given element to the group, in the same
+   * order and with the same ids as the window loader would. Layouts of
+   * lists aren't part of the window's lookup, so only groups are descended.
+   * The controls with an id are added to controls in the order the lookup
+   * of the group keeps them: those of a group come before the group itself.
+   */
+  void AddControls(const TiXmlElement *element, CGUIControlGroup *group, std::vector<CGUIControl *> &controls)
+  {
+    for (const TiXmlElement *child = element->FirstChildElement(); child; child = child->NextSiblingElement())
+    {
+      if (child->ValueStr() == "controls")
+      {
+        AddControls(child, group, controls);
+        continue;
+      }
+      if (child->ValueStr() != "control")
+        continue;
+
+      int id = 0;
+      child->QueryIntAttribute("id", &id);
+
+      CGUIControl *control;
+      const char *type = child->Attribute("type");
+      if (type && (strcmp(type, "group") == 0 || strcmp(type, "grouplist") == 0))
+      {
+        CGUIControlGroup *subGroup = new CGUIControlGroup(group->GetID(), id, 0, 0, 0, 0);
+        AddControls(child, subGroup, controls);
+        control = subGroup;
+      }
+      else
+        control = new CTestControl(group->GetID(), id);
+      group->AddControl(control);
+      if (id)
+        controls.push_back(control);
+    }
+  }
+
+  /* The strings a lookup of m_strings gives. */
+  class CTestStrings : public CLocalizeStrings
+  {
+  public:
+    const std::string &Find(uint32_t code) const
+    {
+      static const std::string empty;
+      ciStrings it = m_strings.find(code);
+      return it != m_strings.end() ? it->second.strTranslated : empty;
+    }
+
+    std::vector<uint32_t> GetIds() const
+    {
+      std::vector<uint32_t> ids;
+      for (ciStrings it = m_strings.begin(); it != m_strings.end(); ++it)
+        ids.push_back(it->first);
+      return ids;
+    }
+  };
+
+  class TestGUILookups : public testing::Test
+  {
+  protected:
+    TestGUILookups() : m_window(WINDOW_HOME, "Home.xml") {}
+
+    virtual void SetUp()
+    {
+      CXBMCTinyXML doc;
+      ASSERT_TRUE(doc.LoadFile(XBMC_REF_FILE_PATH("addons/skin.confluence/720p/Home.xml")));
+      ASSERT_TRUE(doc.RootElement() != NULL);
+
+      AddControls(doc.RootElement(), &m_window, m_controls);
+      ASSERT_FALSE(m_controls.empty());
+      for (std::vector<CGUIControl *>::const_iterator it = m_controls.begin(); it != m_controls.end(); ++it)
+        m_controlIds.push_back((*it)->GetID());
+
+      std::set<uint32_t> localizeIds;
+      CollectLocalizeIds(doc.RootElement(), localizeIds);
+      m_localizeIds.assign(localizeIds.begin(), localizeIds.end());
+
+      ASSERT_TRUE(m_strings.Load(XBMC_REF_FILE_PATH("language/"), "English"));
+      ASSERT_TRUE(m_strings.LoadSkinStrings(XBMC_REF_FILE_PATH("addons/skin.confluence/language/"), "English"));
+
+      for (int id = WINDOW_HOME; id < WINDOW_HOME + BENCHMARK_WINDOWS; id++)
+        m_windowIds.push_back(id);
+      // ids outside the direct table of the window manager
+      m_windowIds.push_back(WINDOW_HOME - 100);
+      m_windowIds.push_back(WINDOW_ADDON_END + 1);
+      m_windowIds.push_back(WINDOW_ADDON_END + 1000);
+      for (std::vector<int>::const_iterator it = m_windowIds.begin(); it != m_windowIds.end(); ++it)
+        m_windowManager.Add(new CGUIWindow(*it, ""));
+    }
+
+    virtual void TearDown()
+    {
+      for (std::vector<int>::const_iterator it = m_windowIds.begin(); it != m_windowIds.end(); ++it)
+      {
+        CGUIWindow *window = m_windowManager.GetWindow(*it);
+        m_windowManager.Remove(*it);
+        delete window;
+      }
+    }
+
+    /* The control a lookup of the given id should give: the first visible one
+       of that id in lookup order, else the first one of that id. */
+    CGUIControl *FindControl(int id) const
+    {
+      CGUIControl *potential = NULL;
+      for (std::vector<CGUIControl *>::const_iterator it = m_controls.begin(); it != m_controls.end(); ++it)
+      {
+        if ((*it)->GetID() != id)
+          continue;
+        if ((*it)->IsVisible())
+          return *it;
+        if (!potential)
+          potential = *it;
+      }
+      return potential;
+    }
+
+    CGUIWindow m_window;
+    std::vector<CGUIControl *> m_controls; ///< controls of m_window with an id, in lookup order
+    std::vector<int> m_controlIds;
+    std::vector<uint32_t> m_localizeIds;
+    CTestStrings m_strings;
+    CGUIWindowManager m_windowManager;
+    std::vector<int> m_windowIds;
+  };
+
+  double ToNanoseconds(int64_t ticks)
+  {
+    return CXBMCTestUtils::TicksToMilliseconds(ticks) * 1000000.0;
+  }
+}
+
+TEST_F(TestGUILookups, DuplicateIds)
+{
+  CGUIWindow window(WINDOW_HOME, "Home.xml");
+  CGUIControl *hidden = new CTestControl(WINDOW_HOME, 10);
+  CGUIControl *visible = new CTestControl(WINDOW_HOME, 10);
+  hidden->SetVisible(false);
+  window.AddControl(hidden);
+  window.AddControl(visible);
+
+  // the first visible control of a given id wins
+  EXPECT_EQ(visible, window.GetControl(10));
+  visible->SetVisible(false);
+  EXPECT_EQ(hidden, window.GetControl(10));
+
+  // controls of a group added later come after the ones already there
+  CGUIControlGroup *group = new CGUIControlGroup(WINDOW_HOME, 20, 0, 0, 0, 0);
+  CGUIControl *nested = new CTestControl(WINDOW_HOME, 10);
+  group->AddControl(nested);
+  window.AddControl(group);
+  EXPECT_EQ(nested, window.GetControl(10));
+  EXPECT_EQ(group, window.GetControl(20));
+  EXPECT_TRUE(window.GetControl(30) == NULL);
+}
+
+TEST_F(TestGUILookups, Controls)
+{
+  for (std::vector<int>::const_iterator it = m_controlIds.begin(); it != m_controlIds.end(); ++it)
+    EXPECT_EQ(FindControl(*it), m_window.GetControl(*it)) << "id " << *it;
+
+  // hiding the control found for an id gives the next one of that id
+  std::set<int> hidden;
+  for (std::vector<int>::const_iterator it = m_controlIds.begin(); it != m_controlIds.end(); ++it)
+  {
+    if (!hidden.insert(*it).second)
+      continue;
+    FindControl(*it)->SetVisible(false);
+    EXPECT_EQ(FindControl(*it), m_window.GetControl(*it)) << "id " << *it;
+  }
+
+  EXPECT_TRUE(m_window.GetControl(-1) == NULL);
+  EXPECT_TRUE(m_window.GetControl(1000000) == NULL);
+}
+
+TEST_F(TestGUILookups, Strings)
+{
+  std::vector<uint32_t> ids = m_strings.GetIds();
+  ASSERT_FALSE(ids.empty());
+  for (std::vector<uint32_t>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+  {
+    EXPECT_EQ(m_strings.Find(*it), m_strings.Get(*it)) << "id " << *it;
+    // and the ids in between that aren't there
+    EXPECT_EQ(m_strings.Find(*it + 1), m_strings.Get(*it + 1)) << "id " << *it + 1;
+  }
+  for (std::vector<uint32_t>::const_iterator it = m_localizeIds.begin(); it != m_localizeIds.end(); ++it)
+    EXPECT_EQ(m_strings.Find(*it), m_strings.Get(*it)) << "id " << *it;
+  EXPECT_TRUE(m_strings.Get(0xffffffff).empty());
+
+  // the index follows the skin strings being cleared
+  m_strings.ClearSkinStrings();
+  for (std::vector<uint32_t>::const_iterator it = m_localizeIds.begin(); it != m_localizeIds.end(); ++it)
+    EXPECT_EQ(m_strings.Find(*it), m_strings.Get(*it)) << "id " << *it;
+}
+
+TEST_F(TestGUILookups, Windows)
+{
+  for (std::vector<int>::const_iterator it = m_windowIds.begin(); it != m_windowIds.end(); ++it)
+  {
+    CGUIWindow *window = m_windowManager.GetWindow(*it);
+    ASSERT_TRUE(window != NULL) << "id " << *it;
+    EXPECT_EQ(*it, window->GetID());
+  }
+  EXPECT_TRUE(m_windowManager.GetWindow(WINDOW_HOME + BENCHMARK_WINDOWS) == NULL);
+  EXPECT_TRUE(m_windowManager.GetWindow(WINDOW_ADDON_END) == NULL);
+  EXPECT_TRUE(m_windowManager.GetWindow(WINDOW_ADDON_END + 2) == NULL);
+
+  // a removed window is gone from the table as well
+  CGUIWindow *window = m_windowManager.GetWindow(WINDOW_HOME + 1);
+  m_windowManager.Remove(WINDOW_HOME + 1);
+  EXPECT_TRUE(m_windowManager.GetWindow(WINDOW_HOME + 1) == NULL);
+  m_windowManager.Add(window);
+  EXPECT_EQ(window, m_windowManager.GetWindow(WINDOW_HOME + 1));
+}
+
+TEST_F(TestGUILookups, DISABLED_Benchmark)
+{
+  int64_t controlTicks = 0, stringTicks = 0, windowTicks = 0;
+  unsigned int found = 0;
+  for (int frame = 0; frame < BENCHMARK_FRAMES; frame++)
+  {
+    int64_t start = CurrentHostCounter();
+    for (std::vector<int>::const_iterator it = m_controlIds.begin(); it != m_controlIds.end(); ++it)
+      found += m_window.GetControl(*it) ? 1 : 0;
+    int64_t controlsDone = CurrentHostCounter();
+    for (std::vector<uint32_t>::const_iterator it = m_localizeIds.begin(); it != m_localizeIds.end(); ++it)
+      found += m_strings.Get(*it).empty() ? 0 : 1;
+    int64_t stringsDone = CurrentHostCounter();
+    for (std::vector<int>::const_iterator it = m_windowIds.begin(); it != m_windowIds.end(); ++it)
+      found += m_windowManager.GetWindow(*it) ? 1 : 0;
+    int64_t windowsDone = CurrentHostCounter();
+
+    controlTicks += controlsDone - start;
+    stringTicks += stringsDone - controlsDone;
+    windowTicks += windowsDone - stringsDone;
+  }
+
+  EXPECT_GE(found, (unsigned int)(m_controlIds.size() + m_windowIds.size()) * BENCHMARK_FRAMES);
+
+  double controlNs = ToNanoseconds(controlTicks) / ((double)m_controlIds.size() * BENCHMARK_FRAMES);
+  double stringNs = m_localizeIds.empty() ? 0 : ToNanoseconds(stringTicks) / ((double)m_localizeIds.size() * BENCHMARK_FRAMES);
+  double windowNs = ToNanoseconds(windowTicks) / ((double)m_windowIds.size() * BENCHMARK_FRAMES);
+  double frameNs = ToNanoseconds(controlTicks + stringTicks + windowTicks) / BENCHMARK_FRAMES;
+
+  XBMC_RECORD_BENCHMARK("ControlIds", m_controlIds.size(), "");
+  XBMC_RECORD_BENCHMARK("ControlLookupNs", controlNs, "ns");
+  XBMC_RECORD_BENCHMARK("StringIds", m_localizeIds.size(), "");
+  XBMC_RECORD_BENCHMARK("StringLookupNs", stringNs, "ns");
+  XBMC_RECORD_BENCHMARK("WindowIds", m_windowIds.size(), "");
+  XBMC_RECORD_BENCHMARK("WindowLookupNs", windowNs, "ns");
+  XBMC_RECORD_BENCHMARK("FrameLookupNs", frameNs, "ns");
+}
@@ -0,0 +1,155 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * The .dds copies CTextureDDSJob makes of cached textures.
+ *
+ * Confluence's tv.jpg, a 1280x720 background, is decoded the way
+ * CImageLoader loads a cached texture, then compressed the way
+ * CTextureDDSJob does it. Its copy has to read back block compressed at the
+ * same size, and in fewer bytes than the decoded jpg. An image that doesn't
+ * compress well enough is stored as ARGB instead, which the job then drops.
+ *
+ * DISABLED_Benchmark times decoding the jpg against reading the .dds, both
+ * straight and decompressed as a GPU without DXT support gets it. Uploading
+ * to the GPU needs a rendering context, so it isn't covered.
+ */
+
+#include "filesystem/File.h"
+#include "guilib/DDSImage.h"
+#include "guilib/Texture.h"
+#include "guilib/XBTF.h"
+#include "test/TestUtils.h"
+#include "utils/TimeUtils.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#define BENCHMARK_LOADS 20
+
+TEST(TestTextureCompression, RoundTrip)
+{
+  CBaseTexture *texture = CBaseTexture::LoadFromFile(XBMC_REF_FILE_PATH("addons/skin.confluence/backgrounds/tv.jpg"));
+  ASSERT_TRUE(texture != NULL);
+  unsigned int width = texture->GetWidth(), height = texture->GetHeight();
+  unsigned int decodedSize = texture->GetPitch() * texture->GetRows();
+
+  XFILE::CFile *file = XBMC_CREATETEMPFILE(".dds");
+  ASSERT_TRUE(file != NULL);
+  std::string ddsPath = XBMC_TEMPFILEPATH(file);
+
+  CDDSImage dds;
+  EXPECT_TRUE(dds.Create(ddsPath, width, height, texture->GetPitch(), texture->GetPixels(), 40));
+  delete texture;
+
+  CDDSImage compressed;
+  ASSERT_TRUE(compressed.ReadFile(ddsPath));
+  EXPECT_EQ(width, compressed.GetWidth());
+  EXPECT_EQ(height, compressed.GetHeight());
+  EXPECT_NE(0U, compressed.GetFormat() & XB_FMT_DXT_MASK);
+  EXPECT_LT(compressed.GetSize(), decodedSize);
+
+  // as a GPU without DXT support gets it
+  CBaseTexture *decompressed = CBaseTexture::LoadFromFile(ddsPath);
+  ASSERT_TRUE(decompressed != NULL);
+  EXPECT_EQ(width, decompressed->GetWidth());
+  EXPECT_EQ(height, decompressed->GetHeight());
+  delete decompressed;
+
+  XBMC_DELETETEMPFILE(file);
+}
+
+TEST(TestTextureCompression, NoiseStaysUncompressed)
+{
+  const unsigned int width = 64, height = 64;
+  std::vector<unsigned char> pixels(width * height * 4);
+  unsigned int random = 12345;
+  for (unsigned int i = 0; i < pixels.size(); i++)
+  {
+    random = random * 1103515245 + 12345;
+    pixels[i] = (i % 4 == 3) ? 0xff : (unsigned char)(random >> 16);
+  }
+
+  XFILE::CFile *file = XBMC_CREATETEMPFILE(".dds");
+  ASSERT_TRUE(file != NULL);
+  std::string ddsPath = XBMC_TEMPFILEPATH(file);
+
+  CDDSImage dds;
+  EXPECT_TRUE(dds.Create(ddsPath, width, height, width * 4, &pixels[0], 1));
+
+  CDDSImage argb;
+  ASSERT_TRUE(argb.ReadFile(ddsPath));
+  EXPECT_EQ(width, argb.GetWidth());
+  EXPECT_EQ(height, argb.GetHeight());
+  EXPECT_EQ(0U, argb.GetFormat() & XB_FMT_DXT_MASK);
+  EXPECT_EQ(width * height * 4, argb.GetSize());
+
+  XBMC_DELETETEMPFILE(file);
+}
+
+TEST(TestTextureCompression, DISABLED_Benchmark)
+{
+  std::string image = XBMC_REF_FILE_PATH("addons/skin.confluence/backgrounds/tv.jpg");
+
+  int64_t start = CurrentHostCounter();
+  for (int i = 0; i < BENCHMARK_LOADS; i++)
+    delete CBaseTexture::LoadFromFile(image);
+  double decodeTime = CXBMCTestUtils::TicksToMilliseconds(CurrentHostCounter() - start) / BENCHMARK_LOADS;
+
+  CBaseTexture *texture = CBaseTexture::LoadFromFile(image);
+  ASSERT_TRUE(texture != NULL);
+  unsigned int decodedSize = texture->GetPitch() * texture->GetRows();
+
+  XFILE::CFile *file = XBMC_CREATETEMPFILE(".dds");
+  ASSERT_TRUE(file != NULL);
+  std::string ddsPath = XBMC_TEMPFILEPATH(file);
+
+  CDDSImage dds;
+  start = CurrentHostCounter();
+  bool created = dds.Create(ddsPath, texture->GetWidth(), texture->GetHeight(), texture->GetPitch(), texture->GetPixels(), 40);
+  double compressTime = CXBMCTestUtils::TicksToMilliseconds(CurrentHostCounter() - start);
+  delete texture;
+  EXPECT_TRUE(created);
+
+  unsigned int compressedSize = 0;
+  start = CurrentHostCounter();
+  for (int i = 0; i < BENCHMARK_LOADS; i++)
+  {
+    CDDSImage compressed;
+    EXPECT_TRUE(compressed.ReadFile(ddsPath));
+    compressedSize = compressed.GetSize();
+  }
+  double readTime = CXBMCTestUtils::TicksToMilliseconds(CurrentHostCounter() - start) / BENCHMARK_LOADS;
+
+  start = CurrentHostCounter();
+  for (int i = 0; i < BENCHMARK_LOADS; i++)
+    delete CBaseTexture::LoadFromFile(ddsPath);
+  double fallbackTime = CXBMCTestUtils::TicksToMilliseconds(CurrentHostCounter() - start) / BENCHMARK_LOADS;
+
+  XBMC_DELETETEMPFILE(file);
+
+  XBMC_RECORD_BENCHMARK("DecodeUs", decodeTime * 1000, "us");
+  XBMC_RECORD_BENCHMARK("DecodedBytes", decodedSize, "bytes");
+  XBMC_RECORD_BENCHMARK("CompressUs", compressTime * 1000, "us");
+  XBMC_RECORD_BENCHMARK("ReadUs", readTime * 1000, "us");
+  XBMC_RECORD_BENCHMARK("CompressedBytes", compressedSize, "bytes");
+  XBMC_RECORD_BENCHMARK("FallbackUs", fallbackTime * 1000, "us");
+}
@@ -0,0 +1,93 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filesystem/File.h"
+#include "guilib/XBTF.h"
+#include "guilib/XBTFReader.h"
+#include "test/TestUtils.h"
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+  void AppendU32(std::string &data, uint32_t value)
+  {
+    for (int i = 0; i < 4; i++)
+      data += (char)((value >> (8 * i)) & 0xff);
+  }
+
+  /* A bundle header of files without frames, the loop of each set to its position. */
+  std::string CreateBundle(const char * const *paths, unsigned int count)
+  {
+    std::string data(XBTF_MAGIC);
+    data += XBTF_VERSION;
+    AppendU32(data, count);
+    for (unsigned int i = 0; i < count; i++)
+    {
+      char path[256];
+      memset(path, 0, sizeof(path));
+      strncpy(path, paths[i], sizeof(path) - 1);
+      data.append(path, sizeof(path));
+      AppendU32(data, i);
+      AppendU32(data, 0);
+    }
+    return data;
+  }
+}
+
+TEST(TestXBTFReader, Find)
+{
+  const char *paths[] = { "b.png", "a.png", "dup.png", "c.png", "dup.png", "d.png", "dup.png" };
+  std::string bundle = CreateBundle(paths, sizeof(paths) / sizeof(paths[0]));
+
+  XFILE::CFile *file;
+  ASSERT_TRUE((file = XBMC_CREATETEMPFILE(".xbt")) != NULL);
+  file->Close();
+  ASSERT_TRUE(file->OpenForWrite(XBMC_TEMPFILEPATH(file), true));
+  EXPECT_EQ((int)bundle.size(), file->Write(bundle.c_str(), bundle.size()));
+  file->Close();
+
+  CXBTFReader reader;
+  ASSERT_TRUE(reader.Open(XBMC_TEMPFILEPATH(file)));
+
+  for (unsigned int i = 0; i < sizeof(paths) / sizeof(paths[0]); i++)
+  {
+    if (strcmp(paths[i], "dup.png") == 0)
+      continue;
+    CXBTFFile *found = reader.Find(paths[i]);
+    ASSERT_TRUE(found != NULL) << paths[i];
+    EXPECT_STREQ(paths[i], found->GetPath());
+    EXPECT_EQ(i, found->GetLoop());
+  }
+
+  // a path that is in the bundle more than once is its last entry
+  CXBTFFile *dup = reader.Find("dup.png");
+  ASSERT_TRUE(dup != NULL);
+  EXPECT_EQ(6U, dup->GetLoop());
+
+  EXPECT_TRUE(reader.Find("e.png") == NULL);
+  EXPECT_TRUE(reader.Find("") == NULL);
+  EXPECT_FALSE(reader.Exists("dup"));
+
+  reader.Close();
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
@@ -97,6 +97,7 @@
 #include <vector>
 #include "settings/AdvancedSettings.h"
 #include "settings/DisplaySettings.h"
+#include "utils/Trace.h"
 #include "powermanagement/PowerManager.h"
 
 using namespace std;
@@ -225,6 +226,7 @@ const BUILT_IN commands[] = {
 #endif
   { "VideoLibrary.Search",        false,  "Brings up a search dialog which will search the library" },
   { "ToggleDebug",                false,  "Enables/disables debug mode" },
+  { "Trace",                      true,   "Start or stop recording trace spans. Stopping writes them to the given file (default special://temp/kodi.trace.json)" },
   { "StartPVRManager",            false,  "(Re)Starts the PVR manager" },
   { "StopPVRManager",             false,  "Stops the PVR manager" },
 #if defined(TARGET_ANDROID)
@@ -1827,6 +1829,21 @@ int CBuiltins::Execute(const std::string& execString)
     CSettings::Get().SetBool("debug.showloginfo", !debug);
     g_advancedSettings.SetDebugMode(!debug);
   }
+  else if (execute == "trace" && !params.empty())
+  {
+    if (StringUtils::EqualsNoCase(params[0], "start"))
+      CTrace::Get().Start();
+    else if (StringUtils::EqualsNoCase(params[0], "stop"))
+    {
+      CTrace::Get().Stop();
+      CTrace::Get().Export(params.size() > 1 ? params[1] : "special://temp/kodi.trace.json");
+    }
+    else
+    {
+      CLog::Log(LOGERROR, "Builtin 'Trace' called with unknown parameter: %s", params[0].c_str());
+      return -1;
+    }
+  }
   else if (execute == "startpvrmanager")
   {
     g_application.StartPVRManager();
@@ -171,6 +171,11 @@ namespace XBMCAddon
     void ListItem::setProperty(const char * key, const String& value)
     {
       LOCKGUI;
+      setProperty(item.get(), key, value);
+    }
+
+    void ListItem::setProperty(CFileItem* item, const char * key, const String& value)
+    {
       String lowerKey = key;
       StringUtils::ToLower(lowerKey);
       if (lowerKey == "startoffset")
@@ -265,7 +270,11 @@ namespace XBMCAddon
     void ListItem::setInfo(const char* type, const InfoLabelDict& infoLabels) throw (WrongTypeException)
     {
       LOCKGUI;
+      setInfo(item.get(), type, infoLabels);
+    }
 
+    void ListItem::setInfo(CFileItem* item, const char* type, const InfoLabelDict& infoLabels) throw (WrongTypeException)
+    {
       if (strcmpi(type, "video") == 0)
       {
         for (InfoLabelDict::const_iterator it = infoLabels.begin(); it != infoLabels.end(); ++it)
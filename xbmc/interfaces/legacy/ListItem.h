@@ -250,6 +250,14 @@ namespace XBMCAddon
        */
       void setInfo(const char* type, const InfoLabelDict& infoLabels) throw (WrongTypeException);
 
+#ifndef SWIG
+      /**
+       * Sets the infolabels of a CFileItem the way setInfo() does, for items
+       * that aren't shared with the gui yet.
+       */
+      static void setInfo(CFileItem* item, const char* type, const InfoLabelDict& infoLabels) throw (WrongTypeException);
+#endif
+
       /**
        * addStreamInfo(type, values) -- Add a stream with details.\n
        * \n
@@ -312,6 +320,14 @@ namespace XBMCAddon
        */
       void setProperty(const char * key, const String& value);
 
+#ifndef SWIG
+      /**
+       * Sets a property of a CFileItem the way setProperty() does, for items
+       * that aren't shared with the gui yet.
+       */
+      static void setProperty(CFileItem* item, const char * key, const String& value);
+#endif
+
       /**
        * getProperty(key) -- Returns a listitem property as a string, similar to an infolabel.\n
        * \n
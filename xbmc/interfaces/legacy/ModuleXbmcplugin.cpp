@@ -22,6 +22,7 @@
 
 #include "filesystem/PluginDirectory.h"
 #include "FileItem.h"
+#include "utils/StringUtils.h"
 
 namespace XBMCAddon
 {
@@ -60,6 +61,71 @@ namespace XBMCAddon
       return XFILE::CPluginDirectory::AddItems(handle, &fitems, totalItems);
     }
 
+    template <class T> static void checkColumn(const std::vector<T>& column, size_t size, const char* name)
+    {
+      if (!column.empty() && column.size() != size)
+        throw WrongTypeException("%s has %u entries instead of %u", name, (unsigned int)column.size(), (unsigned int)size);
+    }
+
+    bool addDirectoryItemColumns(int handle,
+                                 const std::vector<String>& urls,
+                                 const std::vector<String>& labels,
+                                 const std::vector<bool>& isFolders,
+                                 const std::vector<Properties>& art,
+                                 const String& infoType,
+                                 const std::vector<Properties>& infoLabels,
+                                 const std::vector<Properties>& properties,
+                                 int totalItems) throw (WrongTypeException)
+    {
+      const size_t size = urls.size();
+      checkColumn(labels, size, "labels");
+      checkColumn(isFolders, size, "isFolders");
+      checkColumn(art, size, "art");
+      checkColumn(infoLabels, size, "infoLabels");
+      checkColumn(properties, size, "properties");
+
+      // the items are ours until they're handed over, so they're filled in
+      // directly rather than through ListItems and the gui lock
+      CFileItemList fitems;
+      fitems.Reserve((int)size);
+      xbmcgui::InfoLabelDict info;
+      for (size_t i = 0; i < size; ++i)
+      {
+        CFileItemPtr item(new CFileItem(labels.empty() ? emptyString : labels[i]));
+        item->SetPath(urls[i]);
+        item->m_bIsFolder = isFolders.empty() ? false : isFolders[i];
+
+        if (!art.empty())
+        {
+          for (Properties::const_iterator it = art[i].begin(); it != art[i].end(); ++it)
+          {
+            std::string artName = it->first;
+            StringUtils::ToLower(artName);
+            item->SetArt(artName, it->second);
+          }
+        }
+
+        if (!infoLabels.empty() && !infoLabels[i].empty())
+        {
+          info.clear();
+          for (Properties::const_iterator it = infoLabels[i].begin(); it != infoLabels[i].end(); ++it)
+            info[it->first].former() = it->second;
+          xbmcgui::ListItem::setInfo(item.get(), infoType.c_str(), info);
+        }
+
+        if (!properties.empty())
+        {
+          for (Properties::const_iterator it = properties[i].begin(); it != properties[i].end(); ++it)
+            xbmcgui::ListItem::setProperty(item.get(), it->first.c_str(), it->second);
+        }
+
+        fitems.Add(item);
+      }
+
+      // move our items into the directory's listing
+      return XFILE::CPluginDirectory::AppendItems(handle, std::move(fitems), totalItems);
+    }
+
     void endOfDirectory(int handle, bool succeeded, bool updateListing, 
                         bool cacheToDisc)
     {
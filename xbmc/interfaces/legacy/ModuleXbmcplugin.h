@@ -69,6 +69,40 @@ namespace XBMCAddon
                            const std::vector<Tuple<String,const XBMCAddon::xbmcgui::ListItem*,bool> >& items, 
                            int totalItems = 0);
 
+    /**
+     * addDirectoryItemColumns(handle, urls, labels [,isFolders, art, infoType, infoLabels, properties, totalItems])
+     *   -- Callback function to pass directory contents back to XBMC as parallel lists.
+     *  - Returns a bool for successful completion.
+     * 
+     * handle      : integer - handle the plugin was started with.\n
+     * urls        : List - url of each entry.\n
+     * labels      : List - label of each entry.\n
+     * isFolders   : [opt] List - bool per entry, True=folder / False=not a folder(default).\n
+     * art         : [opt] List - dictionary of art per entry, as for ListItem.setArt().\n
+     * infoType    : [opt] string - type of media(video/music/pictures) of the infoLabels.(default=video)\n
+     * infoLabels  : [opt] List - dictionary of string infoLabels per entry, as for ListItem.setInfo().\n
+     * properties  : [opt] List - dictionary of properties per entry, as for ListItem.setProperty().\n
+     * totalItems  : [opt] integer - total number of items that will be passed.(used for progressbar)\n
+     * 
+     * *Note, The optional lists must either be empty or as long as urls.\n
+     *        Items are built without creating ListItems and without taking the gui lock,
+     *        which makes this the fastest way to list large directories.
+     *        Infolabels that take a list (cast, artist, ...) still need ListItem.setInfo().
+     *        You may call this more than once to add items in chunks
+     * 
+     * example:
+     *   - xbmcplugin.addDirectoryItemColumns(int(sys.argv[1]), urls, titles, art=[{'thumb': t} for t in thumbs])
+     */
+    bool addDirectoryItemColumns(int handle,
+                                 const std::vector<String>& urls,
+                                 const std::vector<String>& labels,
+                                 const std::vector<bool>& isFolders = std::vector<bool>(),
+                                 const std::vector<Properties>& art = std::vector<Properties>(),
+                                 const String& infoType = "video",
+                                 const std::vector<Properties>& infoLabels = std::vector<Properties>(),
+                                 const std::vector<Properties>& properties = std::vector<Properties>(),
+                                 int totalItems = 0) throw (WrongTypeException);
+
     /**
      * endOfDirectory(handle[, succeeded, updateListing, cacheToDisc]) -- Callback function to tell XBMC that the end of the directory listing in a virtualPythonFolder module is reached.
      * 
@@ -0,0 +1,143 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#if (defined HAVE_CONFIG_H) && (!defined TARGET_WINDOWS)
+  #include "config.h"
+#endif
+
+// python.h should always be included first before any other includes
+#include <Python.h>
+
+#include "PythonInterpreterPool.h"
+#include "settings/AdvancedSettings.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+CPythonInterpreterPool& CPythonInterpreterPool::Get()
+{
+  static CPythonInterpreterPool sPythonInterpreterPool;
+  return sPythonInterpreterPool;
+}
+
+bool CPythonInterpreterPool::Acquire(const std::string &addonId, const std::string &key, PyThreadState *&state,
+                                     XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> &languageHook)
+{
+  InterpreterList stale;
+  bool found = false;
+  {
+    CSingleLock lock(m_section);
+    for (InterpreterList::iterator it = m_interpreters.begin(); it != m_interpreters.end(); )
+    {
+      if (it->addonId != addonId)
+        ++it;
+      else if (it->key != key)
+      { // the plugin or one of its modules has been updated
+        stale.push_back(*it);
+        it = m_interpreters.erase(it);
+      }
+      else if (!found)
+      {
+        state = it->state;
+        languageHook = it->languageHook;
+        it = m_interpreters.erase(it);
+        found = true;
+      }
+      else
+        ++it;
+    }
+  }
+
+  if (!stale.empty())
+  {
+    CLog::Log(LOGDEBUG, "CPythonInterpreterPool: ending %u interpreters of outdated %s", (unsigned int)stale.size(), addonId.c_str());
+    End(stale);
+  }
+  return found;
+}
+
+void CPythonInterpreterPool::Release(const std::string &addonId, const std::string &key, PyThreadState *state,
+                                     const XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> &languageHook)
+{
+  Interpreter interpreter;
+  interpreter.addonId = addonId;
+  interpreter.key = key;
+  interpreter.state = state;
+  interpreter.languageHook = languageHook;
+  interpreter.released = XbmcThreads::SystemClockMillis();
+
+  InterpreterList evicted;
+  {
+    CSingleLock lock(m_section);
+    m_interpreters.push_front(interpreter);
+    while (m_interpreters.size() > g_advancedSettings.m_pythonInterpreterPool)
+    {
+      evicted.push_back(m_interpreters.back());
+      m_interpreters.pop_back();
+    }
+  }
+  End(evicted);
+}
+
+void CPythonInterpreterPool::Expire()
+{
+  InterpreterList expired;
+  {
+    CSingleLock lock(m_section);
+    unsigned int now = XbmcThreads::SystemClockMillis();
+    while (!m_interpreters.empty() &&
+           now - m_interpreters.back().released > g_advancedSettings.m_pythonInterpreterIdleTime * 1000)
+    {
+      expired.push_back(m_interpreters.back());
+      m_interpreters.pop_back();
+    }
+  }
+  End(expired);
+}
+
+void CPythonInterpreterPool::Clear()
+{
+  InterpreterList interpreters;
+  {
+    CSingleLock lock(m_section);
+    interpreters.swap(m_interpreters);
+  }
+  End(interpreters);
+}
+
+bool CPythonInterpreterPool::IsEmpty() const
+{
+  CSingleLock lock(m_section);
+  return m_interpreters.empty();
+}
+
+void CPythonInterpreterPool::End(const InterpreterList &interpreters)
+{
+  for (InterpreterList::const_iterator it = interpreters.begin(); it != interpreters.end(); ++it)
+  {
+    CLog::Log(LOGDEBUG, "CPythonInterpreterPool: ending idle interpreter of %s", it->addonId.c_str());
+
+    PyEval_AcquireLock();
+    PyThreadState_Swap(it->state);
+    Py_EndInterpreter(it->state);
+    it->languageHook->UnregisterMe();
+    PyEval_ReleaseLock();
+  }
+}
@@ -0,0 +1,97 @@
+#pragma once
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <list>
+#include <string>
+
+#include "interfaces/python/LanguageHook.h"
+#include "threads/CriticalSection.h"
+
+/*!
+ \brief Sub-interpreters of plugins that finished running, kept for the
+ plugin's next invocation.
+
+ Creating an interpreter and importing the xbmc modules, the standard library
+ and the addon's module dependencies takes longer than most plugins take to
+ list a directory. A plugin that ran cleanly hands its interpreter back here
+ and the next invocation of the same plugin reuses it, with everything
+ imported so far still in sys.modules.
+
+ Interpreters are keyed by the plugin and the versions of it and its module
+ dependencies, so updating any of them retires the old interpreters. Idle
+ interpreters are ended after advancedsettings' python interpreteridletime,
+ at most python interpreterpool of them are kept.
+
+ None of the methods may be called with the GIL held.
+ */
+class CPythonInterpreterPool
+{
+public:
+  static CPythonInterpreterPool& Get();
+
+  /*!
+   \brief Take an idle interpreter of the given plugin.
+   Interpreters of other versions of the plugin are ended.
+   \param addonId the plugin
+   \param key identifies the plugin's version and dependencies
+   \param state [out] the interpreter's thread state
+   \param languageHook [out] the interpreter's registered language hook
+   \return true if an interpreter was found
+   */
+  bool Acquire(const std::string &addonId, const std::string &key, PyThreadState *&state,
+               XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> &languageHook);
+
+  /*!
+   \brief Keep an interpreter for the plugin's next invocation.
+   The interpreter must have no other threads running and no current thread
+   state. It's ended instead if the pool is disabled.
+   */
+  void Release(const std::string &addonId, const std::string &key, PyThreadState *state,
+               const XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> &languageHook);
+
+  /*! \brief End the interpreters that have been idle for too long. */
+  void Expire();
+
+  /*! \brief End all idle interpreters, e.g. before python is finalized. */
+  void Clear();
+
+  bool IsEmpty() const;
+
+private:
+  CPythonInterpreterPool() { }
+  CPythonInterpreterPool(const CPythonInterpreterPool&);
+  CPythonInterpreterPool const& operator=(CPythonInterpreterPool const&);
+
+  struct Interpreter
+  {
+    std::string addonId;
+    std::string key;
+    PyThreadState *state;
+    XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> languageHook;
+    unsigned int released;
+  };
+  typedef std::list<Interpreter> InterpreterList;
+
+  static void End(const InterpreterList &interpreters);
+
+  InterpreterList m_interpreters; ///< most recently released first
+  mutable CCriticalSection m_section;
+};
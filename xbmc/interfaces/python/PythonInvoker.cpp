@@ -25,6 +25,9 @@
 // python.h should always be included first before any other includes
 #include <Python.h>
 #include <osdefs.h>
+#include <pythread.h>
+
+#include <algorithm>
 
 #include "system.h"
 #include "PythonInvoker.h"
@@ -39,10 +42,13 @@
 #include "interfaces/legacy/Addon.h"
 #include "interfaces/python/LanguageHook.h"
 #include "interfaces/python/PyContext.h"
+#include "interfaces/python/PythonInterpreterPool.h"
 #include "interfaces/python/pythreadstate.h"
 #include "interfaces/python/swig.h"
 #include "interfaces/python/XBPython.h"
+#include "settings/AdvancedSettings.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #if defined(TARGET_WINDOWS)
 #include "utils/CharsetConverter.h"
 #endif // defined(TARGET_WINDOWS)
@@ -68,6 +74,15 @@ extern "C" FILE *fopen_utf8(const char *_Filename, const char *_Mode);
 using namespace std;
 using namespace XFILE;
 
+// addon.xml is rewritten by every install and update of the addon
+static std::string getInstallStamp(const ADDON::AddonPtr &addon)
+{
+  struct __stat64 st;
+  if (CFile::Stat(URIUtils::AddFileToFolder(addon->Path(), "addon.xml"), &st) != 0)
+    return "";
+  return StringUtils::Format("%" PRId64, (int64_t)st.st_mtime);
+}
+
 extern "C"
 {
   int xbp_chdir(const char *dirname);
@@ -157,23 +172,58 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
 
   CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): start processing", GetId(), m_sourceFile.c_str());
   int m_Py_file_input = Py_file_input;
+  unsigned int startTime = XbmcThreads::SystemClockMillis();
+
+  // the addon module dependecies, and what identifies an interpreter that can
+  // be reused to run the addon: the versions and install times of the addon and
+  // its modules, and the time the script was changed
+  std::set<std::string> addonPaths;
+  std::string interpreterKey;
+  if (m_addon)
+  {
+    getAddonModuleDeps(m_addon, addonPaths, interpreterKey);
+    struct __stat64 st;
+    int64_t scriptTime = CFile::Stat(script, &st) == 0 ? (int64_t)st.st_mtime : 0;
+    interpreterKey = StringUtils::Format("%s|%s|%s|%" PRId64"|%s", m_addon->Path().c_str(), m_addon->Version().asString().c_str(),
+                                         getInstallStamp(m_addon).c_str(), scriptTime, interpreterKey.c_str());
+  }
+
+  // plugins are run for each directory they list, keep their interpreters around
+  bool reusable = m_addon && m_addon->Type() == ADDON::ADDON_PLUGIN && g_advancedSettings.m_pythonInterpreterPool > 0;
+
+  XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> languageHook;
+  PyThreadState* state = NULL;
+  bool reused = reusable && CPythonInterpreterPool::Get().Acquire(m_addon->ID(), interpreterKey, state, languageHook);
 
   // get the global lock
   PyEval_AcquireLock();
-  PyThreadState* state = Py_NewInterpreter();
-  if (state == NULL)
+  if (reused)
   {
-    PyEval_ReleaseLock();
-    CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): FAILED to get thread state!", GetId(), m_sourceFile.c_str());
-    return false;
+    // the interpreter was last used by another thread
+    state->thread_id = PyThread_get_thread_ident();
+    PyThreadState_Swap(state);
+
+    PyObject *m = PyImport_AddModule((char*)"xbmc");
+    if (m == NULL || PyObject_SetAttrString(m, (char*)"abortRequested", PyBool_FromLong(0)))
+      CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): failed to reset abortRequested", GetId(), m_sourceFile.c_str());
   }
-  // swap in my thread state
-  PyThreadState_Swap(state);
+  else
+  {
+    state = Py_NewInterpreter();
+    if (state == NULL)
+    {
+      PyEval_ReleaseLock();
+      CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): FAILED to get thread state!", GetId(), m_sourceFile.c_str());
+      return false;
+    }
+    // swap in my thread state
+    PyThreadState_Swap(state);
 
-  XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> languageHook(new XBMCAddon::Python::PythonLanguageHook(state->interp));
-  languageHook->RegisterMe();
+    languageHook = new XBMCAddon::Python::PythonLanguageHook(state->interp);
+    languageHook->RegisterMe();
 
-  onInitialization();
+    onInitialization();
+  }
   setState(InvokerStateInitialized);
 
   std::string realFilename(CSpecialProtocol::TranslatePath(m_sourceFile));
@@ -191,9 +241,7 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
   // add all addon module dependecies to path
   if (m_addon)
   {
-    std::set<std::string> paths;
-    getAddonModuleDeps(m_addon, paths);
-    for (std::set<std::string>::const_iterator it = paths.begin(); it != paths.end(); ++it)
+    for (std::set<std::string>::const_iterator it = addonPaths.begin(); it != addonPaths.end(); ++it)
       addPath(*it);
   }
   else
@@ -287,6 +335,8 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
         onPythonModuleInitialization(moduleDict);
 
         Py_DECREF(f);
+        CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): %s interpreter ready after %u ms", GetId(), m_sourceFile.c_str(),
+                  reused ? "reused" : "new", XbmcThreads::SystemClockMillis() - startTime);
         setState(InvokerStateRunning);
         XBMCAddon::Python::PyContext pycontext; // this is a guard class that marks this callstack as being in a python context
         PyRun_FileExFlags(fp, nativeFilename.c_str(), m_Py_file_input, moduleDict, moduleDict, 1, NULL);
@@ -390,6 +440,18 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
 
   onDeinitialization();
 
+  // a plugin that ran cleanly can leave its interpreter for its next run,
+  // but none of its own state
+  bool keep = reusable && stateToSet == InvokerStateDone && !m_stop;
+
+  // the threading module takes the thread it was imported on as the main
+  // thread, the next run would be on another one
+  if (keep && PyDict_GetItemString(PyImport_GetModuleDict(), "threading") != NULL)
+    keep = false;
+
+  if (keep)
+    resetInterpreter(CSpecialProtocol::TranslatePath(m_addon->Path()), addonPaths);
+
   // run the gc before finishing
   //
   // if the script exited by throwing a SystemExit excepton then going back
@@ -401,6 +463,16 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
       PyRun_SimpleString(GC_SCRIPT) == -1)
     CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): failed to run the gc to clean up after running prior to shutting down the Interpreter", GetId(), m_sourceFile.c_str());
 
+  if (keep && !languageHook->HasRegisteredAddonClasses())
+  {
+    PyThreadState_Swap(NULL);
+    PyEval_ReleaseLock();
+
+    CPythonInterpreterPool::Get().Release(m_addon->ID(), interpreterKey, state, languageHook);
+    setState(stateToSet);
+    return true;
+  }
+
   Py_EndInterpreter(state);
 
   // If we still have objects left around, produce an error message detailing what's been left behind
@@ -607,7 +679,62 @@ bool CPythonInvoker::initializeModule(PythonModuleInitialization module)
   return true;
 }
 
-void CPythonInvoker::getAddonModuleDeps(const ADDON::AddonPtr& addon, std::set<std::string>& paths)
+void CPythonInvoker::resetInterpreter(const std::string &addonPath, const std::set<std::string> &modulePaths)
+{
+  // forget the modules of the addon and of the module addons it uses, they are
+  // imported again by the next run
+  std::vector<std::string> nativePaths;
+  nativePaths.push_back(addonPath);
+  nativePaths.insert(nativePaths.end(), modulePaths.begin(), modulePaths.end());
+  for (std::vector<std::string>::iterator it = nativePaths.begin(); it != nativePaths.end(); ++it)
+  {
+    URIUtils::AddSlashAtEnd(*it);
+#if defined(TARGET_WINDOWS)
+    g_charsetConverter.utf8ToSystem(*it, true);
+#endif
+  }
+  std::vector<std::string> addonModules;
+  PyObject *modules = PyImport_GetModuleDict(); // borrowed ref, no need to delete
+  PyObject *name, *module;
+  Py_ssize_t pos = 0;
+  while (PyDict_Next(modules, &pos, &name, &module))
+  {
+    if (!PyString_Check(name) || !PyModule_Check(module))
+      continue;
+    char *file = PyModule_GetFilename(module); // returns internal data, don't delete or modify
+    if (file == NULL)
+    {
+      PyErr_Clear();
+      continue;
+    }
+    for (std::vector<std::string>::const_iterator it = nativePaths.begin(); it != nativePaths.end(); ++it)
+    {
+      if (StringUtils::StartsWith(file, *it))
+      {
+        addonModules.push_back(PyString_AsString(name));
+        break;
+      }
+    }
+  }
+  for (std::vector<std::string>::const_iterator it = addonModules.begin(); it != addonModules.end(); ++it)
+    PyDict_DelItemString(modules, it->c_str());
+
+  // and the globals of the script itself
+  PyObject *moduleDict = PyModule_GetDict(PyImport_AddModule((char*)"__main__"));
+  PyObject *builtins = PyDict_GetItemString(moduleDict, "__builtins__");
+  Py_XINCREF(builtins);
+  PyDict_Clear(moduleDict);
+  PyObject *mainName = PyString_FromString("__main__");
+  PyDict_SetItemString(moduleDict, "__name__", mainName);
+  Py_DECREF(mainName);
+  if (builtins != NULL)
+  {
+    PyDict_SetItemString(moduleDict, "__builtins__", builtins);
+    Py_DECREF(builtins);
+  }
+}
+
+void CPythonInvoker::getAddonModuleDeps(const ADDON::AddonPtr& addon, std::set<std::string>& paths, std::string& versions)
 {
   ADDON::ADDONDEPS deps = addon->GetDeps();
   for (ADDON::ADDONDEPS::const_iterator it = deps.begin(); it != deps.end(); ++it)
@@ -621,7 +748,8 @@ void CPythonInvoker::getAddonModuleDeps(const ADDON::AddonPtr& addon, std::set<s
       {
         // add it and its dependencies
         paths.insert(path);
-        getAddonModuleDeps(dependency, paths);
+        versions += dependency->ID() + ":" + dependency->Version().asString() + ":" + getInstallStamp(dependency) + ";";
+        getAddonModuleDeps(dependency, paths, versions);
       }
     }
   }
@@ -650,6 +778,11 @@ void CPythonInvoker::addNativePath(const std::string& path)
   if (path.empty())
     return;
 
+  // a reused interpreter's sys.path already has the paths added by its last run
+  std::vector<std::string> paths = StringUtils::Split(m_pythonPath, PY_PATH_SEP);
+  if (std::find(paths.begin(), paths.end(), path) != paths.end())
+    return;
+
   if (!m_pythonPath.empty())
     m_pythonPath += PY_PATH_SEP;
 
@@ -66,7 +66,8 @@ private:
   bool initializeModule(PythonModuleInitialization module);
   void addPath(const std::string& path); // add path in UTF-8 encoding
   void addNativePath(const std::string& path); // add path in system/Python encoding
-  void getAddonModuleDeps(const ADDON::AddonPtr& addon, std::set<std::string>& paths);
+  void getAddonModuleDeps(const ADDON::AddonPtr& addon, std::set<std::string>& paths, std::string& versions);
+  void resetInterpreter(const std::string &addonPath, const std::set<std::string> &modulePaths); // drop the addon's modules and globals
 
   std::string m_pythonPath;
   void *m_threadState;
@@ -52,6 +52,7 @@
 #include "interfaces/legacy/Monitor.h"
 #include "interfaces/legacy/AddonUtils.h"
 #include "interfaces/python/AddonPythonInvoker.h"
+#include "interfaces/python/PythonInterpreterPool.h"
 #include "interfaces/python/PythonInvoker.h"
 
 using namespace ANNOUNCEMENT;
@@ -504,6 +505,8 @@ void XBPython::Uninitialize()
 
   // cleanup threads that are still running
   tmpvec.clear(); // boost releases the XBPyThreads which, if deleted, calls OnScriptFinalized
+
+  CPythonInterpreterPool::Get().Clear();
 }
 
 void XBPython::Process()
@@ -528,8 +531,12 @@ void XBPython::Process()
     //delete scripts which are done
     tmpvec.clear(); // boost releases the XBPyThreads which, if deleted, calls OnScriptFinalized
 
+    // idle plugin interpreters keep python loaded until they expire
+    CPythonInterpreterPool::Get().Expire();
+
     CSingleLock l2(m_critSection);
-    if(m_iDllScriptCounter == 0 && (XbmcThreads::SystemClockMillis() - m_endtime) > 10000 )
+    if(m_iDllScriptCounter == 0 && (XbmcThreads::SystemClockMillis() - m_endtime) > 10000 &&
+       CPythonInterpreterPool::Get().IsEmpty())
     {
       Finalize();
     }
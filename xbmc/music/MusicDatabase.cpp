@@ -43,6 +43,7 @@
 #include "dialogs/GUIDialogYesNo.h"
 #include "dialogs/GUIDialogSelect.h"
 #include "filesystem/File.h"
+#include "filesystem/FileExistenceCheck.h"
 #include "profiles/ProfilesManager.h"
 #include "settings/AdvancedSettings.h"
 #include "FileItem.h"
@@ -2401,7 +2402,8 @@ bool CMusicDatabase::CleanupSongsByIds(const std::string &strSongIds)
       m_pDS->close();
       return true;
     }
-    vector<std::string> songsToDelete;
+    vector<std::string> songIds;
+    CFileExistenceCheck existenceCheck;
     while (!m_pDS->eof())
     { // get the full song path
       std::string strFileName = URIUtils::AddFileToFolder(m_pDS->fv("path.strPath").get_asString(), m_pDS->fv("song.strFileName").get_asString());
@@ -2416,14 +2418,25 @@ bool CMusicDatabase::CleanupSongsByIds(const std::string &strSongIds)
         URIUtils::RemoveSlashAtEnd(strFileName);
       }
 
-      if (!CFile::Exists(strFileName))
-      { // file no longer exists, so add to deletion list
-        songsToDelete.push_back(m_pDS->fv("song.idSong").get_asString());
-      }
+      existenceCheck.Add(strFileName);
+      songIds.push_back(m_pDS->fv("song.idSong").get_asString());
       m_pDS->next();
     }
     m_pDS->close();
 
+    // check the files a directory at a time, on a few threads
+    existenceCheck.Start();
+    existenceCheck.Wait();
+
+    vector<std::string> songsToDelete;
+    for (size_t i = 0; i < songIds.size(); i++)
+    {
+      if (!existenceCheck.Exists(i))
+      { // file no longer exists, so add to deletion list
+        songsToDelete.push_back(songIds[i]);
+      }
+    }
+
     if (!songsToDelete.empty())
     {
       std::string strSongsToDelete = "(" + StringUtils::Join(songsToDelete, ",") + ")";
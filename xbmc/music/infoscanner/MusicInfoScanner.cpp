@@ -38,6 +38,7 @@
 #include "guilib/GUIKeyboardFactory.h"
 #include "filesystem/File.h"
 #include "filesystem/Directory.h"
+#include "filesystem/DirectoryCache.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "FileItem.h"
@@ -92,6 +93,8 @@ void CMusicInfoScanner::Process()
     }
 
     unsigned int tick = XbmcThreads::SystemClockMillis();
+    unsigned int statHits, statMisses;
+    g_directoryCache.GetStatCacheCounts(statHits, statMisses);
 
     m_musicDatabase.Open();
 
@@ -178,6 +181,9 @@ void CMusicInfoScanner::Process()
       
       tick = XbmcThreads::SystemClockMillis() - tick;
       CLog::Log(LOGNOTICE, "My Music: Scanning for music info using worker thread, operation took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
+      unsigned int hits, misses;
+      g_directoryCache.GetStatCacheCounts(hits, misses);
+      CLog::Log(LOGDEBUG, "My Music: %u remote file lookups answered from the stat cache, %u not", hits - statHits, misses - statMisses);
     }
     if (m_scanType == 1) // load album info
     {
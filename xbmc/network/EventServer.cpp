@@ -32,9 +32,13 @@
 #include "interfaces/Builtins.h"
 #include "input/ButtonTranslator.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/TimeUtils.h"
 #include "Zeroconf.h"
 #include "guilib/GUIAudioManager.h"
 #include "guilib/Key.h"
+#include <algorithm>
 #include <map>
 #include <queue>
 #include <cassert>
@@ -56,6 +60,7 @@ CEventServer::CEventServer() : CThread("EventServer")
   m_bStop         = false;
   m_bRunning      = false;
   m_bRefreshSettings = false;
+  m_lastRefresh   = 0;
 
   // default timeout in ms for receiving a single packet
   m_iListenTimeout = 1000;
@@ -154,7 +159,8 @@ void CEventServer::Run()
 {
   CAddress any_addr;
   CSocketListener listener;
-  int packetSize = 0;
+  int packetCount = 0;
+  int64_t readTime = 0;
 
   CLog::Log(LOGNOTICE, "ES: Starting UDP Event server on %s:%d", any_addr.Address(), m_iPort);
 
@@ -167,7 +173,7 @@ void CEventServer::Run()
     CLog::Log(LOGERROR, "ES: Could not create socket, aborting!");
     return;
   }
-  m_pPacketBuffer = (unsigned char *)malloc(PACKET_SIZE);
+  m_pPacketBuffer = (unsigned char *)malloc(PACKET_SIZE * ES_PACKET_BATCH);
 
   if (!m_pPacketBuffer)
   {
@@ -206,12 +212,25 @@ void CEventServer::Run()
     try
     {
       // start listening until we timeout
+      packetCount = 0;
       if (listener.Listen(m_iListenTimeout))
       {
-        CAddress addr;
-        if ((packetSize = m_pSocket->Read(addr, PACKET_SIZE, (void *)m_pPacketBuffer)) > -1)
+        // drain everything that queued up since the last pass, so a burst of
+        // button/axis packets is handled in one go rather than one per select().
+        // the time packets wait for is only looked at when debug logging
+        bool measure = g_advancedSettings.m_logLevel >= LOG_LEVEL_DEBUG;
+        readTime = CurrentHostCounter();
+        if ((packetCount = m_pSocket->ReadMultiple(m_packetAddrs, m_packetSizes, ES_PACKET_BATCH,
+                                                   PACKET_SIZE, (void *)m_pPacketBuffer,
+                                                   measure ? m_packetAges : NULL)) > 0)
         {
-          ProcessPacket(addr, packetSize);
+          if (!measure)
+          {
+            for (int i = 0; i < packetCount; i++)
+              m_packetAges[i] = -1;
+          }
+          for (int i = 0; i < packetCount; i++)
+            ProcessPacket(m_packetAddrs[i], m_pPacketBuffer + i * PACKET_SIZE, m_packetSizes[i]);
         }
       }
     }
@@ -224,8 +243,25 @@ void CEventServer::Run()
     // process events and queue the necessary actions and button codes
     ProcessEvents();
 
-    // refresh client list
-    RefreshClients();
+    if (packetCount > 0)
+    {
+      int64_t handled = (CurrentHostCounter() - readTime) * 1000000 / CurrentHostFrequency();
+      for (int i = 0; i < packetCount && m_latencies.size() < ES_LATENCY_SAMPLES; i++)
+      {
+        if (m_packetAges[i] >= 0)
+          m_latencies.push_back(m_packetAges[i] + handled);
+      }
+    }
+
+    // refresh client list, client timeouts are in seconds so there's
+    // no need to do this for every packet under load
+    if (m_bRefreshSettings ||
+        XbmcThreads::SystemClockMillis() - m_lastRefresh >= (unsigned int)m_iListenTimeout)
+    {
+      RefreshClients();
+      ReportLatency();
+      m_lastRefresh = XbmcThreads::SystemClockMillis();
+    }
 
     // broadcast
     // BroadcastBeacon();
@@ -236,10 +272,25 @@ void CEventServer::Run()
   Cleanup();
 }
 
-void CEventServer::ProcessPacket(CAddress& addr, int pSize)
+void CEventServer::ReportLatency()
+{
+  if (m_latencies.empty())
+    return;
+
+  std::sort(m_latencies.begin(), m_latencies.end());
+  size_t count = m_latencies.size();
+  CLog::Log(LOGDEBUG, "ES: %u packets, latency p50 %.2f ms, p99 %.2f ms, max %.2f ms",
+            (unsigned int)count,
+            m_latencies[count / 2] / 1000.0,
+            m_latencies[std::min(count - 1, count * 99 / 100)] / 1000.0,
+            m_latencies.back() / 1000.0);
+  m_latencies.clear();
+}
+
+void CEventServer::ProcessPacket(CAddress& addr, unsigned char* buffer, int pSize)
 {
   // check packet validity
-  CEventPacket* packet = new CEventPacket(pSize, m_pPacketBuffer);
+  CEventPacket* packet = new CEventPacket(pSize, buffer);
   if(packet == NULL)
   {
     CLog::Log(LOGERROR, "ES: Out of memory, cannot accept packet");
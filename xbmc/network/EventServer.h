@@ -33,6 +33,10 @@
 
 namespace EVENTSERVER
 {
+  // max. number of datagrams fetched from the socket in one go
+  const int ES_PACKET_BATCH = 32;
+  // max. number of packet latencies kept between two reports
+  const size_t ES_LATENCY_SAMPLES = 65536;
 
   /**********************************************************************/
   /* UDP Event Server Class                                             */
@@ -72,9 +76,10 @@ namespace EVENTSERVER
     CEventServer();
     void Cleanup();
     void Run();
-    void ProcessPacket(SOCKETS::CAddress& addr, int packetSize);
+    void ProcessPacket(SOCKETS::CAddress& addr, unsigned char* buffer, int packetSize);
     void ProcessEvents();
     void RefreshClients();
+    void ReportLatency();
 
     std::map<unsigned long, EVENTCLIENT::CEventClient*>  m_clients;
     static CEventServer* m_pInstance;
@@ -83,6 +88,11 @@ namespace EVENTSERVER
     int              m_iListenTimeout;
     int              m_iMaxClients;
     unsigned char*   m_pPacketBuffer;
+    SOCKETS::CAddress m_packetAddrs[ES_PACKET_BATCH];
+    int              m_packetSizes[ES_PACKET_BATCH];
+    int64_t          m_packetAges[ES_PACKET_BATCH];
+    std::vector<int64_t> m_latencies; // us from arrival of a packet until its events were queued
+    unsigned int     m_lastRefresh;
     bool             m_bRunning;
     CCriticalSection m_critSection;
     bool             m_bRefreshSettings;
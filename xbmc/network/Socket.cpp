@@ -27,6 +27,7 @@
 #include "Socket.h"
 #include "utils/log.h"
 #include <vector>
+#include <errno.h>
 
 using namespace SOCKETS;
 //using namespace std; On VS2010, bind conflicts with std::bind
@@ -120,6 +121,7 @@ void CPosixUDPSocket::Close()
     close(m_iSock);
     m_iSock = INVALID_SOCKET;
   }
+  m_timestamps = false;
   SetBound(false);
   SetReady(false);
 }
@@ -130,6 +132,93 @@ int CPosixUDPSocket::Read(CAddress& addr, const int buffersize, void *buffer)
                        (struct sockaddr*)&addr.saddr, &addr.size);
 }
 
+int CPosixUDPSocket::ReadMultiple(CAddress* addrs, int* sizes, const int count,
+                                  const int buffersize, void *buffer, int64_t* ages)
+{
+  if (ages)
+  {
+    for (int i = 0; i < count; i++)
+      ages[i] = -1;
+  }
+#if defined(TARGET_LINUX) && !defined(TARGET_ANDROID) && defined(MSG_WAITFORONE)
+  // ask the kernel to stamp each datagram with its arrival time
+  if (ages && !m_timestamps)
+  {
+    int on = 1;
+    m_timestamps = setsockopt(m_iSock, SOL_SOCKET, SO_TIMESTAMP, &on, sizeof(on)) == 0;
+  }
+  const size_t controlSize = CMSG_SPACE(sizeof(struct timeval));
+  std::vector<char> controls(m_timestamps && ages ? count * controlSize : 0);
+
+  // fetch the whole backlog with a single syscall
+  std::vector<struct mmsghdr> msgs(count);
+  std::vector<struct iovec> iovs(count);
+  for (int i = 0; i < count; i++)
+  {
+    iovs[i].iov_base = (char*)buffer + i * buffersize;
+    iovs[i].iov_len  = buffersize;
+    memset(&msgs[i], 0, sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_name    = &addrs[i].saddr;
+    msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i].saddr);
+    msgs[i].msg_hdr.msg_iov     = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen  = 1;
+    if (!controls.empty())
+    {
+      msgs[i].msg_hdr.msg_control    = &controls[i * controlSize];
+      msgs[i].msg_hdr.msg_controllen = controlSize;
+    }
+  }
+
+  int num = recvmmsg(m_iSock, &msgs[0], count, MSG_DONTWAIT, NULL);
+  if (num < 0)
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+
+  struct timeval now;
+  if (!controls.empty())
+    gettimeofday(&now, NULL);
+
+  for (int i = 0; i < num; i++)
+  {
+    addrs[i].size = msgs[i].msg_hdr.msg_namelen;
+    sizes[i] = (int)msgs[i].msg_len;
+    if (controls.empty())
+      continue;
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg; cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg))
+    {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMP)
+      {
+        struct timeval arrival;
+        memcpy(&arrival, CMSG_DATA(cmsg), sizeof(arrival));
+        ages[i] = (int64_t)(now.tv_sec - arrival.tv_sec) * 1000000 + (now.tv_usec - arrival.tv_usec);
+      }
+    }
+  }
+  return num;
+#elif defined(MSG_DONTWAIT)
+  int num = 0;
+  while (num < count)
+  {
+    addrs[num].size = sizeof(addrs[num].saddr);
+    int size = (int)recvfrom(m_iSock, (char*)buffer + num * buffersize, (size_t)buffersize,
+                             MSG_DONTWAIT, (struct sockaddr*)&addrs[num].saddr, &addrs[num].size);
+    if (size < 0)
+    {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        break;
+      return num > 0 ? num : -1;
+    }
+    sizes[num++] = size;
+  }
+  return num;
+#else
+  // no non-blocking reads available, so only fetch the datagram select() reported
+  if (count < 1)
+    return 0;
+  sizes[0] = Read(addrs[0], buffersize, buffer);
+  return sizes[0] < 0 ? -1 : 1;
+#endif
+}
+
 int CPosixUDPSocket::SendTo(const CAddress& addr, const int buffersize,
                           const void *buffer)
 {
@@ -143,6 +143,13 @@ namespace SOCKETS
 
     // read datagrams, return no. of bytes read or -1 or error
     virtual int  Read(CAddress& addr, const int buffersize, void *buffer) = 0;
+
+    // read up to count already queued datagrams without blocking. datagram i is
+    // stored at buffer + i * buffersize, its sender in addrs[i] and its length in
+    // sizes[i]. if given, ages[i] is how long it was queued in us, or -1 if the
+    // socket can't tell. return no. of datagrams read or -1 on error
+    virtual int  ReadMultiple(CAddress* addrs, int* sizes, const int count,
+                              const int buffersize, void *buffer, int64_t* ages = NULL) = 0;
     virtual bool Broadcast(const CAddress& addr, const int datasize,
                            const void* data) = 0;
   };
@@ -158,6 +165,7 @@ namespace SOCKETS
     CPosixUDPSocket()
       {
         m_iSock = INVALID_SOCKET;
+        m_timestamps = false;
       }
 
     bool Bind(CAddress& addr, int port, int range=0);
@@ -165,6 +173,8 @@ namespace SOCKETS
     bool Listen(int timeout);
     int  SendTo(const CAddress& addr, const int datasize, const void* data);
     int  Read(CAddress& addr, const int buffersize, void *buffer);
+    int  ReadMultiple(CAddress* addrs, int* sizes, const int count,
+                      const int buffersize, void *buffer, int64_t* ages = NULL);
     bool Broadcast(const CAddress& addr, const int datasize, const void* data)
     {
       // TODO
@@ -176,6 +186,7 @@ namespace SOCKETS
   protected:
     SOCKET   m_iSock;
     CAddress m_addr;
+    bool     m_timestamps; // whether the kernel stamps datagrams with their arrival time
   };
 
   /**********************************************************************/
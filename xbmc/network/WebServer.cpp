@@ -27,11 +27,16 @@
 #ifdef HAS_WEB_SERVER
 #include <memory>
 #include <algorithm>
+#if defined(TARGET_POSIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include "URL.h"
 #include "Util.h"
 #include "XBDateTime.h"
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 #include "settings/Settings.h"
 #include "threads/SingleLock.h"
@@ -818,18 +823,24 @@ int CWebServer::CreateFileDownloadResponse(IHTTPRequestHandler *handler, struct
     // set the initial write position
     context->ranges.GetFirstPosition(context->writePosition);
 
-    // create the response object
-    response = MHD_create_response_from_callback(totalLength, 2048,
-                                                  &CWebServer::ContentReaderCallback,
-                                                  context.get(),
-                                                  &CWebServer::ContentReaderFreeCallback);
-    if (response == NULL)
+    // a single range of a local file can be sent straight from the file descriptor
+    // without passing the data through our buffers, otherwise go through CFile
+    if (context->rangeCountTotal > 1 || totalLength == 0 ||
+        CreateLocalFileDownloadResponse(filePath, context->writePosition, totalLength, response) != MHD_YES)
     {
-      CLog::Log(LOGERROR, "CWebServer: failed to create a HTTP response for %s to be filled from %s", request.url.c_str(), filePath.c_str());
-      return MHD_NO;
+      // create the response object
+      response = MHD_create_response_from_callback(totalLength, 2048,
+                                                    &CWebServer::ContentReaderCallback,
+                                                    context.get(),
+                                                    &CWebServer::ContentReaderFreeCallback);
+      if (response == NULL)
+      {
+        CLog::Log(LOGERROR, "CWebServer: failed to create a HTTP response for %s to be filled from %s", request.url.c_str(), filePath.c_str());
+        return MHD_NO;
+      }
+
+      context.release(); // ownership was passed to mhd
     }
-        
-    context.release(); // ownership was passed to mhd
 
     // add Content-Range header
     if (ranged)
@@ -854,6 +865,39 @@ int CWebServer::CreateFileDownloadResponse(IHTTPRequestHandler *handler, struct
   return MHD_YES;
 }
 
+int CWebServer::CreateLocalFileDownloadResponse(const std::string &filePath, uint64_t offset, uint64_t length, struct MHD_Response *&response)
+{
+#if (MHD_VERSION >= 0x00093900) && defined(TARGET_POSIX)
+  // only files on a local filesystem can be handed to mhd as a file descriptor
+  if (!URIUtils::IsHD(filePath))
+    return MHD_NO;
+
+  std::string localPath = CSpecialProtocol::TranslatePath(filePath);
+  if (URIUtils::IsURL(localPath))
+    return MHD_NO;
+
+  int fd = open(localPath.c_str(), O_RDONLY);
+  if (fd < 0)
+    return MHD_NO;
+
+  // mhd takes ownership of the file descriptor and uses sendfile() where possible
+  response = MHD_create_response_from_fd_at_offset64(length, fd, offset);
+  if (response == NULL)
+  {
+    close(fd);
+    return MHD_NO;
+  }
+
+#ifdef WEBSERVER_DEBUG
+  CLog::Log(LOGDEBUG, "webserver [OUT] sending %" PRIu64 " bytes from %" PRIu64 " of %s directly", length, offset, localPath.c_str());
+#endif
+
+  return MHD_YES;
+#else
+  return MHD_NO;
+#endif
+}
+
 int CWebServer::CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response)
 {
   size_t payloadSize = 0;
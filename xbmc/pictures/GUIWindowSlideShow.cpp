@@ -48,6 +48,7 @@
 #include "pictures/GUIViewStatePictures.h"
 #include "pictures/PictureInfoTag.h"
 #include "pictures/PictureThumbLoader.h"
+#include <algorithm>
 
 using namespace XFILE;
 
@@ -77,6 +78,7 @@ static float zoomamount[10] = { 1.0f, 1.2f, 1.5f, 2.0f, 2.8f, 4.0f, 6.0f, 9.0f,
 CBackgroundPicLoader::CBackgroundPicLoader() : CThread("BgPicLoader")
 {
   m_pCallback = NULL;
+  m_pCache = NULL;
   m_isLoading = false;
 }
 
@@ -85,9 +87,10 @@ CBackgroundPicLoader::~CBackgroundPicLoader()
   StopThread();
 }
 
-void CBackgroundPicLoader::Create(CGUIWindowSlideShow *pCallback)
+void CBackgroundPicLoader::Create(CGUIWindowSlideShow *pCallback, CSlideShowCache *pCache)
 {
   m_pCallback = pCallback;
+  m_pCache = pCache;
   m_isLoading = false;
   CThread::Create(false);
 }
@@ -96,16 +99,31 @@ void CBackgroundPicLoader::Process()
 {
   unsigned int totalTime = 0;
   unsigned int count = 0;
+  unsigned int cached = 0;
   while (!m_bStop)
   { // loop around forever, waiting for the app to call LoadPic
     if (AbortableWait(m_loadPic,10) == WAIT_SIGNALED)
     {
       if (m_pCallback)
       {
-        unsigned int start = XbmcThreads::SystemClockMillis();
-        CBaseTexture* texture = CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight, CSettings::Get().GetBool("pictures.useexifrotation"));
-        totalTime += XbmcThreads::SystemClockMillis() - start;
+        // use the decoded picture if it was prefetched (or is being prefetched right now)
+        CBaseTexture* texture = NULL;
+        if (m_pCache)
+        {
+          while (!m_bStop && !m_pCache->WaitForDecode(m_strFileName, m_maxWidth, m_maxHeight, 100))
+            ;
+          texture = m_pCache->Get(m_strFileName, m_maxWidth, m_maxHeight);
+        }
+        bool bCached = texture != NULL;
+        if (!texture)
+          texture = CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight, CSettings::Get().GetBool("pictures.useexifrotation"));
+        unsigned int readyTime = XbmcThreads::SystemClockMillis() - m_requestTime;
+        CLog::Log(LOGDEBUG, "Slide %d is ready after %u ms (%s): %s",
+                  m_iSlideNumber, readyTime, bCached ? "prefetched" : "decoded", m_strFileName.c_str());
+        totalTime += readyTime;
         count++;
+        if (bCached)
+          cached++;
         // tell our parent
         bool bFullSize = false;
         if (texture)
@@ -128,8 +146,8 @@ void CBackgroundPicLoader::Process()
     }
   }
   if (count > 0)
-    CLog::Log(LOGDEBUG, "Time for loading %u images: %u ms, average %u ms",
-              count, totalTime, totalTime / count);
+    CLog::Log(LOGDEBUG, "Time for loading %u images (%u prefetched): %u ms, average %u ms",
+              count, cached, totalTime, totalTime / count);
 }
 
 void CBackgroundPicLoader::LoadPic(int iPic, int iSlideNumber, const std::string &strFileName, const int maxWidth, const int maxHeight)
@@ -139,6 +157,7 @@ void CBackgroundPicLoader::LoadPic(int iPic, int iSlideNumber, const std::string
   m_strFileName = strFileName;
   m_maxWidth = maxWidth;
   m_maxHeight = maxHeight;
+  m_requestTime = XbmcThreads::SystemClockMillis();
   m_isLoading = true;
   m_loadPic.Set();
 }
@@ -147,6 +166,8 @@ CGUIWindowSlideShow::CGUIWindowSlideShow(void)
     : CGUIWindow(WINDOW_SLIDESHOW, "SlideShow.xml")
 {
   m_pBackgroundLoader = NULL;
+  m_iPrefetchSlide = -1;
+  m_bReloadImage = false;
   m_slides = new CFileItemList;
   m_Resolution = RES_INVALID;
   m_loadType = KEEP_IN_MEMORY;
@@ -245,6 +266,8 @@ void CGUIWindowSlideShow::Reset()
   m_iCurrentPic = 0;
   m_iDirection = 1;
   m_iLastFailedNextSlide = -1;
+  m_iPrefetchSlide = -1;
+  m_cache.Clear();
   CSingleLock lock(m_slideSection);
   m_slides->Clear();
   AnnouncePlaylistClear();
@@ -283,6 +306,8 @@ void CGUIWindowSlideShow::OnDeinitWindow(int nextWindowID)
     // and close the images.
     m_Image[0].Close();
     m_Image[1].Close();
+    m_cache.Clear();
+    m_iPrefetchSlide = -1;
   }
   g_infoManager.ResetCurrentSlide();
 
@@ -317,6 +342,7 @@ void CGUIWindowSlideShow::ShowNext()
   m_fZoom        = 1.0f;
   m_fRotate      = 0.0f;
   m_bLoadNextPic = true;
+  m_bReloadImage = false;
 }
 
 void CGUIWindowSlideShow::ShowPrevious()
@@ -330,6 +356,7 @@ void CGUIWindowSlideShow::ShowPrevious()
   m_fZoom        = 1.0f;
   m_fRotate      = 0.0f;
   m_bLoadNextPic = true;
+  m_bReloadImage = false;
 }
 
 
@@ -427,7 +454,7 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
     {
       throw 1;
     }
-    m_pBackgroundLoader->Create(this);
+    m_pBackgroundLoader->Create(this, &m_cache);
   }
 
   bool bSlideShow = m_bSlideShow && !m_bPause && !m_bPlayingVideo;
@@ -549,6 +576,32 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
     }
   }
 
+  if (m_bReloadImage && !m_pBackgroundLoader->IsLoading())
+  { // the current image is zoomed in beyond the resolution it was decoded at
+    if (m_Image[m_iCurrentPic].IsLoaded() && !m_Image[m_iCurrentPic].IsFinished())
+    {
+      CFileItemPtr item = m_slides->Get(m_iCurrentSlide);
+      std::string picturePath = GetPicturePath(item.get());
+      int maxWidth, maxHeight;
+      GetCheckedSize((float)res.iWidth * m_fZoom,
+                     (float)res.iHeight * m_fZoom,
+                     maxWidth, maxHeight);
+      CLog::Log(LOGDEBUG, "Reloading the current image %d at zoom %.2f: %s", m_iCurrentSlide, m_fZoom, item->GetPath().c_str());
+      m_pBackgroundLoader->LoadPic(m_iCurrentPic, m_iCurrentSlide, picturePath, maxWidth, maxHeight);
+    }
+    m_bReloadImage = false;
+  }
+
+  if (m_iPrefetchSlide != m_iCurrentSlide)
+  { // decode the slides around the current one ahead
+    int maxWidth, maxHeight;
+    GetCheckedSize((float)res.iWidth * m_fZoom,
+                   (float)res.iHeight * m_fZoom,
+                   maxWidth, maxHeight);
+    PrefetchSlides(maxWidth, maxHeight);
+    m_iPrefetchSlide = m_iCurrentSlide;
+  }
+
   if (m_slides->Get(m_iCurrentSlide)->IsVideo() && bSlideShow)
   {
     if (!PlayVideo())
@@ -643,6 +696,7 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
     m_iZoomFactor = 1;
     m_fZoom = 1.0f;
     m_fRotate = 0.0f;
+    m_bReloadImage = false;
   }
 
   if (m_Image[m_iCurrentPic].IsLoaded())
@@ -679,6 +733,25 @@ int CGUIWindowSlideShow::GetNextSlide()
   return m_iCurrentSlide;
 }
 
+void CGUIWindowSlideShow::PrefetchSlides(int maxWidth, int maxHeight)
+{
+  // the slides in the current direction come first, then the ones we came from
+  std::vector<std::string> paths;
+  int slides = m_slides->Size();
+  int step = m_iDirection >= 0 ? 1 : -1;
+  for (int i = 1; i <= g_advancedSettings.m_slideshowPrefetch && i * 2 <= slides; i++)
+  {
+    for (int j = 0; j < 2; j++)
+    {
+      int slide = (m_iCurrentSlide + (j ? -step : step) * i + slides) % slides;
+      CFileItemPtr item = m_slides->Get(slide);
+      if (!item->IsVideo() && !item->HasProperty("unplayable"))
+        paths.push_back(item->GetPath());
+    }
+  }
+  m_cache.Prefetch(paths, maxWidth, maxHeight);
+}
+
 EVENT_RESULT CGUIWindowSlideShow::OnMouseEvent(const CPoint &point, const CMouseEvent &event)
 {
   if (event.m_id == ACTION_GESTURE_NOTIFY)
@@ -1073,6 +1146,10 @@ void CGUIWindowSlideShow::ZoomRelative(float fZoom, bool immediate /* = false */
   if (m_Image[m_iCurrentPic].DrawNextImage())
     return;
 
+  // pictures are decoded at the display resolution, get more detail when zooming in
+  if (fZoom > m_fZoom && m_Image[m_iCurrentPic].IsLoaded() && !m_Image[m_iCurrentPic].FullSize())
+    m_bReloadImage = true;
+
   m_fZoom = fZoom;
 
   // find the nearest zoom factor
@@ -1142,7 +1219,10 @@ void CGUIWindowSlideShow::OnLoadPic(int iPic, int iSlideNumber, const std::strin
       return;
     }
     CLog::Log(LOGDEBUG, "Finished background loading slot %d, %d: %s", iPic, iSlideNumber, m_slides->Get(iSlideNumber)->GetPath().c_str());
-    m_Image[iPic].SetTexture(iSlideNumber, pTexture, GetDisplayEffect(iSlideNumber));
+    if (m_Image[iPic].IsLoaded() && m_Image[iPic].SlideNumber() == iSlideNumber)
+      m_Image[iPic].UpdateTexture(pTexture); // reloaded at a higher zoom level
+    else
+      m_Image[iPic].SetTexture(iSlideNumber, pTexture, GetDisplayEffect(iSlideNumber));
     m_Image[iPic].SetOriginalSize(pTexture->GetOriginalWidth(), pTexture->GetOriginalHeight(), bFullSize);
     
     m_Image[iPic].m_bIsComic = false;
@@ -1288,8 +1368,8 @@ void CGUIWindowSlideShow::AddItems(const std::string &strPath, path_set *recursi
 
 void CGUIWindowSlideShow::GetCheckedSize(float width, float height, int &maxWidth, int &maxHeight)
 {
-  maxWidth = g_Windowing.GetMaxTextureSize();
-  maxHeight = g_Windowing.GetMaxTextureSize();
+  maxWidth = std::min((int)width, (int)g_Windowing.GetMaxTextureSize());
+  maxHeight = std::min((int)height, (int)g_Windowing.GetMaxTextureSize());
 }
 
 std::string CGUIWindowSlideShow::GetPicturePath(CFileItem *item)
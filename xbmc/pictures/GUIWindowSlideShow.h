@@ -26,6 +26,7 @@
 #include "threads/CriticalSection.h"
 #include "threads/Event.h"
 #include "SlideShowPicture.h"
+#include "SlideShowCache.h"
 #include "DllImageLib.h"
 #include "utils/SortUtils.h"
 
@@ -40,7 +41,7 @@ public:
   CBackgroundPicLoader();
   ~CBackgroundPicLoader();
 
-  void Create(CGUIWindowSlideShow *pCallback);
+  void Create(CGUIWindowSlideShow *pCallback, CSlideShowCache *pCache);
   void LoadPic(int iPic, int iSlideNumber, const std::string &strFileName, const int maxWidth, const int maxHeight);
   bool IsLoading() { return m_isLoading;};
   int SlideNumber() const { return m_iSlideNumber; }
@@ -53,11 +54,13 @@ private:
   std::string m_strFileName;
   int m_maxWidth;
   int m_maxHeight;
+  unsigned int m_requestTime;
 
   CEvent m_loadPic;
   bool m_isLoading;
 
   CGUIWindowSlideShow *m_pCallback;
+  CSlideShowCache *m_pCache;
 };
 
 class CGUIWindowSlideShow : public CGUIWindow
@@ -120,6 +123,7 @@ private:
   void GetCheckedSize(float width, float height, int &maxWidth, int &maxHeight);
   std::string GetPicturePath(CFileItem *item);
   int  GetNextSlide();
+  void PrefetchSlides(int maxWidth, int maxHeight);
 
   void AnnouncePlayerPlay(const CFileItemPtr& item);
   void AnnouncePlayerPause(const CFileItemPtr& item);
@@ -151,8 +155,11 @@ private:
   int m_iCurrentPic;
   // background loader
   CBackgroundPicLoader* m_pBackgroundLoader;
+  CSlideShowCache m_cache;
+  int m_iPrefetchSlide;
   int m_iLastFailedNextSlide;
   bool m_bLoadNextPic;
+  bool m_bReloadImage;
   DllImageLib m_ImageLib;
   RESOLUTION m_Resolution;
   CCriticalSection m_slideSection;
@@ -0,0 +1,233 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+
+#include "SlideShowCache.h"
+#include "guilib/Texture.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/Settings.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+class CSlideShowDecodeJob : public CJob
+{
+public:
+  CSlideShowDecodeJob(const std::string &path, int maxWidth, int maxHeight, bool autoRotate)
+    : m_path(path), m_maxWidth(maxWidth), m_maxHeight(maxHeight), m_autoRotate(autoRotate), m_texture(NULL)
+  {
+  }
+
+  virtual ~CSlideShowDecodeJob()
+  {
+    delete m_texture;
+  }
+
+  virtual const char *GetType() const { return "slideshowdecode"; }
+
+  virtual bool DoWork()
+  {
+    m_texture = CTexture::LoadFromFile(m_path, m_maxWidth, m_maxHeight, m_autoRotate);
+    return m_texture != NULL;
+  }
+
+  CBaseTexture *TakeTexture()
+  {
+    CBaseTexture *texture = m_texture;
+    m_texture = NULL;
+    return texture;
+  }
+
+private:
+  std::string m_path;
+  int m_maxWidth;
+  int m_maxHeight;
+  bool m_autoRotate;
+  CBaseTexture *m_texture;
+};
+
+CSlideShowCache::CSlideShowCache()
+  : m_size(0)
+{
+}
+
+CSlideShowCache::~CSlideShowCache()
+{
+  Clear();
+}
+
+void CSlideShowCache::Prefetch(const std::vector<std::string> &paths, int maxWidth, int maxHeight)
+{
+  CSingleLock lock(m_section);
+
+  // cancel the decodes we no longer need
+  for (std::map<unsigned int, CachedPicture>::iterator it = m_jobs.begin(); it != m_jobs.end(); )
+  {
+    if (it->second.maxWidth != maxWidth || it->second.maxHeight != maxHeight ||
+        std::find(paths.begin(), paths.end(), it->second.path) == paths.end())
+    {
+      CJobManager::GetInstance().CancelJob(it->first);
+      m_jobs.erase(it++);
+    }
+    else
+      ++it;
+  }
+
+  if (g_advancedSettings.m_slideshowCacheSize <= 0)
+    return;
+
+  // mark the wanted pictures as recently used, most wanted last so it ends up first
+  for (std::vector<std::string>::const_reverse_iterator path = paths.rbegin(); path != paths.rend(); ++path)
+  {
+    PictureList::iterator it = Find(*path, maxWidth, maxHeight);
+    if (it != m_pictures.end())
+      m_pictures.splice(m_pictures.begin(), m_pictures, it);
+  }
+
+  bool autoRotate = CSettings::Get().GetBool("pictures.useexifrotation");
+  for (std::vector<std::string>::const_iterator path = paths.begin(); path != paths.end(); ++path)
+  {
+    if (path->empty() || Find(*path, maxWidth, maxHeight) != m_pictures.end() || IsDecoding(*path, maxWidth, maxHeight))
+      continue;
+
+    CachedPicture picture;
+    picture.path = *path;
+    picture.maxWidth = maxWidth;
+    picture.maxHeight = maxHeight;
+    picture.texture = NULL;
+    picture.size = 0;
+    unsigned int jobID = CJobManager::GetInstance().AddJob(new CSlideShowDecodeJob(*path, maxWidth, maxHeight, autoRotate), this, CJob::PRIORITY_NORMAL);
+    if (jobID)
+      m_jobs[jobID] = picture;
+  }
+}
+
+CBaseTexture *CSlideShowCache::Get(const std::string &path, int maxWidth, int maxHeight)
+{
+  CSingleLock lock(m_section);
+  PictureList::iterator it = Find(path, maxWidth, maxHeight);
+  if (it == m_pictures.end())
+    return NULL;
+
+  m_pictures.splice(m_pictures.begin(), m_pictures, it);
+  CBaseTexture *texture = new CTexture();
+  if (!texture->LoadFromTexture(*it->texture))
+  {
+    delete texture;
+    return NULL;
+  }
+  return texture;
+}
+
+bool CSlideShowCache::WaitForDecode(const std::string &path, int maxWidth, int maxHeight, unsigned int milliseconds)
+{
+  while (true)
+  {
+    {
+      CSingleLock lock(m_section);
+      if (!IsDecoding(path, maxWidth, maxHeight))
+        return true;
+    }
+    if (!m_decoded.WaitMSec(milliseconds))
+    {
+      CSingleLock lock(m_section);
+      return !IsDecoding(path, maxWidth, maxHeight);
+    }
+  }
+}
+
+void CSlideShowCache::Clear()
+{
+  CSingleLock lock(m_section);
+  for (std::map<unsigned int, CachedPicture>::const_iterator it = m_jobs.begin(); it != m_jobs.end(); ++it)
+    CJobManager::GetInstance().CancelJob(it->first);
+  m_jobs.clear();
+
+  for (PictureList::iterator it = m_pictures.begin(); it != m_pictures.end(); ++it)
+    delete it->texture;
+  m_pictures.clear();
+  m_size = 0;
+  m_decoded.Set();
+}
+
+void CSlideShowCache::OnJobComplete(unsigned int jobID, bool success, CJob *job)
+{
+  CSingleLock lock(m_section);
+  std::map<unsigned int, CachedPicture>::iterator it = m_jobs.find(jobID);
+  if (it != m_jobs.end())
+  {
+    if (success)
+      Insert(it->second.path, it->second.maxWidth, it->second.maxHeight, ((CSlideShowDecodeJob *)job)->TakeTexture());
+    else
+      CLog::Log(LOGDEBUG, "CSlideShowCache: unable to decode %s ahead", it->second.path.c_str());
+    m_jobs.erase(it);
+  }
+  m_decoded.Set();
+}
+
+CSlideShowCache::PictureList::iterator CSlideShowCache::Find(const std::string &path, int maxWidth, int maxHeight)
+{
+  for (PictureList::iterator it = m_pictures.begin(); it != m_pictures.end(); ++it)
+  {
+    if (it->maxWidth == maxWidth && it->maxHeight == maxHeight && it->path == path)
+      return it;
+  }
+  return m_pictures.end();
+}
+
+bool CSlideShowCache::IsDecoding(const std::string &path, int maxWidth, int maxHeight) const
+{
+  for (std::map<unsigned int, CachedPicture>::const_iterator it = m_jobs.begin(); it != m_jobs.end(); ++it)
+  {
+    if (it->second.maxWidth == maxWidth && it->second.maxHeight == maxHeight && it->second.path == path)
+      return true;
+  }
+  return false;
+}
+
+void CSlideShowCache::Insert(const std::string &path, int maxWidth, int maxHeight, CBaseTexture *texture)
+{
+  if (!texture)
+    return;
+  if (Find(path, maxWidth, maxHeight) != m_pictures.end())
+  { // already cached by an earlier decode
+    delete texture;
+    return;
+  }
+
+  CachedPicture picture;
+  picture.path = path;
+  picture.maxWidth = maxWidth;
+  picture.maxHeight = maxHeight;
+  picture.texture = texture;
+  picture.size = texture->GetPitch() * texture->GetRows();
+  m_pictures.push_front(picture);
+  m_size += picture.size;
+
+  // drop the least recently used pictures, but always keep the one just added
+  size_t maxSize = (size_t)g_advancedSettings.m_slideshowCacheSize * 1024 * 1024;
+  while (m_size > maxSize && m_pictures.size() > 1)
+  {
+    m_size -= m_pictures.back().size;
+    delete m_pictures.back().texture;
+    m_pictures.pop_back();
+  }
+}
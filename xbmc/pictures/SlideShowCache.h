@@ -0,0 +1,92 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "utils/Job.h"
+
+class CBaseTexture;
+
+/*!
+ \brief Decoded pictures for the slideshow.
+
+ Pictures around the current slide are decoded ahead on the job manager's
+ workers and kept, up to advancedsettings' slideshow cachesize, in least
+ recently used order. Get() hands the slideshow a copy of the decoded
+ texture, as loading it to the GPU frees its pixels. The picture stays
+ cached, so stepping back to a slide doesn't decode it again.
+ */
+class CSlideShowCache : public IJobCallback
+{
+public:
+  CSlideShowCache();
+  virtual ~CSlideShowCache();
+
+  /*!
+   \brief Set the pictures to decode ahead, most wanted first.
+   Pictures that are neither cached nor being decoded are queued, decodes of
+   pictures that are no longer wanted are cancelled.
+   */
+  void Prefetch(const std::vector<std::string> &paths, int maxWidth, int maxHeight);
+
+  /*!
+   \brief Get a copy of a decoded picture, which stays in the cache.
+   \return the texture, owned by the caller - NULL if the picture isn't cached.
+   */
+  CBaseTexture *Get(const std::string &path, int maxWidth, int maxHeight);
+
+  /*!
+   \brief Wait for a prefetch of the picture that is in progress.
+   \return true once the picture isn't being decoded (anymore), false on timeout.
+   */
+  bool WaitForDecode(const std::string &path, int maxWidth, int maxHeight, unsigned int milliseconds);
+
+  void Clear();
+
+  virtual void OnJobComplete(unsigned int jobID, bool success, CJob *job);
+
+private:
+  struct CachedPicture
+  {
+    std::string path;
+    int maxWidth;
+    int maxHeight;
+    CBaseTexture *texture;
+    size_t size;
+  };
+  typedef std::list<CachedPicture> PictureList;
+
+  PictureList::iterator Find(const std::string &path, int maxWidth, int maxHeight);
+  bool IsDecoding(const std::string &path, int maxWidth, int maxHeight) const;
+  void Insert(const std::string &path, int maxWidth, int maxHeight, CBaseTexture *texture);
+
+  PictureList m_pictures;                       ///< most recently used first
+  size_t m_size;                                ///< bytes held by m_pictures
+  std::map<unsigned int, CachedPicture> m_jobs; ///< prefetches in progress, by job id
+  CCriticalSection m_section;
+  CEvent m_decoded;
+};
@@ -168,6 +168,7 @@ void CAdvancedSettings::Initialize()
   m_DXVAAllowHqScaling = false;
   m_videoFpsDetect = 1;
   m_videoBusyDialogDelay_ms = 500;
+  m_videoDemuxReadAhead = true;
   m_stagefrightConfig.useAVCcodec = -1;
   m_stagefrightConfig.useHEVCcodec = -1;
   m_stagefrightConfig.useVC1codec = -1;
@@ -194,6 +195,8 @@ void CAdvancedSettings::Initialize()
   m_slideshowPanAmount = 2.5f;
   m_slideshowZoomAmount = 5.0f;
   m_slideshowBlackBarCompensation = 20.0f;
+  m_slideshowPrefetch = 2;
+  m_slideshowCacheSize = 128;
 
   m_songInfoDuration = 10;
 
@@ -254,6 +257,7 @@ void CAdvancedSettings::Initialize()
   m_fanartRes = 1080;
   m_imageRes = 720;
   m_useDDSFanart = false;
+  m_ddsUseCount = 0;
 
   m_sambaclienttimeout = 10;
   m_sambadoscodepage = "";
@@ -377,12 +381,17 @@ void CAdvancedSettings::Initialize()
   m_jsonOutputCompact = true;
   m_jsonTcpPort = 9090;
 
+  m_pythonInterpreterPool = 4;
+  m_pythonInterpreterIdleTime = 300;
+
   m_enableMultimediaKeys = false;
 
   m_canWindowed = true;
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiDirtyRegionNoFlipTimeout = 0;
+  m_guiSkinCache = true;
+  m_guiLargeTextureBudget = 128;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
@@ -703,6 +712,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     // the busy dialog is shown when starting video playback.
     XMLUtils::GetInt(pElement, "busydialogdelayms", m_videoBusyDialogDelay_ms, 0, 1000);
 
+    XMLUtils::GetBoolean(pElement, "demuxreadahead", m_videoDemuxReadAhead);
+
     // Store global display latency settings
     TiXmlElement* pVideoLatency = pElement->FirstChildElement("latency");
     if (pVideoLatency)
@@ -789,6 +800,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetFloat(pElement, "panamount", m_slideshowPanAmount, 0.0f, 20.0f);
     XMLUtils::GetFloat(pElement, "zoomamount", m_slideshowZoomAmount, 0.0f, 20.0f);
     XMLUtils::GetFloat(pElement, "blackbarcompensation", m_slideshowBlackBarCompensation, 0.0f, 50.0f);
+    XMLUtils::GetInt(pElement, "prefetch", m_slideshowPrefetch, 0, 10);
+    XMLUtils::GetInt(pElement, "cachesize", m_slideshowCacheSize, 0, 2048);
   }
 
   pElement = pRootElement->FirstChildElement("network");
@@ -810,6 +823,13 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "tcpport", m_jsonTcpPort);
   }
 
+  pElement = pRootElement->FirstChildElement("python");
+  if (pElement)
+  {
+    XMLUtils::GetUInt(pElement, "interpreterpool", m_pythonInterpreterPool, 0, 16);
+    XMLUtils::GetUInt(pElement, "interpreteridletime", m_pythonInterpreterIdleTime, 10, 3600);
+  }
+
   pElement = pRootElement->FirstChildElement("samba");
   if (pElement)
   {
@@ -1035,6 +1055,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   XMLUtils::GetUInt(pRootElement, "imageres", m_imageRes, 0, 1080);
 #if !defined(TARGET_RASPBERRY_PI)
   XMLUtils::GetBoolean(pRootElement, "useddsfanart", m_useDDSFanart);
+  XMLUtils::GetUInt(pRootElement, "ddsusecount", m_ddsUseCount);
 #endif
   XMLUtils::GetBoolean(pRootElement, "playlistasfolders", m_playlistAsFolders);
   XMLUtils::GetBoolean(pRootElement, "detectasudf", m_detectAsUdf);
@@ -1174,6 +1195,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetInt(pElement, "nofliptimeout",             m_guiDirtyRegionNoFlipTimeout);
+    XMLUtils::GetBoolean(pElement, "skincache",             m_guiSkinCache);
+    XMLUtils::GetUInt(pElement, "largetexturebudget",       m_guiLargeTextureBudget);
   }
 
   std::string seekSteps;
@@ -195,6 +195,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_DXVAAllowHqScaling;
     int  m_videoFpsDetect;
     int  m_videoBusyDialogDelay_ms;
+    bool m_videoDemuxReadAhead; ///< read files for the demuxer in growing blocks, see CDVDDemuxReadAhead
     StagefrightConfig m_stagefrightConfig;
     bool m_mediacodecForceSoftwareRendring;
 
@@ -205,6 +206,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     float m_slideshowBlackBarCompensation;
     float m_slideshowZoomAmount;
     float m_slideshowPanAmount;
+    int m_slideshowPrefetch;  ///< number of slides to decode ahead in each direction
+    int m_slideshowCacheSize; ///< memory for decoded slides, in MB
 
     int m_songInfoDuration;
     int m_logLevel;
@@ -249,6 +252,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
      */
     unsigned int GetThumbSize() const { return m_imageRes / 2; };
     bool m_useDDSFanart;
+    unsigned int m_ddsUseCount; ///< uses of a cached image before it gets a .dds copy, 0 to disable
 
     int m_sambaclienttimeout;
     std::string m_sambadoscodepage;
@@ -375,6 +379,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     int  m_guiDirtyRegionNoFlipTimeout;
+    bool m_guiSkinCache; ///< keep compiled copies of the skin's windows, see CGUISkinCache
+    unsigned int m_guiLargeTextureBudget; ///< MB of large textures before unused ones are dropped early, see CGUILargeTextureManager
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemBufferSize;
@@ -384,6 +390,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
 
+    unsigned int m_pythonInterpreterPool;     ///< idle plugin interpreters kept for reuse, 0 to disable
+    unsigned int m_pythonInterpreterIdleTime; ///< seconds before an idle plugin interpreter is ended
+
     bool m_enableMultimediaKeys;
     std::vector<std::string> m_settingsFiles;
     void ParseSettingsFile(const std::string &file);
@@ -0,0 +1,52 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "GUILargeTextureManager.h"
+#include "settings/AdvancedSettings.h"
+
+#include "gtest/gtest.h"
+
+TEST(TestGUILargeTextureManager, GetStreamSize)
+{
+  unsigned int imageRes = g_advancedSettings.m_imageRes;
+  g_advancedSettings.m_imageRes = 720;
+
+  // a poster in a wall
+  EXPECT_EQ(256U, CGUILargeTextureManager::GetStreamSize(120.0f, 180.0f));
+  EXPECT_EQ(128U, CGUILargeTextureManager::GetStreamSize(60.0f, 90.0f));
+  EXPECT_EQ(256U, CGUILargeTextureManager::GetStreamSize(256.0f, 100.0f));
+  EXPECT_EQ(512U, CGUILargeTextureManager::GetStreamSize(257.0f, 100.0f));
+
+  // as large as the cached image, or sized by the image
+  EXPECT_EQ(0U, CGUILargeTextureManager::GetStreamSize(1920.0f, 1080.0f));
+  EXPECT_EQ(0U, CGUILargeTextureManager::GetStreamSize(600.0f, 0.0f));
+
+  g_advancedSettings.m_imageRes = imageRes;
+}
+
+TEST(TestGUILargeTextureManager, IsLarger)
+{
+  EXPECT_TRUE(CGUILargeTextureManager::IsLarger(512, 256));
+  EXPECT_TRUE(CGUILargeTextureManager::IsLarger(0, 256));
+  EXPECT_FALSE(CGUILargeTextureManager::IsLarger(256, 256));
+  EXPECT_FALSE(CGUILargeTextureManager::IsLarger(128, 256));
+  EXPECT_FALSE(CGUILargeTextureManager::IsLarger(512, 0));
+  EXPECT_FALSE(CGUILargeTextureManager::IsLarger(0, 0));
+}
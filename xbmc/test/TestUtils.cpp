@@ -23,6 +23,7 @@
 #include "filesystem/File.h"
 #include "filesystem/SpecialProtocol.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include "utils/URIUtils.h"
 
 #ifdef TARGET_WINDOWS
@@ -32,6 +33,9 @@
 #include <climits>
 #include <ctime>
 #endif
+#include <stdio.h>
+
+#include "gtest/gtest.h"
 
 class CTempFile : public XFILE::CFile
 {
@@ -231,6 +235,11 @@ std::vector<std::string> &CXBMCTestUtils::getGUISettingsFiles()
   return GUISettingsFiles;
 }
 
+std::vector<std::string> &CXBMCTestUtils::getBenchmarkMediaFiles()
+{
+  return BenchmarkMediaFiles;
+}
+
 static const char usage[] =
 "XBMC Test Suite\n"
 "Usage: xbmc-test [options]\n"
@@ -268,6 +277,13 @@ static const char usage[] =
 "    Add multiple GUI settings files from a ',' delimited string of\n"
 "    files to be loaded in test cases that use them.\n"
 "\n"
+"  --add-benchmark-mediafile [FILE]\n"
+"    Add a media file to be played in the DVDPlayer benchmark tests.\n"
+"\n"
+"  --add-benchmark-mediafiles [FILES]\n"
+"    Add multiple media files from a ',' delimited string of files to be\n"
+"    played in the DVDPlayer benchmark tests.\n"
+"\n"
 "  --set-probability [PROBABILITY]\n"
 "    Set the probability variable used by the file corrupting functions.\n"
 "    The variable should be a double type from 0.0 to 1.0. Values given\n"
@@ -334,6 +350,18 @@ void CXBMCTestUtils::ParseArgs(int argc, char **argv)
       for (it = urls.begin(); it < urls.end(); ++it)
         GUISettingsFiles.push_back(*it);
     }
+    else if (arg == "--add-benchmark-mediafile")
+    {
+      BenchmarkMediaFiles.push_back(argv[++i]);
+    }
+    else if (arg == "--add-benchmark-mediafiles")
+    {
+      arg = argv[++i];
+      std::vector<std::string> files = StringUtils::Split(arg, ",");
+      std::vector<std::string>::iterator it;
+      for (it = files.begin(); it < files.end(); ++it)
+        BenchmarkMediaFiles.push_back(*it);
+    }
     else if (arg == "--set-probability")
     {
       probability = atof(argv[++i]);
@@ -358,3 +386,16 @@ std::string CXBMCTestUtils::getNewLineCharacters() const
   return "\n";
 #endif
 }
+
+double CXBMCTestUtils::TicksToMilliseconds(int64_t ticks)
+{
+  return (double)ticks * 1000.0 / CurrentHostFrequency();
+}
+
+void CXBMCTestUtils::RecordBenchmark(std::string const& name, double value,
+                                     std::string const& unit)
+{
+  printf("%-28s %12.2f %s\n", name.c_str(), value, unit.c_str());
+  testing::Test::RecordProperty(name.c_str(),
+                                (int)(value < 0 ? value - 0.5 : value + 0.5));
+}
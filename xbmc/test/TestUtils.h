@@ -19,6 +19,7 @@
  */
 #pragma once
 
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -76,6 +77,9 @@ public:
   /* Function to get GUI settings files. */
   std::vector<std::string> &getGUISettingsFiles();
 
+  /* Function to get the media files played in the DVDPlayer benchmarks. */
+  std::vector<std::string> &getBenchmarkMediaFiles();
+
   /* Function used in creating a corrupted file. The parameters are a URL
    * to the original file to be corrupted and a suffix to append to the
    * path of the newly created file. This will return a XFILE::CFile
@@ -90,6 +94,18 @@ public:
 
   /* Function to return the newline characters for this platform */
   std::string getNewLineCharacters() const;
+
+  /* Function to convert a difference of CurrentHostCounter() values to
+   * milliseconds.
+   */
+  static double TicksToMilliseconds(int64_t ticks);
+
+  /* Function used by the benchmarks to report a result. The result is
+   * printed and recorded, rounded, as a property of the running test, so
+   * --gtest_output=xml keeps it for comparing builds.
+   */
+  void RecordBenchmark(std::string const& name, double value,
+                       std::string const& unit);
 private:
   CXBMCTestUtils();
   CXBMCTestUtils(CXBMCTestUtils const&);
@@ -102,6 +118,8 @@ private:
   std::vector<std::string> AdvancedSettingsFiles;
   std::vector<std::string> GUISettingsFiles;
 
+  std::vector<std::string> BenchmarkMediaFiles;
+
   double probability;
 };
 
@@ -111,3 +129,5 @@ private:
 #define XBMC_TEMPFILEPATH(a) CXBMCTestUtils::Instance().TempFilePath(a)
 #define XBMC_CREATECORRUPTEDFILE(a, b) \
   CXBMCTestUtils::Instance().CreateCorruptedFile(a, b)
+#define XBMC_RECORD_BENCHMARK(n, v, u) \
+  CXBMCTestUtils::Instance().RecordBenchmark(n, v, u)
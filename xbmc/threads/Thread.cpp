@@ -25,6 +25,7 @@
 #include "threads/ThreadLocal.h"
 #include "threads/SingleLock.h"
 #include "commons/Exception.h"
+#include "utils/Trace.h"
 #include <stdlib.h>
 
 #define __STDC_FORMAT_MACROS
@@ -130,6 +131,9 @@ THREADFUNC CThread::staticThread(void* data)
 
   pThread->Action();
 
+  // let the next thread have this one's trace spans buffer
+  CTrace::Get().ReleaseBuffer();
+
   // lock during termination
   CSingleLock lock(pThread->m_CriticalSection);
 
@@ -24,6 +24,7 @@
 #include <stdexcept>
 #include "threads/SingleLock.h"
 #include "utils/log.h"
+#include "utils/Trace.h"
 
 #include "system.h"
 
@@ -65,6 +66,7 @@ void CJobWorker::Process()
     bool success = false;
     try
     {
+      CTraceScope traceScope(job->GetType());
       success = job->DoWork();
     }
     catch (...)
@@ -74,6 +74,7 @@ void CRegExp::InitValues(bool caseless /*= false*/, CRegExp::utf8Mode utf8 /*= a
   }
 
   m_offset      = 0;
+  m_subjectStart = 0;
   m_jitCompiled = false;
   m_bMatched    = false;
   m_iMatchCount = 0;
@@ -257,6 +258,7 @@ CRegExp& CRegExp::operator=(const CRegExp& re)
         memcpy(m_re, re.m_re, size);
         memcpy(m_iOvector, re.m_iOvector, OVECCOUNT*sizeof(int));
         m_offset = re.m_offset;
+        m_subjectStart = re.m_subjectStart;
         m_iMatchCount = re.m_iMatchCount;
         m_bMatched = re.m_bMatched;
         m_subject = re.m_subject;
@@ -370,8 +372,10 @@ int CRegExp::PrivateRegFind(size_t bufferLen, const char *str, unsigned int star
   if (maxNumberOfCharsToTest >= 0)
     bufferLen = std::min<size_t>(bufferLen, startoffset + maxNumberOfCharsToTest);
 
-  m_subject.assign(str + startoffset, bufferLen - startoffset);
-  int rc = pcre_exec(m_re, NULL, m_subject.c_str(), m_subject.length(), 0, 0, m_iOvector, OVECCOUNT);
+  // match the caller's buffer from the offset on, as if it started there
+  const char *subject = str + startoffset;
+  const int subjectLen = (int)(bufferLen - startoffset);
+  int rc = pcre_exec(m_re, NULL, subject, subjectLen, 0, 0, m_iOvector, OVECCOUNT);
 
   if (rc<1)
   {
@@ -388,9 +392,10 @@ int CRegExp::PrivateRegFind(size_t bufferLen, const char *str, unsigned int star
 #ifdef PCRE_ERROR_SHORTUTF8 
     case PCRE_ERROR_SHORTUTF8:
       {
-        const size_t startPos = (m_subject.length() > fragmentLen) ? CUtf8Utils::RFindValidUtf8Char(m_subject, m_subject.length() - fragmentLen) : 0;
+        const std::string subjectStr(subject, subjectLen);
+        const size_t startPos = (subjectStr.length() > fragmentLen) ? CUtf8Utils::RFindValidUtf8Char(subjectStr, subjectStr.length() - fragmentLen) : 0;
         if (startPos != std::string::npos)
-          CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character at the end of string. Text before bad character: \"%s\"", m_subject.substr(startPos).c_str());
+          CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character at the end of string. Text before bad character: \"%s\"", subjectStr.substr(startPos).c_str());
         else
           CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character at the end of string");
         return -1;
@@ -398,9 +403,10 @@ int CRegExp::PrivateRegFind(size_t bufferLen, const char *str, unsigned int star
 #endif
     case PCRE_ERROR_BADUTF8:
       {
-        const size_t startPos = (m_iOvector[0] > fragmentLen) ? CUtf8Utils::RFindValidUtf8Char(m_subject, m_iOvector[0] - fragmentLen) : 0;
+        const std::string subjectStr(subject, subjectLen);
+        const size_t startPos = (m_iOvector[0] > fragmentLen) ? CUtf8Utils::RFindValidUtf8Char(subjectStr, m_iOvector[0] - fragmentLen) : 0;
         if (m_iOvector[0] >= 0 && startPos != std::string::npos)
-          CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character, error code: %d, position: %d. Text before bad char: \"%s\"", m_iOvector[1], m_iOvector[0], m_subject.substr(startPos, m_iOvector[0] - startPos + 1).c_str());
+          CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character, error code: %d, position: %d. Text before bad char: \"%s\"", m_iOvector[1], m_iOvector[0], subjectStr.substr(startPos, m_iOvector[0] - startPos + 1).c_str());
         else
           CLog::Log(LOGERROR, "PCRE: Bad UTF-8 character, error code: %d, position: %d", m_iOvector[1], m_iOvector[0]);
         return -1;
@@ -414,6 +420,20 @@ int CRegExp::PrivateRegFind(size_t bufferLen, const char *str, unsigned int star
       return -1;
     }
   }
+  // keep only the part of the subject the captures are in, as the caller's buffer may
+  // be gone by the time they're asked for
+  int first = m_iOvector[0], last = m_iOvector[1];
+  for (int i = 1; i < rc; i++)
+  {
+    if (m_iOvector[i*2] >= 0)
+    {
+      first = std::min(first, m_iOvector[i*2]);
+      last = std::max(last, m_iOvector[(i*2)+1]);
+    }
+  }
+  m_subjectStart = first;
+  m_subject.assign(subject + first, last - first);
+
   m_offset = startoffset;
   m_bMatched = true;
   m_iMatchCount = rc;
@@ -514,7 +534,7 @@ std::string CRegExp::GetMatch(int iSub /* = 0 */) const
   if (pos < 0 || len <= 0)
     return "";
 
-  return m_subject.substr(pos, len);
+  return m_subject.substr(pos - m_subjectStart, len);
 }
 
 std::string CRegExp::GetMatch(const std::string& subName) const
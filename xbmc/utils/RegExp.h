@@ -169,7 +169,8 @@ private:
   bool        m_jitCompiled;
   bool        m_bMatched;
   PCRE::pcre_jit_stack* m_jitStack;
-  std::string m_subject;
+  std::string m_subject;      ///< the part of the matched subject the captures are in
+  int         m_subjectStart; ///< offset of m_subject in the matched subject
   std::string m_pattern;
   static int  m_Utf8Supported;
   static int  m_UcpSupported;
@@ -34,6 +34,11 @@
 #include "utils/XMLUtils.h"
 #include <sstream>
 #include <cstring>
+#include <algorithm>
+
+// upper bound for the number of cached expressions, as expressions may
+// contain item specific buffer contents
+#define MAX_CACHED_REGEXPS 500
 
 using namespace std;
 using namespace ADDON;
@@ -87,6 +92,7 @@ void CScraperParser::Clear()
 
   m_document = NULL;
   m_strFile.clear();
+  m_regExps.clear();
 }
 
 bool CScraperParser::Load(const std::string& strXMLFile)
@@ -192,6 +198,24 @@ void CScraperParser::ReplaceBuffers(std::string& strDest)
     strDest.replace(strDest.begin()+iIndex,strDest.begin()+iIndex+2,"\n");
 }
 
+std::shared_ptr<CRegExp> CScraperParser::GetRegExp(const std::string& expression, bool caseless, CRegExp::utf8Mode utf8)
+{
+  std::string key = StringUtils::Format("%d%d:", caseless ? 1 : 0, (int)utf8) + expression;
+  std::map<std::string, std::shared_ptr<CRegExp> >::iterator it = m_regExps.find(key);
+  if (it != m_regExps.end())
+    return it->second;
+
+  std::shared_ptr<CRegExp> reg(new CRegExp(caseless, utf8));
+  if (!reg->RegComp(expression, CRegExp::StudyRegExp))
+    return std::shared_ptr<CRegExp>();
+
+  // callers hold on to their expression, so dropping the cache doesn't affect them
+  if (m_regExps.size() >= MAX_CACHED_REGEXPS)
+    m_regExps.clear();
+  m_regExps.insert(make_pair(key, reg));
+  return reg;
+}
+
 void CScraperParser::ParseExpression(const std::string& input, std::string& dest, TiXmlElement* element, bool bAppend)
 {
   std::string strOutput = XMLUtils::GetAttribute(element, "output");
@@ -217,7 +241,6 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
         eUtf8 = CRegExp::autoUtf8;
     }
 
-    CRegExp reg(bInsensitive, eUtf8);
     std::string strExpression;
     if (pExpression->FirstChild())
       strExpression = pExpression->FirstChild()->Value();
@@ -226,10 +249,12 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
     ReplaceBuffers(strExpression);
     ReplaceBuffers(strOutput);
 
-    if (!reg.RegComp(strExpression.c_str()))
+    std::shared_ptr<CRegExp> pReg = GetRegExp(strExpression, bInsensitive, eUtf8);
+    if (!pReg)
     {
       return;
     }
+    CRegExp& reg = *pReg;
 
     bool bRepeat = false;
     const char* szRepeat = pExpression->Attribute("repeat");
@@ -259,9 +284,17 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
 
     int iCompare = -1;
     pExpression->QueryIntAttribute("compare",&iCompare);
+    // matching works on the input in place, unless it is our destination buffer
+    // as well, which gets cleared/appended to while we're still matching, or the
+    // compare buffer, which gets lowercased below
+    bool bCopyInput = &input == &dest || (iCompare > 0 && &input == &m_param[iCompare-1]);
+    std::string inputCopy;
+    if (bCopyInput)
+      inputCopy = input;
+    const std::string& curInput = bCopyInput ? inputCopy : input;
     if (iCompare > -1)
       StringUtils::ToLower(m_param[iCompare-1]);
-    std::string curInput = input;
+    unsigned int offset = 0;
     for (int iBuf=0;iBuf<MAX_SCRAPER_BUFFERS;++iBuf)
     {
       if (bClean[iBuf])
@@ -273,8 +306,8 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
       if (bEncode[iBuf])
         InsertToken(strOutput,iBuf+1,"!!!ENCODE!!!");
     }
-    int i = reg.RegFind(curInput.c_str());
-    while (i > -1 && (i < (int)curInput.size() || curInput.size() == 0))
+    int i = reg.RegFind(curInput);
+    while (i > -1 && (i < (int)curInput.size() || curInput.size() == offset))
     {
       if (!bAppend)
       {
@@ -288,8 +321,10 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
         char temp[4];
         sprintf(temp,"\\%i",iOptional);
         std::string szParam = reg.GetReplaceString(temp);
-        CRegExp reg2;
-        reg2.RegComp("(.*)(\\\\\\(.*\\\\2.*)\\\\\\)(.*)");
+        // not taken from the cache, as it could be the very object of reg
+        if (!m_optionalRegExp.IsCompiled())
+          m_optionalRegExp.RegComp("(.*)(\\\\\\(.*\\\\2.*)\\\\\\)(.*)");
+        CRegExp& reg2 = m_optionalRegExp;
         int i2=reg2.RegFind(strCurOutput.c_str());
         while (i2 > -1)
         {
@@ -330,8 +365,9 @@ void CScraperParser::ParseExpression(const std::string& input, std::string& dest
       }
       if (bRepeat && iLen > 0)
       {
-        curInput.erase(0,i+iLen>(int)curInput.size()?curInput.size():i+iLen);
-        i = reg.RegFind(curInput.c_str());
+        // continue matching after the current match, as if the input started there
+        offset = std::min<unsigned int>(i + iLen, curInput.size());
+        i = reg.RegFind(curInput, offset);
       }
       else
         i = -1;
@@ -412,8 +448,8 @@ void CScraperParser::ParseNext(TiXmlElement* element)
       strInput = szInput;
       ReplaceBuffers(strInput);
     }
-    else
-      strInput = m_param[0];
+    // without an explicit input, work on buffer 1 directly instead of a copy
+    const std::string& input = szInput ? strInput : m_param[0];
 
     const char* szConditional = pReg->Attribute("conditional");
     bool bExecute = true;
@@ -436,9 +472,9 @@ void CScraperParser::ParseNext(TiXmlElement* element)
       if (iDest-1 < MAX_SCRAPER_BUFFERS && iDest-1 > -1)
       {
         if (pReg->ValueStr() == "XSLT")
-          ParseXSLT(strInput, m_param[iDest - 1], pReg, bAppend);
+          ParseXSLT(input, m_param[iDest - 1], pReg, bAppend);
         else
-          ParseExpression(strInput, m_param[iDest - 1],pReg,bAppend);
+          ParseExpression(input, m_param[iDest - 1],pReg,bAppend);
       }
       else
         CLog::Log(LOGERROR,"CScraperParser::ParseNext: destination buffer "
@@ -21,9 +21,13 @@
  *
  */
 
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "utils/RegExp.h"
+
 #define MAX_SCRAPER_BUFFERS 20
 
 namespace ADDON
@@ -62,6 +66,18 @@ private:
   void ReplaceBuffers(std::string& strDest);
   void ParseExpression(const std::string& input, std::string& dest, TiXmlElement* element, bool bAppend);
 
+  /*! \brief Get a compiled regular expression from the cache
+   Scrapers evaluate the same expressions for every item, so they are only
+   compiled (and studied) once per parser.
+   \param expression the regular expression, with buffers already replaced
+   \param caseless whether to match case insensitive
+   \param utf8 UTF-8 mode of the expression
+   \return the compiled expression or an empty pointer if it failed to compile.
+   The caller keeps the expression alive while it is matching, so it may be
+   dropped from the cache in the meantime.
+   */
+  std::shared_ptr<CRegExp> GetRegExp(const std::string& expression, bool caseless, CRegExp::utf8Mode utf8);
+
   /*! \brief Parse an 'XSLT' declaration from the scraper
    This allow us to transform an inbound XML document using XSLT
    to a different type of XML document, ready to be output direct
@@ -87,6 +103,9 @@ private:
 
   std::string m_strFile;
   ADDON::CScraper* m_scraper;
+
+  std::map<std::string, std::shared_ptr<CRegExp> > m_regExps;
+  CRegExp m_optionalRegExp;
 };
 
 #endif
@@ -0,0 +1,190 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "Trace.h"
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+std::atomic<bool> CTrace::m_enabled(false);
+
+CTrace::CBuffer::CBuffer(int id)
+  : m_id(id), m_sequence(0), m_spans(NULL)
+{
+  if (id >= 0)
+    m_spans = new Span[TRACE_BUFFER_SIZE];
+}
+
+CTrace::CBuffer::~CBuffer()
+{
+  delete[] m_spans;
+}
+
+CTrace::CTrace()
+  : m_overflow(-1), m_startTime(0)
+{
+}
+
+CTrace& CTrace::Get()
+{
+  static CTrace trace;
+  return trace;
+}
+
+void CTrace::Start()
+{
+  // spans from before the start are left in the buffers and skipped by ToJSON
+  CSingleLock lock(m_lock);
+  m_startTime = CurrentHostCounter();
+  m_enabled = true;
+  CLog::Log(LOGNOTICE, "CTrace::Start - tracing started");
+}
+
+void CTrace::Stop()
+{
+  m_enabled = false;
+  CLog::Log(LOGNOTICE, "CTrace::Stop - tracing stopped");
+}
+
+CTrace::CBuffer* CTrace::GetBuffer()
+{
+  CBuffer* buffer = m_threadBuffer.get();
+  if (buffer)
+    return buffer;
+
+  CSingleLock lock(m_lock);
+  if (!m_free.empty())
+  {
+    buffer = m_free.back();
+    m_free.pop_back();
+  }
+  else if (m_buffers.size() < TRACE_MAX_THREADS)
+  {
+    buffer = new CBuffer(m_buffers.size());
+    m_buffers.push_back(buffer);
+  }
+  else
+    buffer = &m_overflow;
+  m_threadBuffer.set(buffer);
+  return buffer;
+}
+
+void CTrace::Add(const char* name, int64_t start, int64_t end)
+{
+  CBuffer* buffer = GetBuffer();
+  if (!buffer->m_spans)
+    return;
+
+  // only this thread writes the sequence, ToJSON checks it around its copy
+  long sequence = buffer->m_sequence.load(std::memory_order_relaxed);
+  buffer->m_sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  Span& span = buffer->m_spans[(sequence / 2) & (TRACE_BUFFER_SIZE - 1)];
+  span.name  = name;
+  span.start = start;
+  span.end   = end;
+  buffer->m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void CTrace::ReleaseBuffer()
+{
+  CBuffer* buffer = m_threadBuffer.get();
+  if (!buffer)
+    return;
+
+  m_threadBuffer.set(NULL);
+  if (buffer == &m_overflow)
+    return;
+
+  CSingleLock lock(m_lock);
+  m_free.push_back(buffer);
+}
+
+std::string CTrace::ToJSON()
+{
+  CSingleLock lock(m_lock);
+
+  double toMicroseconds = 1000000.0 / CurrentHostFrequency();
+  std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  std::vector<Span> spans;
+  for (std::vector<CBuffer*>::const_iterator it = m_buffers.begin(); it != m_buffers.end(); ++it)
+  {
+    CBuffer* buffer = *it;
+
+    // copy the spans while their thread goes on writing, then drop the ones
+    // it has started overwriting since
+    long written = buffer->m_sequence.load(std::memory_order_acquire) / 2;
+    long begin = written > TRACE_BUFFER_SIZE ? written - TRACE_BUFFER_SIZE : 0;
+    spans.clear();
+    for (long i = begin; i < written; i++)
+      spans.push_back(buffer->m_spans[i & (TRACE_BUFFER_SIZE - 1)]);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    long overwritten = (buffer->m_sequence.load(std::memory_order_relaxed) + 1) / 2 - TRACE_BUFFER_SIZE;
+    if (overwritten > begin)
+      spans.erase(spans.begin(), spans.begin() + std::min(overwritten - begin, (long)spans.size()));
+
+    for (std::vector<Span>::const_iterator span = spans.begin(); span != spans.end(); ++span)
+    {
+      if (span->start < m_startTime)
+        continue;
+
+      std::string name = span->name ? span->name : "";
+      StringUtils::Replace(name, "\\", "\\\\");
+      StringUtils::Replace(name, "\"", "\\\"");
+
+      json += StringUtils::Format("%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                                  first ? "" : ",", name.c_str(), buffer->m_id,
+                                  (span->start - m_startTime) * toMicroseconds,
+                                  (span->end - span->start) * toMicroseconds);
+      first = false;
+    }
+  }
+  json += "]}";
+
+  return json;
+}
+
+bool CTrace::Export(const std::string& path)
+{
+  std::string json = ToJSON();
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(path, true) ||
+      file.Write(json.c_str(), json.size()) != (ssize_t)json.size())
+  {
+    CLog::Log(LOGERROR, "CTrace::Export - unable to write %s", path.c_str());
+    return false;
+  }
+
+  CLog::Log(LOGNOTICE, "CTrace::Export - wrote %s", path.c_str());
+  return true;
+}
+
+int64_t CTraceScope::Now()
+{
+  return CurrentHostCounter();
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+#include "threads/ThreadLocal.h"
+
+/*!
+ \brief Scoped trace spans, recorded into per thread ring buffers.
+
+ Spans are named by string literals, only the pointer is stored so recording
+ a span is two counter reads and a write into the calling thread's buffer.
+ Only the owning thread writes to a buffer, without taking a lock. Exporting
+ reads the buffer alongside and drops the spans that were overwritten while
+ it was copying them. Nothing is recorded (and no buffer is allocated) while
+ tracing is stopped. A CThread hands its buffer back when it exits, so the
+ next thread can use it.
+
+ Usage:
+   void CFoo::Bar()
+   {
+     TRACE_FUNCTION;
+     ...
+     {
+       TRACE_SCOPE("CFoo::Bar - decode");
+       ...
+     }
+   }
+
+ The recorded spans can be written as a Chrome trace event file (as read by
+ chrome://tracing or Perfetto) with CTrace::Get().Export().
+ */
+
+#ifndef NO_TRACING
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) CTraceScope TRACE_CONCAT(traceScope, __LINE__)("" name)
+#define TRACE_FUNCTION CTraceScope TRACE_CONCAT(traceScope, __LINE__)(__FUNCTION__)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_FUNCTION
+#endif
+
+#define TRACE_BUFFER_SIZE 8192 ///< spans kept per thread, must be a power of two
+#define TRACE_MAX_THREADS 128  ///< threads at a time that get a buffer, others aren't traced
+
+class CTrace
+{
+public:
+  struct Span
+  {
+    const char* name;
+    int64_t     start;
+    int64_t     end;
+  };
+
+  static CTrace& Get();
+
+  /*!
+   \brief Start recording, throwing away anything recorded before.
+   */
+  void Start();
+  void Stop();
+
+  inline static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+  /*!
+   \brief Record a finished span for the calling thread.
+   \param name string literal naming the span, must outlive the trace.
+   \param start host counter value when the span started.
+   \param end host counter value when the span finished.
+   */
+  void Add(const char* name, int64_t start, int64_t end);
+
+  /*!
+   \brief Hand the calling thread's buffer to the next thread that needs one.
+   Its spans are still exported. Called by CThread when the thread exits.
+   */
+  void ReleaseBuffer();
+
+  /*!
+   \brief Write the recorded spans as Chrome trace event JSON.
+   \param path file to write, usually special://temp/kodi.trace.json
+   \return true if the file was written.
+   */
+  bool Export(const std::string& path);
+
+  /*!
+   \brief Get the recorded spans as Chrome trace event JSON.
+   */
+  std::string ToJSON();
+
+private:
+  CTrace();
+  CTrace(const CTrace&);
+  CTrace& operator=(const CTrace&);
+
+  class CBuffer
+  {
+  public:
+    CBuffer(int id);
+    ~CBuffer();
+
+    int               m_id;
+    std::atomic<long> m_sequence; ///< twice the spans written, odd while one is being written
+    Span*             m_spans;    ///< TRACE_BUFFER_SIZE spans, NULL for threads over the limit
+  };
+
+  CBuffer* GetBuffer();
+
+  static std::atomic<bool> m_enabled;
+
+  CCriticalSection m_lock;
+  std::vector<CBuffer*> m_buffers; ///< never freed, threads keep pointers to them
+  std::vector<CBuffer*> m_free;    ///< released by threads that exited
+  CBuffer m_overflow;              ///< handed to threads over TRACE_MAX_THREADS
+  XbmcThreads::ThreadLocal<CBuffer> m_threadBuffer;
+  int64_t m_startTime;
+};
+
+/*!
+ \brief Records a span for the lifetime of the object, see TRACE_SCOPE.
+ */
+class CTraceScope
+{
+public:
+  inline CTraceScope(const char* name) : m_name(name), m_start(CTrace::IsEnabled() ? Now() : 0) {}
+  inline ~CTraceScope()
+  {
+    if (m_start && CTrace::IsEnabled())
+      CTrace::Get().Add(m_name, m_start, Now());
+  }
+
+private:
+  static int64_t Now();
+
+  const char* m_name;
+  int64_t     m_start;
+};
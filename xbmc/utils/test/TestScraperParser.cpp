@@ -19,6 +19,7 @@
  */
 
 #include "utils/ScraperParser.h"
+#include "utils/StringUtils.h"
 
 #include "test/TestUtils.h"
 
@@ -37,3 +38,71 @@ TEST(TestScraperParser, General)
     a.GetFilename().c_str());
   EXPECT_STREQ("UTF-8", a.GetSearchStringEncoding().c_str());
 }
+
+TEST(TestScraperParser, RepeatExpression)
+{
+  CScraperParser a;
+  EXPECT_TRUE(
+    a.Load(XBMC_REF_FILE_PATH("/xbmc/utils/test/ScraperParser-test.xml")));
+
+  a.m_param[0] = "<a>1</a> <a>2</a> <a>3</a>";
+  EXPECT_STREQ("1,2,3,", a.Parse("GetRepeat", NULL).c_str());
+
+  // the cached expression has to give the same result on the next run
+  a.m_param[0] = "<a>4</a><a>5</a>";
+  EXPECT_STREQ("4,5,", a.Parse("GetRepeat", NULL).c_str());
+}
+
+TEST(TestScraperParser, RepeatExpressionInPlace)
+{
+  CScraperParser a;
+  EXPECT_TRUE(
+    a.Load(XBMC_REF_FILE_PATH("/xbmc/utils/test/ScraperParser-test.xml")));
+
+  // input and destination are the same buffer
+  a.m_param[0] = "<a>1</a> <a>2</a> <a>3</a>";
+  EXPECT_STREQ("1;2;3;", a.Parse("GetInPlace", NULL).c_str());
+}
+
+TEST(TestScraperParser, RepeatExpressionAnchored)
+{
+  CScraperParser a;
+  EXPECT_TRUE(
+    a.Load(XBMC_REF_FILE_PATH("/xbmc/utils/test/ScraperParser-test.xml")));
+
+  // repeated matches see the input as starting right after the previous
+  // match, so ^ matches there and lookbehinds don't see the previous match
+  a.m_param[0] = "<a>1<a>2x<a>3";
+  EXPECT_STREQ("1,2,", a.Parse("GetAnchored", NULL).c_str());
+
+  a.m_param[0] = "<a>1<a>2";
+  EXPECT_STREQ("1,2,", a.Parse("GetLookbehind", NULL).c_str());
+}
+
+TEST(TestScraperParser, CompareWithoutInput)
+{
+  CScraperParser a;
+  EXPECT_TRUE(
+    a.Load(XBMC_REF_FILE_PATH("/xbmc/utils/test/ScraperParser-test.xml")));
+
+  // the compare buffer is the input as well, and is lowercased for comparing,
+  // but the captures keep the case of the input
+  a.m_param[0] = "<a>MixedCase</a>";
+  EXPECT_STREQ("<a>MixedCase</a>", a.Parse("GetCompare", NULL).c_str());
+}
+
+TEST(TestScraperParser, RepeatExpressionCacheFull)
+{
+  CScraperParser a;
+  EXPECT_TRUE(
+    a.Load(XBMC_REF_FILE_PATH("/xbmc/utils/test/ScraperParser-test.xml")));
+
+  // every run compiles a new expression, so the cache overflows on the way
+  for (int i = 0; i < 1200; i++)
+  {
+    std::string prefix = StringUtils::Format("<%d>", i);
+    a.m_param[0] = prefix + "1 " + prefix + "2 <x>3";
+    a.m_param[1] = prefix;
+    EXPECT_STREQ("1,2,", a.Parse("GetPrefixed", NULL).c_str());
+  }
+}
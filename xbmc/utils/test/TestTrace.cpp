@@ -0,0 +1,144 @@
+/*
+ *      Copyright (C) 2015 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "utils/Trace.h"
+#include "threads/Thread.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+  class CTraceWriter : public IRunnable
+  {
+  public:
+    CTraceWriter() : m_stop(false) {}
+    virtual void Run()
+    {
+      while (!m_stop)
+      {
+        TRACE_SCOPE("TestTrace - writer");
+      }
+    }
+    volatile bool m_stop;
+  };
+
+  class CTraceOnce : public IRunnable
+  {
+  public:
+    virtual void Run()
+    {
+      TRACE_SCOPE("TestTrace - once");
+    }
+  };
+}
+
+TEST(TestTrace, Disabled)
+{
+  CTrace::Get().Start();
+  CTrace::Get().Stop();
+  {
+    TRACE_SCOPE("TestTrace - disabled");
+  }
+  EXPECT_EQ(std::string::npos, CTrace::Get().ToJSON().find("TestTrace - disabled"));
+}
+
+TEST(TestTrace, Spans)
+{
+  CTrace::Get().Start();
+  {
+    TRACE_SCOPE("TestTrace - outer");
+    {
+      TRACE_SCOPE("TestTrace - \"inner\"");
+    }
+  }
+  CTrace::Get().Stop();
+
+  std::string json = CTrace::Get().ToJSON();
+  EXPECT_EQ(0U, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"TestTrace - outer\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"TestTrace - \\\"inner\\\"\""));
+}
+
+TEST(TestTrace, Wrap)
+{
+  CTrace::Get().Start();
+  for (int i = 0; i < TRACE_BUFFER_SIZE + 10; i++)
+  {
+    TRACE_SCOPE("TestTrace - wrap");
+  }
+  CTrace::Get().Stop();
+
+  std::string json = CTrace::Get().ToJSON();
+  size_t count = 0;
+  for (size_t pos = json.find("TestTrace - wrap"); pos != std::string::npos; pos = json.find("TestTrace - wrap", pos + 1))
+    count++;
+  EXPECT_EQ((size_t)TRACE_BUFFER_SIZE, count);
+}
+
+TEST(TestTrace, ExportWhileWriting)
+{
+  CTrace::Get().Start();
+  CTraceWriter writer;
+  CThread thread(&writer, "TestTrace");
+  thread.Create();
+
+  for (int i = 0; i < 20; i++)
+  {
+    // restarting must not lose the writer's buffer or let it write past it
+    if (i % 5 == 0)
+      CTrace::Get().Start();
+    std::string json = CTrace::Get().ToJSON();
+    ASSERT_EQ(0U, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    ASSERT_EQ(json.size() - 2, json.rfind("]}"));
+  }
+
+  bool found = false;
+  for (int i = 0; i < 1000 && !found; i++)
+  {
+    found = CTrace::Get().ToJSON().find("TestTrace - writer") != std::string::npos;
+    if (!found)
+      XbmcThreads::ThreadSleep(1);
+  }
+  EXPECT_TRUE(found);
+
+  writer.m_stop = true;
+  thread.StopThread();
+  CTrace::Get().Stop();
+}
+
+TEST(TestTrace, ExitedThreadsReleaseBuffers)
+{
+  CTrace::Get().Start();
+  CTraceOnce once;
+  for (int i = 0; i < 2 * TRACE_MAX_THREADS; i++)
+  {
+    CThread thread(&once, "TestTrace");
+    thread.Create();
+    thread.StopThread();
+  }
+  CTrace::Get().Stop();
+
+  // none of them ended up without a buffer
+  std::string json = CTrace::Get().ToJSON();
+  size_t count = 0;
+  for (size_t pos = json.find("TestTrace - once"); pos != std::string::npos; pos = json.find("TestTrace - once", pos + 1))
+    count++;
+  EXPECT_EQ((size_t)(2 * TRACE_MAX_THREADS), count);
+}
@@ -39,6 +39,7 @@
 #include "guilib/GUIWindowManager.h"
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
+#include "filesystem/FileExistenceCheck.h"
 #include "filesystem/SpecialProtocol.h"
 #include "dialogs/GUIDialogExtendedProgressBar.h"
 #include "dialogs/GUIDialogProgress.h"
@@ -128,6 +129,9 @@ void CVideoDatabase::CreateTables()
   CLog::Log(LOGINFO, "create path table");
   m_pDS->exec("CREATE TABLE path ( idPath integer primary key, strPath text, strContent text, strScraper text, strHash text, scanRecursive integer, useFolderNames bool, strSettings text, noUpdate bool, exclude bool, dateAdded text, idParentPath integer)");
 
+  CLog::Log(LOGINFO, "create dirindex table");
+  m_pDS->exec("CREATE TABLE dirindex (path_id INTEGER, dir TEXT, parent_dir TEXT, mtime INTEGER)");
+
   CLog::Log(LOGINFO, "create files table");
   m_pDS->exec("CREATE TABLE files ( idFile integer primary key, idPath integer, strFilename text, playCount integer, lastPlayed text, dateAdded text)");
 
@@ -227,6 +231,7 @@ void CVideoDatabase::CreateAnalytics()
   m_pDS->exec("CREATE INDEX ix_path ON path ( strPath(255) )");
   m_pDS->exec("CREATE INDEX ix_path2 ON path ( idParentPath )");
   m_pDS->exec("CREATE INDEX ix_files ON files ( idPath, strFilename(255) )");
+  m_pDS->exec("CREATE INDEX ix_dirindex ON dirindex ( path_id )");
 
   m_pDS->exec("CREATE UNIQUE INDEX ix_movie_file_1 ON movie (idFile, idMovie)");
   m_pDS->exec("CREATE UNIQUE INDEX ix_movie_file_2 ON movie (idMovie, idFile)");
@@ -313,6 +318,9 @@ void CVideoDatabase::CreateAnalytics()
   m_pDS->exec("CREATE TRIGGER delete_tag AFTER DELETE ON tag_link FOR EACH ROW BEGIN "
               "DELETE FROM tag WHERE tag_id=old.tag_id AND tag_id NOT IN (SELECT DISTINCT tag_id FROM tag_link); "
               "END");
+  m_pDS->exec("CREATE TRIGGER delete_path AFTER DELETE ON path FOR EACH ROW BEGIN "
+              "DELETE FROM dirindex WHERE path_id=old.idPath; "
+              "END");
 
   CreateViews();
 }
@@ -941,6 +949,76 @@ bool CVideoDatabase::SetPathHash(const std::string &path, const std::string &has
   return false;
 }
 
+bool CVideoDatabase::GetDirectoryIndex(const std::string &path, DirectoryIndex &index)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    int idPath = GetPathId(path);
+    if (idPath < 0)
+      return false;
+
+    std::string strSQL = PrepareSQL("SELECT dir, parent_dir, mtime FROM dirindex WHERE path_id=%i", idPath);
+    m_pDS->query(strSQL.c_str());
+    while (!m_pDS->eof())
+    {
+      std::string dir = m_pDS->fv(0).get_asString();
+      std::string parentDir = m_pDS->fv(1).get_asString();
+      index[dir].mtime = m_pDS->fv(2).get_asInt64();
+      if (!parentDir.empty())
+        index[parentDir].subDirs.push_back(dir);
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, path.c_str());
+  }
+
+  return false;
+}
+
+bool CVideoDatabase::SetDirectoryIndex(const std::string &path, const DirectoryIndex &index)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    int idPath = AddPath(path);
+    if (idPath < 0) return false;
+
+    std::map<std::string, std::string> parentDirs;
+    for (DirectoryIndex::const_iterator dir = index.begin(); dir != index.end(); ++dir)
+    {
+      for (std::vector<std::string>::const_iterator subDir = dir->second.subDirs.begin(); subDir != dir->second.subDirs.end(); ++subDir)
+        parentDirs[*subDir] = dir->first;
+    }
+
+    BeginTransaction();
+    m_pDS->exec(PrepareSQL("DELETE FROM dirindex WHERE path_id=%i", idPath).c_str());
+    for (DirectoryIndex::const_iterator dir = index.begin(); dir != index.end(); ++dir)
+    {
+      std::map<std::string, std::string>::const_iterator parentDir = parentDirs.find(dir->first);
+      m_pDS->exec(PrepareSQL("INSERT INTO dirindex (path_id, dir, parent_dir, mtime) VALUES (%i, '%s', '%s', %lld)",
+                             idPath, dir->first.c_str(), parentDir != parentDirs.end() ? parentDir->second.c_str() : "",
+                             (long long)dir->second.mtime).c_str());
+    }
+    CommitTransaction();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, path.c_str());
+  }
+  RollbackTransaction();
+  return false;
+}
+
 bool CVideoDatabase::LinkMovieToTvshow(int idMovie, int idShow, bool bRemove)
 {
    try
@@ -4648,11 +4726,13 @@ void CVideoDatabase::UpdateTables(int iVersion)
     m_pDS->exec("DROP TABLE IF EXISTS tag");
     m_pDS->exec("ALTER TABLE tagnew RENAME TO tag");
   }
+  if (iVersion < 92)
+    m_pDS->exec("CREATE TABLE dirindex (path_id INTEGER, dir TEXT, parent_dir TEXT, mtime INTEGER)");
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 91;
+  return 92;
 }
 
 void CVideoDatabase::CleanupActorLinkTablePre91(const std::string &linkTable, const std::string &linkTableIdActor, const std::string &linkTableIdMedia, int idActor, const std::string &strActor)
@@ -7864,9 +7944,8 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const se
     }
 
     std::string filesToTestForDelete;
-
-    int total = m_pDS->num_rows();
-    int current = 0;
+    std::vector<std::string> filesToCheck;
+    CFileExistenceCheck existenceCheck;
 
     while (!m_pDS->eof())
     {
@@ -7884,32 +7963,45 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const se
         fullPath = CURL(fullPath).GetHostName();
 
       // remove optical, non-existing files
-      if (URIUtils::IsOnDVD(fullPath) || !CFile::Exists(fullPath, false))
+      if (URIUtils::IsOnDVD(fullPath))
         filesToTestForDelete += m_pDS->fv("files.idFile").get_asString() + ",";
+      else
+      {
+        existenceCheck.Add(fullPath);
+        filesToCheck.push_back(m_pDS->fv("files.idFile").get_asString());
+      }
 
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    // check the files a directory at a time, on a few threads
+    existenceCheck.Start();
+    while (!existenceCheck.Wait(100))
+    {
+      int percentage = existenceCheck.GetProgress();
       if (handle == NULL && progress != NULL)
       {
-        int percentage = current * 100 / total;
         if (percentage > progress->GetPercentage())
-        {
           progress->SetPercentage(percentage);
-          progress->Progress();
-        }
+        progress->Progress();
         if (progress->IsCanceled())
         {
+          existenceCheck.Cancel();
           progress->Close();
-          m_pDS->close();
           ANNOUNCEMENT::CAnnouncementManager::Get().Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", "OnCleanFinished");
           return;
         }
       }
       else if (handle != NULL)
-        handle->SetPercentage(current * 100 / (float)total);
+        handle->SetPercentage((float)percentage);
+    }
 
-      m_pDS->next();
-      current++;
+    for (size_t i = 0; i < filesToCheck.size(); i++)
+    {
+      if (!existenceCheck.Exists(i))
+        filesToTestForDelete += filesToCheck[i] + ",";
     }
-    m_pDS->close();
 
     std::string filesToDelete;
 
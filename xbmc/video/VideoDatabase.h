@@ -25,6 +25,7 @@
 #include "utils/SortUtils.h"
 #include "video/VideoDbUrl.h"
 
+#include <map>
 #include <memory>
 #include <set>
 
@@ -59,6 +60,18 @@ namespace dbiplus
 
 typedef std::vector<CVideoInfoTag> VECMOVIES;
 
+/*! \brief A folder of a scanned tree as seen by the last scan.
+ Adding, removing or renaming an entry of a folder changes its modification time,
+ so while that is unchanged the subfolders are still the ones recorded here.
+ */
+struct DirectoryIndexEntry
+{
+  DirectoryIndexEntry() : mtime(0) {}
+  int64_t mtime;
+  std::vector<std::string> subDirs;
+};
+typedef std::map<std::string, DirectoryIndexEntry> DirectoryIndex;
+
 namespace VIDEO
 {
   class IVideoInfoScannerObserver;
@@ -583,6 +596,19 @@ public:
   // scanning hashes and paths scanned
   bool SetPathHash(const std::string &path, const std::string &hash);
   bool GetPathHash(const std::string &path, std::string &hash);
+
+  /*! \brief Get the folders beneath (and including) a scanned path.
+   \param path the path that was scanned, e.g. a tvshow folder.
+   \param index [out] the folders, keyed by their path.
+   \return true if the path is known, false otherwise.
+   \sa SetDirectoryIndex
+   */
+  bool GetDirectoryIndex(const std::string &path, DirectoryIndex &index);
+
+  /*! \brief Replace the folders recorded for a scanned path.
+   \sa GetDirectoryIndex
+   */
+  bool SetDirectoryIndex(const std::string &path, const DirectoryIndex &index);
   bool GetPaths(std::set<std::string> &paths);
   bool GetPathsForTvShow(int idShow, std::set<int>& paths);
 
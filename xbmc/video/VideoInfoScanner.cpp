@@ -70,6 +70,9 @@ namespace VIDEO
     m_itemCount = 0;
     m_bClean = false;
     m_scanAll = false;
+    m_dirsListed = 0;
+    m_dirsSkipped = 0;
+    m_dirListingTime = 0;
   }
 
   CVideoInfoScanner::~CVideoInfoScanner()
@@ -106,6 +109,11 @@ namespace VIDEO
       }
 
       unsigned int tick = XbmcThreads::SystemClockMillis();
+      unsigned int statHits, statMisses;
+      g_directoryCache.GetStatCacheCounts(statHits, statMisses);
+      m_dirsListed = 0;
+      m_dirsSkipped = 0;
+      m_dirListingTime = 0;
 
       m_database.Open();
 
@@ -164,6 +172,14 @@ namespace VIDEO
 
       tick = XbmcThreads::SystemClockMillis() - tick;
       CLog::Log(LOGNOTICE, "VideoInfoScanner: Finished scan. Scanning for video info took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
+      unsigned int hits, misses;
+      g_directoryCache.GetStatCacheCounts(hits, misses);
+      CLog::Log(LOGDEBUG, "VideoInfoScanner: %u remote file lookups answered from the stat cache, %u not", hits - statHits, misses - statMisses);
+      if (m_dirsSkipped)
+      { // assume the skipped folders would have taken as long to list as the others
+        unsigned int saved = m_dirsListed ? (unsigned int)((uint64_t)m_dirListingTime * m_dirsSkipped / m_dirsListed) : 0;
+        CLog::Log(LOGNOTICE, "VideoInfoScanner: Skipped listing %u unchanged folders (%u listed), saving about %u ms", m_dirsSkipped, m_dirsListed, saved);
+      }
     }
     catch (...)
     {
@@ -1768,6 +1784,9 @@ namespace VIDEO
     if (excludes.size())
       md5state.append(StringUtils::Join(excludes, "|"));
 
+    // the stat cache may still hold the folder from before it was changed
+    g_directoryCache.ClearDirectory(directory);
+
     struct __stat64 buffer;
     if (XFILE::CFile::Stat(directory, &buffer) == 0)
     {
@@ -1783,34 +1802,68 @@ namespace VIDEO
     return "";
   }
 
-  std::string CVideoInfoScanner::GetRecursiveFastHash(const std::string &directory, const vector<string> &excludes) const
+  std::string CVideoInfoScanner::GetRecursiveFastHash(const std::string &directory, const vector<string> &excludes)
   {
-    CFileItemList items;
-    items.Add(CFileItemPtr(new CFileItem(directory, true)));
-    CUtil::GetRecursiveDirsListing(directory, items, DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO);
+    DirectoryIndex index;
+    m_database.GetDirectoryIndex(directory, index);
 
     XBMC::XBMC_MD5 md5state;
 
     if (excludes.size())
       md5state.append(StringUtils::Join(excludes, "|"));
 
+    DirectoryIndex newIndex;
+    bool complete = true;
+    bool changed = false;
     int64_t time = 0;
-    for (int i=0; i < items.Size(); ++i)
+    vector<string> dirs(1, directory);
+    for (size_t i = 0; i < dirs.size(); ++i)
     {
+      // the stat cache may still hold the folder from before it was changed
+      g_directoryCache.ClearDirectory(dirs[i]);
+
       int64_t stat_time = 0;
       struct __stat64 buffer;
-      if (XFILE::CFile::Stat(items[i]->GetPath(), &buffer) == 0)
-      {
-        // TODO: some filesystems may return the mtime/ctime inline, in which case this is
-        // unnecessarily expensive. Consider supporting Stat() in our directory cache?
+      if (XFILE::CFile::Stat(dirs[i], &buffer) == 0)
         stat_time = buffer.st_mtime ? buffer.st_mtime : buffer.st_ctime;
-        time += stat_time;
-      }
 
       if (!stat_time)
         return "";
+      time += stat_time;
+
+      DirectoryIndexEntry &entry = newIndex[dirs[i]];
+      entry.mtime = stat_time;
+      DirectoryIndex::const_iterator known = index.find(dirs[i]);
+      if (known != index.end() && known->second.mtime == stat_time)
+      { // no entries were added or removed, so neither were any subfolders
+        entry.subDirs = known->second.subDirs;
+        m_dirsSkipped++;
+      }
+      else
+      {
+        unsigned int start = XbmcThreads::SystemClockMillis();
+        CFileItemList items;
+        if (CDirectory::GetDirectory(dirs[i], items, "", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO))
+        {
+          for (int j = 0; j < items.Size(); ++j)
+          {
+            if (items[j]->m_bIsFolder && !items[j]->IsPath(".."))
+              entry.subDirs.push_back(items[j]->GetPath());
+          }
+        }
+        else
+          complete = false;
+        m_dirListingTime += XbmcThreads::SystemClockMillis() - start;
+        m_dirsListed++;
+        changed = true;
+      }
+      dirs.insert(dirs.end(), entry.subDirs.begin(), entry.subDirs.end());
     }
 
+    // a folder that failed to list mustn't be remembered as having no subfolders
+    if (complete && (changed || newIndex.size() != index.size()))
+      m_database.SetDirectoryIndex(directory, newIndex);
+
     if (time)
     {
       md5state.append((unsigned char *)&time, sizeof(time));
@@ -198,13 +198,15 @@ namespace VIDEO
      Performs a stat() on the directory, and uses modified time to create a "fast"
      hash of each folder. If no modified time is available, the create time is used,
      and if neither are available, an empty hash is returned.
+     Folders whose modified time matches the directory index of the last scan aren't
+     listed again, their subfolders are taken from the index instead.
      In case exclude from scan expressions are present, the string array will be appended
      to the md5 hash to ensure we're doing a re-scan whenever the user modifies those.
      \param directory folder to hash (recursively)
      \param excludes string array of exclude expressions
      \return the md5 hash of the folder
      */
-    std::string GetRecursiveFastHash(const std::string &directory, const std::vector<std::string> &excludes) const;
+    std::string GetRecursiveFastHash(const std::string &directory, const std::vector<std::string> &excludes);
 
     /*! \brief Decide whether a folder listing could use the "fast" hash
      Fast hashing can be done whenever the folder contains no scannable subfolders, as the
@@ -254,6 +256,9 @@ namespace VIDEO
     std::set<std::string> m_pathsToScan;
     std::set<std::string> m_pathsToCount;
     std::set<int> m_pathsToClean;
+    unsigned int m_dirsListed;    ///< folders listed by GetRecursiveFastHash() this scan
+    unsigned int m_dirsSkipped;   ///< folders GetRecursiveFastHash() took from the directory index
+    unsigned int m_dirListingTime;
     CNfoFile m_nfoReader;
   };
 }
@@ -19,6 +19,7 @@
  */
 
 #include <cstdlib>
+#include <set>
 
 #include "VideoThumbLoader.h"
 #include "filesystem/StackDirectory.h"
@@ -42,6 +43,8 @@
 #include "music/MusicDatabase.h"
 #include "utils/StringUtils.h"
 #include "settings/AdvancedSettings.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 
 using namespace XFILE;
 using namespace std;
@@ -170,15 +173,85 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
+#define ART_FOLDER_LISTERS 4
+
+/*! \brief Lists folders on a few threads in the background, to fill the directory cache
+ Listing stops before the stat cache would drop the first listings again.
+ */
+class CArtFolderLister : public CThread, private IRunnable
+{
+public:
+  CArtFolderLister(const vector<string> &folders, unsigned int skipped)
+    : CThread("ArtFolderLister"), m_folders(folders), m_skipped(skipped), m_next(0), m_entries(0)
+  {
+  }
+
+  virtual ~CArtFolderLister()
+  {
+    StopThread();
+  }
+
+protected:
+  virtual void Process()
+  {
+    unsigned int start = XbmcThreads::SystemClockMillis();
+    vector<CThread*> threads;
+    for (unsigned int i = 0; i < ART_FOLDER_LISTERS && i < m_folders.size(); i++)
+    {
+      threads.push_back(new CThread(this, "ArtFolderLister"));
+      threads.back()->Create();
+    }
+    for (vector<CThread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+      (*it)->StopThread(true);
+      delete *it;
+    }
+    CLog::Log(LOGDEBUG, "CArtFolderLister - listed %u of %u folders (%u entries) for local art in %u ms",
+              (unsigned int)m_next, (unsigned int)(m_folders.size() + m_skipped),
+              m_entries, XbmcThreads::SystemClockMillis() - start);
+  }
+
+private:
+  virtual void Run()
+  {
+    while (true)
+    {
+      string folder;
+      {
+        CSingleLock lock(m_section);
+        if (m_bStop || m_next >= m_folders.size() || m_entries >= STAT_CACHE_MAX_ENTRIES)
+          return;
+        folder = m_folders[m_next++];
+      }
+      CFileItemList items;
+      CDirectory::GetDirectory(folder, items, "", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO | DIR_FLAG_GET_HIDDEN);
+
+      CSingleLock lock(m_section);
+      m_entries += items.Size();
+    }
+  }
+
+  vector<string> m_folders;
+  unsigned int m_skipped;
+  size_t m_next;
+  unsigned int m_entries;
+  CCriticalSection m_section;
+};
+
 CVideoThumbLoader::CVideoThumbLoader() :
   CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
 {
   m_videoDatabase = new CVideoDatabase();
+  m_artFoldersListed = false;
+  m_artFolderLister = NULL;
+  m_statHits = 0;
+  m_statMisses = 0;
 }
 
 CVideoThumbLoader::~CVideoThumbLoader()
 {
   StopThread();
+  delete m_artFolderLister;
   delete m_videoDatabase;
 }
 
@@ -186,11 +259,22 @@ void CVideoThumbLoader::OnLoaderStart()
 {
   m_videoDatabase->Open();
   m_showArt.clear();
+  m_artFoldersListed = false;
+  g_directoryCache.GetStatCacheCounts(m_statHits, m_statMisses);
   CThumbLoader::OnLoaderStart();
 }
 
 void CVideoThumbLoader::OnLoaderFinish()
 {
+  unsigned int hits, misses;
+  g_directoryCache.GetStatCacheCounts(hits, misses);
+  CLog::Log(LOGDEBUG, "%s - stat cache answered %u lookups while loading, %u went to the server", __FUNCTION__,
+            hits - m_statHits, misses - m_statMisses);
+
+  // whatever it hasn't listed yet won't be looked for anymore
+  delete m_artFolderLister;
+  m_artFolderLister = NULL;
+
   m_videoDatabase->Close();
   m_showArt.clear();
   CThumbLoader::OnLoaderFinish();
@@ -328,6 +412,14 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
 
   DetectAndAddMissingItemData(*pItem);
 
+  // items are looked up after all cached items are shown, list their folders in the
+  // background. Until a folder is listed, its items look their art up one by one.
+  if (!m_artFoldersListed && !m_vecItems.empty())
+  {
+    ListArtFolders();
+    m_artFoldersListed = true;
+  }
+
   m_videoDatabase->Open();
 
   map<string, string> artwork = pItem->GetArt();
@@ -486,6 +578,42 @@ bool CVideoThumbLoader::FillThumb(CFileItem &item)
   return !thumb.empty();
 }
 
+void CVideoThumbLoader::ListArtFolders()
+{
+  // in the order of the items, so the ones shown first are covered first
+  vector<string> folders;
+  set<string> added;
+  unsigned int skipped = 0;
+  for (vector<CFileItemPtr>::const_iterator it = m_vecItems.begin(); it != m_vecItems.end(); ++it)
+  {
+    const CFileItemPtr &item = *it;
+    if (item->m_bIsShareOrDrive || item->IsParentFolder() || item->GetPath() == "add" || item->SkipLocalArt())
+      continue;
+
+    // local art is either next to the item or in its folder, see GetLocalArt()
+    string candidates[] = { item->GetLocalArt("thumb.jpg", false), item->GetLocalArt("thumb.jpg", true) };
+    for (unsigned int i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++)
+    {
+      if (candidates[i].empty())
+        continue;
+      string folder = URIUtils::GetDirectory(candidates[i]);
+      if (!CDirectoryCache::IsStatCacheable(folder) || g_directoryCache.HasListing(folder) || !added.insert(folder).second)
+        continue;
+      // more listings than the stat cache holds would push out the first ones
+      if (folders.size() < STAT_CACHE_MAX_LISTINGS)
+        folders.push_back(folder);
+      else
+        skipped++;
+    }
+  }
+  if (folders.empty())
+    return;
+
+  delete m_artFolderLister;
+  m_artFolderLister = new CArtFolderLister(folders, skipped);
+  m_artFolderLister->Create();
+}
+
 std::string CVideoThumbLoader::GetLocalArt(const CFileItem &item, const std::string &type, bool checkFolder)
 {
   if (item.SkipLocalArt())
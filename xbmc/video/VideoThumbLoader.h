@@ -24,6 +24,7 @@
 #include "utils/JobManager.h"
 #include "FileItem.h"
 
+class CArtFolderLister;
 class CStreamDetails;
 class CVideoDatabase;
 
@@ -127,6 +128,16 @@ protected:
   CVideoDatabase *m_videoDatabase;
   typedef std::map<int, std::map<std::string, std::string> > ArtCache;
   ArtCache m_showArt;
+  bool m_artFoldersListed;
+  CArtFolderLister *m_artFolderLister; ///< lists the art folders in the background, NULL once done with them
+  unsigned int m_statHits;   ///< stat cache counts when the loader started
+  unsigned int m_statMisses;
+
+  /*! \brief Start listing the folders that local art of the items can be in, a few at a time
+   The listings go into the stat cache of the directory cache, so looking for the
+   many local art names of each item doesn't need a round trip per name.
+   */
+  void ListArtFolders();
 
   /*! \brief Tries to detect missing data/info from a file and adds those
    \param item The CFileItem to process
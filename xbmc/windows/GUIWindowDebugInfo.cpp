@@ -25,6 +25,7 @@
 #include "utils/CPUInfo.h"
 #include "utils/log.h"
 #include "CompileInfo.h"
+#include "GUILargeTextureManager.h"
 #include "input/ButtonTranslator.h"
 #include "guilib/GUIControlFactory.h"
 #include "guilib/GUIFontManager.h"
@@ -116,6 +117,12 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
     info = StringUtils::Format("LOG: %s%s.log\nMEM: %" PRIu64"/%" PRIu64" KB - FPS: %2.1f fps\nCPU: %s (CPU-%s %4.2f%%%s)", g_advancedSettings.m_logFolder.c_str(), lcAppName.c_str(),
                                stat.ullAvailPhys/1024, stat.ullTotalPhys/1024, g_infoManager.GetFPS(), strCores.c_str(), ucAppName.c_str(), dCPU, profiling.c_str());
 #endif
+    const CGUIWindowManager::RenderStats &renderStats = g_windowManager.GetRenderStats();
+    info += StringUtils::Format("\nGUI: %u dirty regions, %u passes, %2.0f%% redrawn", renderStats.markedRegions,
+                                renderStats.passes, renderStats.coverage * 100);
+    CGUILargeTextureManager::Stats textureStats = g_largeTextureManager.GetStats();
+    info += StringUtils::Format("\nTEX: %u large textures, %" PRIu64" MB, %u loading, %u ms per load", textureStats.textures,
+                                textureStats.bytes / (1024 * 1024), textureStats.queued, textureStats.loadTime);
   }
 
   // render the skin debug info